@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "CanBatch.hpp"
+#include "CanDecode.hpp"
+#include "Config.hpp"
+
+// Raise or clear of one rule, produced while a batch is evaluated.
+struct AlarmEvent {
+    const std::string* name;
+    bool active;
+    uint32_t can_id;     // frame that changed the rule state
+    int32_t value;
+    int64_t timestamp;   // its receive time, monotonic µs
+};
+
+// Ids some alarm rule watches, one bit per LimitTable slot, built from the
+// config by each receive thread so that only batches carrying one of them
+// take the lock of the engine the shards share.
+class AlarmWatch {
+public:
+    static constexpr size_t WORDS = (LimitTable::SLOTS + 63) / 64;
+
+    void load(const LoggerConfig& cfg) {
+        std::fill(words, words + WORDS, 0);
+        for (const AlarmRule& rule : cfg.alarms) {
+            for (const AlarmCondition& cond : rule.conditions) {
+                const size_t slot = LimitTable::slot(cond.can_id);
+                words[slot / 64] |= uint64_t{1} << (slot % 64);
+            }
+        }
+    }
+
+    bool any(const CanColumns& cols) const {
+        for (size_t i = 0; i < cols.size(); i++) {
+            const size_t slot = LimitTable::slot(cols.ids[i]);
+            if (words[slot / 64] >> (slot % 64) & 1) return true;
+        }
+        return false;
+    }
+
+private:
+    uint64_t words[WORDS] = {};
+};
+
+// Evaluates the configured alarm rules on decoded columns, before the batch
+// is stored. Conditions are chained per CAN id in a table indexed like
+// LimitTable, so frames without rules cost one load. State lives here, not in
+// the config snapshot; load() of a new snapshot starts all rules cleared.
+class AlarmEngine {
+public:
+    AlarmEngine() : heads(LimitTable::SLOTS, -1) {}
+
+    void load(const LoggerConfig& cfg) {
+        rules.clear();
+        conditions.clear();
+        heads.assign(LimitTable::SLOTS, -1);
+        for (const AlarmRule& rule : cfg.alarms) {
+            rules.push_back({&rule.name, static_cast<uint32_t>(conditions.size()),
+                             static_cast<uint32_t>(rule.conditions.size()), false});
+            for (const AlarmCondition& cond : rule.conditions) {
+                State state;
+                state.cond = cond;
+                state.rule = static_cast<uint32_t>(rules.size() - 1);
+                const size_t slot = LimitTable::slot(cond.can_id);
+                state.next = heads[slot];
+                heads[slot] = static_cast<int32_t>(conditions.size());
+                conditions.push_back(state);
+            }
+        }
+    }
+
+    bool empty() const { return rules.empty(); }
+
+    // Calls emit(const AlarmEvent&) for every rule that changes state.
+    template <typename Emit>
+    void evaluate(const CanColumns& cols, Emit emit) {
+        if (rules.empty()) return;
+        for (size_t i = 0; i < cols.size(); i++) {
+            const uint32_t can_id = cols.ids[i];
+            for (int32_t c = heads[LimitTable::slot(can_id)]; c >= 0; c = conditions[c].next) {
+                State& state = conditions[c];
+                if (state.cond.can_id != can_id || !update(state, cols.values[i], cols.timestamps[i])) continue;
+                Rule& rule = rules[state.rule];
+                const bool active = allMet(rule);
+                if (active == rule.active) continue;
+                rule.active = active;
+                emit(AlarmEvent{rule.name, active, can_id, cols.values[i], cols.timestamps[i]});
+            }
+        }
+    }
+
+private:
+    struct State {
+        AlarmCondition cond;
+        uint32_t rule = 0;
+        int32_t next = -1;       // next condition on the same id slot
+        bool met = false;
+        bool seen = false;
+        int32_t lastValue = 0;
+        int64_t lastTimestamp = 0;
+    };
+
+    struct Rule {
+        const std::string* name;
+        uint32_t first;
+        uint32_t count;
+        bool active;
+    };
+
+    // Feeds one sample, returns true if the condition changed.
+    static bool update(State& state, int32_t value, int64_t timestamp) {
+        double x = value;
+        if (state.cond.rate) {
+            const bool hadPrevious = state.seen;
+            const int64_t dt = timestamp - state.lastTimestamp;
+            x = hadPrevious && dt > 0 ? (value - state.lastValue) * 1e6 / dt : 0;
+            state.seen = true;
+            state.lastValue = value;
+            state.lastTimestamp = timestamp;
+            if (!hadPrevious || dt <= 0) return false;
+        }
+        const AlarmCondition& cond = state.cond;
+        bool met;
+        if (cond.above) {
+            met = state.met ? x > cond.threshold - cond.hysteresis : x > cond.threshold;
+        } else {
+            met = state.met ? x < cond.threshold + cond.hysteresis : x < cond.threshold;
+        }
+        if (met == state.met) return false;
+        state.met = met;
+        return true;
+    }
+
+    bool allMet(const Rule& rule) const {
+        for (uint32_t c = rule.first; c < rule.first + rule.count; c++) {
+            if (!conditions[c].met) return false;
+        }
+        return true;
+    }
+
+    std::vector<Rule> rules;
+    std::vector<State> conditions;
+    std::vector<int32_t> heads;
+};
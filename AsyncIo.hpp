@@ -0,0 +1,460 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <climits>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "Metrics.hpp"
+
+// Coroutine runtime for the receive and upload paths. A Task is a coroutine
+// that starts when it is awaited or spawned on an IoLoop. A loop runs its
+// tasks on one thread and resumes them when a socket turns readable, a
+// timer expires or another thread hands one over; in between it sleeps in
+// epoll_wait(). Timers and extra buses are more tasks on a loop instead of
+// more threads or more checks in one blocking loop, and nothing changes
+// threads unless a task awaits something that completes on another loop.
+// Frames of the long-lived tasks are allocated when they are spawned;
+// awaiting allocates nothing once the wait lists have grown to their
+// working size.
+
+class IoLoop;
+
+// What every task promise has: who to resume when the task returns.
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+    bool detached = false;    // spawned: frees its frame when it returns
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+            TaskPromiseBase& promise = handle.promise();
+            if (promise.continuation) return promise.continuation;
+            if (promise.detached) handle.destroy();
+            return std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() const noexcept { std::terminate(); }
+};
+
+template <typename T>
+struct TaskResult {
+    T value{};
+    void return_value(T result) { value = std::move(result); }
+    T take() { return std::move(value); }
+};
+
+template <>
+struct TaskResult<void> {
+    void return_void() const {}
+    void take() const {}
+};
+
+// co_await task runs it and continues, with its result, on the thread
+// the task returned on.
+template <typename T = void>
+class Task {
+public:
+    struct promise_type : TaskPromiseBase, TaskResult<T> {
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    };
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() { return handle.promise().take(); }
+
+    // For IoLoop::spawn(): the frame is the loop's from now on.
+    std::coroutine_handle<promise_type> release() { return std::exchange(handle, {}); }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> frame) : handle(frame) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// One thread's event loop. post() and spawn() may be called from any
+// thread; readable() and the sleeps are awaited by tasks on this loop.
+class IoLoop {
+public:
+    static constexpr size_t MAX_EVENTS = 16;   // per epoll_wait()
+    static constexpr size_t RESERVED = 64;     // suspended tasks before a wait list grows
+
+    // true once fd has data to read, false when the timeout ran out first
+    struct Readable {
+        IoLoop* loop;
+        int fd;
+        int64_t deadlineNs;
+        std::coroutine_handle<> handle;
+        bool ready = false;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> awaiting) {
+            handle = awaiting;
+            return loop->watch(*this);
+        }
+        bool await_resume() const noexcept { return ready; }
+    };
+
+    struct Sleep {
+        IoLoop* loop;
+        int64_t deadlineNs;
+
+        bool await_ready() const { return deadlineNs <= monotonicNs(); }
+        void await_suspend(std::coroutine_handle<> awaiting) { loop->addTimer(deadlineNs, awaiting); }
+        void await_resume() const noexcept {}
+    };
+
+    struct Hop {
+        IoLoop* loop;
+
+        bool await_ready() const noexcept { return current() == loop; }
+        void await_suspend(std::coroutine_handle<> awaiting) { loop->post(awaiting); }
+        void await_resume() const noexcept {}
+    };
+
+    IoLoop() {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollFd < 0 || wakeFd < 0) {
+            perror("IoLoop");
+            return;
+        }
+        struct epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) < 0) perror("epoll_ctl");
+        posted.reserve(RESERVED);
+        ready.reserve(RESERVED);
+        timers.reserve(RESERVED);
+        watched.reserve(RESERVED);
+    }
+
+    IoLoop(const IoLoop&) = delete;
+    IoLoop& operator=(const IoLoop&) = delete;
+
+    ~IoLoop() {
+        if (epollFd >= 0) close(epollFd);
+        if (wakeFd >= 0) close(wakeFd);
+    }
+
+    // The loop the calling thread runs, nullptr off any loop.
+    static IoLoop* current() { return currentLoop(); }
+
+    // Runs the task on this loop; its frame is freed when it returns.
+    template <typename T>
+    void spawn(Task<T> task) {
+        auto handle = task.release();
+        handle.promise().detached = true;
+        post(handle);
+    }
+
+    // Resumes a suspended coroutine on this loop's thread.
+    void post(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            posted.push_back(handle);
+        }
+        if (current() != this) wake();
+    }
+
+    [[nodiscard]] Readable readable(int fd, int64_t timeoutNs = -1) {
+        return {this, fd, timeoutNs < 0 ? INT64_MAX : monotonicNs() + timeoutNs, {}};
+    }
+    [[nodiscard]] Sleep sleepUntil(int64_t deadlineNs) { return {this, deadlineNs}; }
+    [[nodiscard]] Sleep sleepFor(int64_t ns) { return {this, monotonicNs() + ns}; }
+
+    // co_await loop.schedule() continues the awaiting task on this loop.
+    [[nodiscard]] Hop schedule() { return {this}; }
+
+    // Runs tasks on the calling thread until stop().
+    void run() {
+        currentLoop() = this;
+        while (!stopping.load(std::memory_order_acquire)) {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                ready.swap(posted);
+            }
+            poll(ready.empty() ? nextDeadline() : 0);
+            for (size_t i = 0; i < ready.size(); i++) {
+                ready[i].resume();
+            }
+            ready.clear();
+        }
+        currentLoop() = nullptr;
+    }
+
+    // Any thread; run() returns after the tasks it is resuming.
+    void stop() {
+        stopping.store(true, std::memory_order_release);
+        wake();
+    }
+
+private:
+    struct Timer {
+        int64_t deadlineNs;
+        std::coroutine_handle<> handle;
+        bool operator>(const Timer& other) const { return deadlineNs > other.deadlineNs; }
+    };
+
+    static IoLoop*& currentLoop() {
+        static thread_local IoLoop* loop = nullptr;
+        return loop;
+    }
+
+    void wake() {
+        const uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN) perror("eventfd");
+    }
+
+    // One-shot: the fd is disarmed again once it fires or times out.
+    bool watch(Readable& waiter) {
+        struct epoll_event event{};
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.ptr = &waiter;
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, waiter.fd, &event) < 0
+            && (errno != ENOENT || epoll_ctl(epollFd, EPOLL_CTL_ADD, waiter.fd, &event) < 0)) {
+            perror("epoll_ctl");
+            waiter.ready = true;   // the caller's read reports what is wrong with fd
+            return false;
+        }
+        watched.push_back(&waiter);
+        return true;
+    }
+
+    void unwatch(Readable* waiter) {
+        for (size_t i = 0; i < watched.size(); i++) {
+            if (watched[i] == waiter) {
+                watched[i] = watched.back();
+                watched.pop_back();
+                return;
+            }
+        }
+    }
+
+    void addTimer(int64_t deadlineNs, std::coroutine_handle<> handle) {
+        timers.push_back({deadlineNs, handle});
+        std::push_heap(timers.begin(), timers.end(), std::greater<Timer>());
+    }
+
+    int64_t nextDeadline() const {
+        int64_t deadline = timers.empty() ? INT64_MAX : timers.front().deadlineNs;
+        for (const Readable* waiter : watched) {
+            if (waiter->deadlineNs < deadline) deadline = waiter->deadlineNs;
+        }
+        return deadline;
+    }
+
+    // Waits for events until deadlineNs (0 = just look) and queues what is
+    // due: readable fds, then expired timers and fd timeouts.
+    void poll(int64_t deadlineNs) {
+        int timeoutMs = -1;
+        if (deadlineNs != INT64_MAX) {
+            const int64_t wait = deadlineNs - monotonicNs();
+            timeoutMs = wait <= 0 ? 0 : static_cast<int>(std::min<int64_t>((wait + 999999) / 1000000, INT_MAX));
+        }
+        struct epoll_event events[MAX_EVENTS];
+        const int n = epoll_wait(epollFd, events, MAX_EVENTS, timeoutMs);
+        if (n < 0 && errno != EINTR) perror("epoll_wait");
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.ptr == nullptr) {
+                uint64_t count;
+                if (read(wakeFd, &count, sizeof(count)) < 0 && errno != EAGAIN) perror("eventfd");
+                continue;
+            }
+            Readable* waiter = static_cast<Readable*>(events[i].data.ptr);
+            waiter->ready = true;
+            unwatch(waiter);
+            ready.push_back(waiter->handle);
+        }
+
+        const int64_t now = monotonicNs();
+        while (!timers.empty() && timers.front().deadlineNs <= now) {
+            ready.push_back(timers.front().handle);
+            std::pop_heap(timers.begin(), timers.end(), std::greater<Timer>());
+            timers.pop_back();
+        }
+        for (size_t i = 0; i < watched.size();) {
+            Readable* waiter = watched[i];
+            if (waiter->deadlineNs > now) {
+                i++;
+                continue;
+            }
+            struct epoll_event event{};
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, waiter->fd, &event);
+            watched[i] = watched.back();
+            watched.pop_back();
+            ready.push_back(waiter->handle);
+        }
+    }
+
+    int epollFd = -1;
+    int wakeFd = -1;
+    std::atomic<bool> stopping{false};
+    std::mutex lock;                              // posted only
+    std::vector<std::coroutine_handle<>> posted;
+    std::vector<std::coroutine_handle<>> ready;   // loop thread only, like the lists below
+    std::vector<Timer> timers;                    // min-heap on deadline
+    std::vector<Readable*> watched;
+};
+
+// Wakes one waiting task on its own loop. set() may be called from any
+// thread; a set() nobody waits for is kept for the next wait().
+class AsyncEvent {
+public:
+    struct Wait {
+        AsyncEvent* event;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> awaiting) {
+            std::lock_guard<std::mutex> guard(event->lock);
+            if (event->signaled) {
+                event->signaled = false;
+                return false;
+            }
+            event->waiter = awaiting;
+            event->waiterLoop = IoLoop::current();
+            return true;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    [[nodiscard]] Wait wait() { return {this}; }
+
+    void set() {
+        std::coroutine_handle<> handle;
+        IoLoop* loop;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!waiter) {
+                signaled = true;
+                return;
+            }
+            handle = std::exchange(waiter, {});
+            loop = waiterLoop;
+        }
+        loop->post(handle);
+    }
+
+private:
+    std::mutex lock;
+    bool signaled = false;
+    std::coroutine_handle<> waiter;
+    IoLoop* waiterLoop = nullptr;
+};
+
+// Fixed-capacity FIFO of pointers between tasks, possibly on different
+// loops: pop() waits while it is empty, push() while it is full. At most
+// one task may wait on each side at a time. An item goes straight to a
+// waiting consumer, which is resumed on its own loop.
+template <typename T, size_t N>
+class AsyncQueue {
+public:
+    struct Waiter {
+        AsyncQueue* queue;
+        T* item;
+        std::coroutine_handle<> handle;
+        IoLoop* loop;
+    };
+
+    struct Push : Waiter {
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> awaiting) { return this->queue->suspendPush(*this, awaiting); }
+        void await_resume() const noexcept {}
+    };
+
+    struct Pop : Waiter {
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> awaiting) { return this->queue->suspendPop(*this, awaiting); }
+        T* await_resume() const noexcept { return this->item; }
+    };
+
+    [[nodiscard]] Push push(T* item) { return {{this, item, {}, nullptr}}; }
+    [[nodiscard]] Pop pop() { return {{this, nullptr, {}, nullptr}}; }
+
+    // Without waiting, e.g. to fill the queue before its tasks start; false if full.
+    bool tryPush(T* item) {
+        Waiter* woken = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (popper) {
+                popper->item = item;
+                woken = std::exchange(popper, nullptr);
+            } else if (count < N) {
+                items[(head + count++) % N] = item;
+            } else {
+                return false;
+            }
+        }
+        if (woken) woken->loop->post(woken->handle);
+        return true;
+    }
+
+private:
+    bool suspendPush(Waiter& pushing, std::coroutine_handle<> awaiting) {
+        if (tryPush(pushing.item)) return false;
+        std::lock_guard<std::mutex> guard(lock);
+        if (count < N) {   // popped meanwhile
+            items[(head + count++) % N] = pushing.item;
+            return false;
+        }
+        pushing.handle = awaiting;
+        pushing.loop = IoLoop::current();
+        pusher = &pushing;
+        return true;
+    }
+
+    bool suspendPop(Waiter& popping, std::coroutine_handle<> awaiting) {
+        Waiter* woken = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (count == 0) {
+                popping.handle = awaiting;
+                popping.loop = IoLoop::current();
+                popper = &popping;
+                return true;
+            }
+            popping.item = items[head];
+            head = (head + 1) % N;
+            count--;
+            if (pusher) {
+                items[(head + count++) % N] = pusher->item;
+                woken = std::exchange(pusher, nullptr);
+            }
+        }
+        if (woken) woken->loop->post(woken->handle);
+        return false;
+    }
+
+    std::mutex lock;
+    std::array<T*, N> items{};
+    size_t head = 0;
+    size_t count = 0;
+    Waiter* popper = nullptr;
+    Waiter* pusher = nullptr;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include "CanBatch.hpp"
+#include "CanDecode.hpp"
+#include "Config.hpp"
+
+// Degradation levels, entered in this order as the buffer backlog or the
+// SQLite heap grows past the configured thresholds.
+enum class DegradeLevel {
+    Normal,       // everything stored
+    Downsample,   // low-priority ids stored at most every downsample_ms
+    Aggregate,    // non-critical ids only kept in the rollups
+    Shed,         // non-critical ids dropped
+};
+
+inline const char* degradeLevelName(DegradeLevel level) {
+    switch (level) {
+    case DegradeLevel::Normal: return "normal";
+    case DegradeLevel::Downsample: return "downsample";
+    case DegradeLevel::Aggregate: return "aggregate";
+    case DegradeLevel::Shed: return "shed";
+    }
+    return "unknown";
+}
+
+// Rows of a decoded batch to store as samples and to fold into the rollups,
+// bit i = row i, as passed to CanStorage::insert().
+struct DegradeMasks {
+    uint64_t raw;
+    uint64_t rollup;
+};
+
+// Decides, per batch, how much of it the buffer takes. Only the storage
+// path is degraded: alarms and the last value cache see every frame before
+// this runs. Critical ids are always stored in full. Priorities apply to
+// standard ids; extended ids count as normal priority.
+class Backpressure {
+public:
+    static constexpr double HYSTERESIS = 0.8;   // leave a level below 80 % of its threshold
+
+    Backpressure() : priority(LimitTable::SLOTS, NORMAL), lastRaw(LimitTable::SLOTS, INT64_MIN) {}
+
+    void load(const LoggerConfig& cfg) {
+        priority.assign(LimitTable::SLOTS, NORMAL);
+        for (uint32_t can_id : cfg.lowPriorityIds) {
+            if (can_id <= CAN_SFF_MASK) priority[can_id] = LOW;
+        }
+        for (uint32_t can_id : cfg.criticalIds) {
+            if (can_id <= CAN_SFF_MASK) priority[can_id] = CRITICAL;
+        }
+        for (size_t i = 0; i < LEVELS; i++) {
+            rowLimits[i] = cfg.degradeRows[i];
+            memoryLimits[i] = cfg.degradeMemoryMb[i] * 1024 * 1024;
+        }
+        downsampleUs = static_cast<int64_t>(cfg.downsampleMs) * 1000;
+    }
+
+    // Re-evaluates the level from the backlog and SQLite heap size. A level
+    // is entered as soon as one of its thresholds is reached and left once
+    // both are back under HYSTERESIS of it. Returns true if it changed.
+    bool update(size_t backlogRows, size_t memoryBytes) {
+        const int up = levelFor(backlogRows, memoryBytes, 1.0);
+        const int down = levelFor(backlogRows, memoryBytes, HYSTERESIS);
+        const int next = up > current ? up : (down < current ? down : current);
+        if (next == current) return false;
+        current = next;
+        return true;
+    }
+
+    DegradeLevel level() const { return static_cast<DegradeLevel>(current); }
+
+    DegradeMasks select(const CanColumns& cols) {
+        const uint64_t all = cols.count >= 64 ? ~uint64_t{0} : (uint64_t{1} << cols.count) - 1;
+        if (current == 0) return {all, all};
+        const DegradeLevel lvl = level();
+        uint64_t raw = 0;
+        uint64_t rollup = 0;
+        for (size_t i = 0; i < cols.count; i++) {
+            const uint64_t bit = uint64_t{1} << i;
+            const size_t slot = LimitTable::slot(cols.ids[i]);
+            if (priority[slot] == CRITICAL) {
+                raw |= bit;
+                rollup |= bit;
+                continue;
+            }
+            if (lvl == DegradeLevel::Shed) continue;
+            rollup |= bit;
+            if (lvl == DegradeLevel::Aggregate) continue;
+            if (priority[slot] == LOW) {
+                if (cols.timestamps[i] < lastRaw[slot] + downsampleUs) continue;
+                lastRaw[slot] = cols.timestamps[i];
+            }
+            raw |= bit;
+        }
+        return {raw, rollup};
+    }
+
+private:
+    enum : uint8_t { LOW, NORMAL, CRITICAL };
+    static constexpr size_t LEVELS = 3;
+
+    int levelFor(size_t backlogRows, size_t memoryBytes, double scale) const {
+        int level = 0;
+        for (size_t i = 0; i < LEVELS; i++) {
+            if ((rowLimits[i] && backlogRows >= rowLimits[i] * scale)
+                || (memoryLimits[i] && memoryBytes >= memoryLimits[i] * scale)) {
+                level = static_cast<int>(i) + 1;
+            }
+        }
+        return level;
+    }
+
+    std::vector<uint8_t> priority;
+    std::vector<int64_t> lastRaw;     // last stored low-priority row per id
+    size_t rowLimits[LEVELS] = {};
+    size_t memoryLimits[LEVELS] = {};
+    int64_t downsampleUs = 0;
+    int current = 0;
+};
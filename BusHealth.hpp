@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/error.h>
+#include <linux/can/netlink.h>
+#include <linux/if_link.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include "CanDecode.hpp"
+
+// Controller error state, from the error frames the driver reports.
+enum class BusState : uint8_t { Active, Warning, Passive, BusOff };
+
+inline const char* busStateName(BusState state) {
+    switch (state) {
+    case BusState::Active: return "error active";
+    case BusState::Warning: return "error warning";
+    case BusState::Passive: return "error passive";
+    case BusState::BusOff: return "bus off";
+    }
+    return "unknown";
+}
+
+// Error classes the receive socket subscribes to with CAN_RAW_ERR_FILTER.
+constexpr can_err_mask_t BUS_ERROR_CLASSES = CAN_ERR_TX_TIMEOUT | CAN_ERR_CRTL | CAN_ERR_PROT | CAN_ERR_TRX
+                                             | CAN_ERR_ACK | CAN_ERR_BUSOFF | CAN_ERR_BUSERROR | CAN_ERR_RESTARTED
+                                             | CAN_ERR_CNT;
+
+// Bits a classic data frame occupies on the wire, SOF to the end of the
+// interframe space, without stuff bits, so load estimates are a lower bound.
+inline uint32_t frameBits(const struct can_frame& frame) {
+    const uint32_t data = (frame.can_id & CAN_RTR_FLAG) ? 0 : 8u * (frame.can_dlc > 8 ? 8 : frame.can_dlc);
+    return ((frame.can_id & CAN_EFF_FLAG) ? 67u : 47u) + data;
+}
+
+// Bus health from the received stream: decodes error frames into the
+// controller state and error counters and adds up the bits of data frames
+// for the load estimate. Only frames this socket receives are counted, so
+// with a CAN_RAW_FILTER the load covers the accepted ids only.
+class BusMonitor {
+public:
+    // Decodes and removes the error frames in frames. Returns true if the
+    // controller went bus-off in this batch.
+    bool observe(FrameBatch& frames) {
+        bool wentOff = false;
+        size_t kept = 0;
+        for (size_t i = 0; i < frames.size(); i++) {
+            const struct can_frame& frame = frames[i].frame;
+            if (!(frame.can_id & CAN_ERR_FLAG)) {
+                bits += frameBits(frame);
+                frameCount++;
+                if (kept != i) frames[kept] = frames[i];
+                kept++;
+                continue;
+            }
+            errorFrameCount++;
+            wentOff |= decodeError(frame);
+        }
+        frames.resize(kept);
+        return wentOff;
+    }
+
+    // Share of bus time used since the previous call, in 1/1000.
+    uint32_t takeLoadPermille(int64_t nowNs, uint32_t bitrate) {
+        const int64_t elapsed = nowNs - windowStart;
+        uint64_t permille = 0;
+        if (windowStart != 0 && elapsed > 0 && bitrate > 0) {
+            permille = bits * 1000000000000ULL / (static_cast<uint64_t>(elapsed) * bitrate);
+        }
+        windowStart = nowNs;
+        bits = 0;
+        return static_cast<uint32_t>(permille > 1000 ? 1000 : permille);
+    }
+
+    // After a controller restart or a new socket: error active until told otherwise.
+    void restarted() {
+        state = BusState::Active;
+        txErrors = rxErrors = 0;
+    }
+
+    BusState state = BusState::Active;
+    uint8_t txErrors = 0;
+    uint8_t rxErrors = 0;
+    uint32_t frameCount = 0;
+    uint32_t errorFrameCount = 0;
+    uint32_t busOffCount = 0;
+    uint32_t restartCount = 0;
+
+private:
+    bool decodeError(const struct can_frame& frame) {
+        const canid_t err = frame.can_id & CAN_ERR_MASK;
+        if (err & CAN_ERR_CNT) {
+            txErrors = frame.data[6];
+            rxErrors = frame.data[7];
+        }
+        if (err & CAN_ERR_RESTARTED) {
+            restartCount++;
+            restarted();
+        }
+        if (err & CAN_ERR_CRTL) {
+            const uint8_t crtl = frame.data[1];
+            if (crtl & (CAN_ERR_CRTL_RX_PASSIVE | CAN_ERR_CRTL_TX_PASSIVE)) state = BusState::Passive;
+            else if (crtl & (CAN_ERR_CRTL_RX_WARNING | CAN_ERR_CRTL_TX_WARNING)) state = BusState::Warning;
+            else if (crtl & CAN_ERR_CRTL_ACTIVE) state = BusState::Active;
+        }
+        if ((err & CAN_ERR_BUSOFF) && state != BusState::BusOff) {
+            state = BusState::BusOff;
+            busOffCount++;
+            return true;
+        }
+        return false;
+    }
+
+    uint64_t bits = 0;
+    int64_t windowStart = 0;
+};
+
+// rtnetlink helpers for the CAN link. Both send one request and read one
+// reply; they need no CAP_NET_ADMIN to query, restart does.
+struct CanLinkRequest {
+    struct nlmsghdr header;
+    struct ifinfomsg info;
+    char attrs[64];
+};
+
+inline struct rtattr* addAttr(CanLinkRequest& req, unsigned short type, const void* data, size_t len) {
+    struct rtattr* attr = reinterpret_cast<struct rtattr*>(reinterpret_cast<char*>(&req) + NLMSG_ALIGN(req.header.nlmsg_len));
+    attr->rta_type = type;
+    attr->rta_len = static_cast<unsigned short>(RTA_LENGTH(len));
+    if (len) memcpy(RTA_DATA(attr), data, len);
+    req.header.nlmsg_len = NLMSG_ALIGN(req.header.nlmsg_len) + RTA_ALIGN(attr->rta_len);
+    return attr;
+}
+
+inline void endNest(CanLinkRequest& req, struct rtattr* nest) {
+    nest->rta_len = static_cast<unsigned short>(reinterpret_cast<char*>(&req) + req.header.nlmsg_len
+                                                - reinterpret_cast<char*>(nest));
+}
+
+// Sends req, receives the reply into buf. Returns its length, -1 on error.
+inline ssize_t canLinkTalk(CanLinkRequest& req, char* buf, size_t size) {
+    const int nl = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (nl < 0) return -1;
+    ssize_t n = send(nl, &req, req.header.nlmsg_len, 0);
+    if (n >= 0) n = recv(nl, buf, size, 0);
+    close(nl);
+    return n;
+}
+
+// Copies attribute type of the interface's CAN link data (IFLA_LINKINFO >
+// IFLA_INFO_DATA) into out. False if the link has none (vcan) or on error.
+inline bool canLinkAttr(int ifindex, unsigned short type, void* out, size_t size) {
+    CanLinkRequest req{};
+    req.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    req.header.nlmsg_type = RTM_GETLINK;
+    req.header.nlmsg_flags = NLM_F_REQUEST;
+    req.info.ifi_family = AF_UNSPEC;
+    req.info.ifi_index = ifindex;
+    alignas(struct nlmsghdr) char buf[8192];
+    ssize_t len = canLinkTalk(req, buf, sizeof(buf));
+    const struct nlmsghdr* reply = reinterpret_cast<const struct nlmsghdr*>(buf);
+    if (len <= 0 || !NLMSG_OK(reply, static_cast<size_t>(len)) || reply->nlmsg_type != RTM_NEWLINK) return false;
+
+    int attrLen = static_cast<int>(IFLA_PAYLOAD(reply));
+    for (const struct rtattr* attr = IFLA_RTA(NLMSG_DATA(reply)); RTA_OK(attr, attrLen); attr = RTA_NEXT(attr, attrLen)) {
+        if (attr->rta_type != IFLA_LINKINFO) continue;
+        int infoLen = static_cast<int>(RTA_PAYLOAD(attr));
+        for (const struct rtattr* info = static_cast<const struct rtattr*>(RTA_DATA(attr)); RTA_OK(info, infoLen);
+             info = RTA_NEXT(info, infoLen)) {
+            if (info->rta_type != IFLA_INFO_DATA) continue;
+            int dataLen = static_cast<int>(RTA_PAYLOAD(info));
+            for (const struct rtattr* can = static_cast<const struct rtattr*>(RTA_DATA(info)); RTA_OK(can, dataLen);
+                 can = RTA_NEXT(can, dataLen)) {
+                if (can->rta_type == type && RTA_PAYLOAD(can) >= size) {
+                    memcpy(out, RTA_DATA(can), size);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Nominal bitrate of a CAN interface, 0 if it has none (vcan) or on error.
+inline uint32_t canBitrate(int ifindex) {
+    struct can_bittiming timing;
+    return canLinkAttr(ifindex, IFLA_CAN_BITTIMING, &timing, sizeof(timing)) ? timing.bitrate : 0;
+}
+
+// Controller state as the driver has it now, for when no error frame told
+// us (a new socket). False if the link doesn't report one.
+inline bool canLinkState(int ifindex, BusState& state) {
+    uint32_t linkState;
+    if (!canLinkAttr(ifindex, IFLA_CAN_STATE, &linkState, sizeof(linkState))) return false;
+    switch (linkState) {
+    case CAN_STATE_ERROR_ACTIVE: state = BusState::Active; return true;
+    case CAN_STATE_ERROR_WARNING: state = BusState::Warning; return true;
+    case CAN_STATE_ERROR_PASSIVE: state = BusState::Passive; return true;
+    case CAN_STATE_BUS_OFF: state = BusState::BusOff; return true;
+    }
+    return false;
+}
+
+// "ip link set <if> type can restart": brings a bus-off controller back.
+// Fails when the kernel restarts it itself (restart-ms set) or without
+// CAP_NET_ADMIN.
+inline bool canRestart(int ifindex) {
+    CanLinkRequest req{};
+    req.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    req.header.nlmsg_type = RTM_NEWLINK;
+    req.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK;
+    req.info.ifi_family = AF_UNSPEC;
+    req.info.ifi_index = ifindex;
+    struct rtattr* linkinfo = addAttr(req, IFLA_LINKINFO, nullptr, 0);
+    addAttr(req, IFLA_INFO_KIND, "can", 3);
+    struct rtattr* data = addAttr(req, IFLA_INFO_DATA, nullptr, 0);
+    const uint32_t restart = 1;
+    addAttr(req, IFLA_CAN_RESTART, &restart, sizeof(restart));
+    endNest(req, data);
+    endNest(req, linkinfo);
+
+    alignas(struct nlmsghdr) char buf[1024];
+    const ssize_t len = canLinkTalk(req, buf, sizeof(buf));
+    const struct nlmsghdr* reply = reinterpret_cast<const struct nlmsghdr*>(buf);
+    if (len <= 0 || !NLMSG_OK(reply, static_cast<size_t>(len)) || reply->nlmsg_type != NLMSG_ERROR) return false;
+    const struct nlmsgerr* ack = static_cast<const struct nlmsgerr*>(NLMSG_DATA(reply));
+    if (ack->error != 0) {
+        errno = -ack->error;
+        perror("CAN restart");
+        return false;
+    }
+    return true;
+}
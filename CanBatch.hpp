@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <utility>
+
+struct CanData {
+    int can_id;
+    int value;
+    int64_t timestamp;
+    int64_t seq = 0;     // buffer sequence number, set by CanStorage::fetch()
+};
+
+// Struct-of-arrays form of one received batch, filled by decodeColumns().
+// Capacity matches a 64-bit mask so range checks return one word per batch.
+struct CanColumns {
+    static constexpr size_t CAPACITY = 64;
+
+    alignas(16) uint32_t ids[CAPACITY];
+    alignas(16) int32_t values[CAPACITY];
+    alignas(16) int64_t timestamps[CAPACITY];
+    size_t count = 0;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { count = 0; }
+    CanData row(size_t i) const { return {static_cast<int>(ids[i]), values[i], timestamps[i]}; }
+};
+
+template <typename T> class BatchPool;
+
+// Fixed-capacity, move-only batch whose storage is a slab owned by a
+// BatchPool. Destroying the batch returns the slab to the pool, so once the
+// pool is constructed no frame or row ever touches the heap. The pool must
+// outlive every batch acquired from it.
+template <typename T>
+class Batch {
+public:
+    Batch() = default;
+    Batch(const Batch&) = delete;
+    Batch& operator=(const Batch&) = delete;
+
+    Batch(Batch&& other) noexcept { swap(other); }
+
+    Batch& operator=(Batch&& other) noexcept {
+        if (this != &other) {
+            release();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~Batch() { release(); }
+
+    explicit operator bool() const { return items != nullptr; }
+
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+    T* data() { return items; }
+    const T* data() const { return items; }
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return limit; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == limit; }
+    void clear() { count = 0; }
+
+    // for producers that fill data() directly, e.g. recvmmsg()
+    void resize(size_t n) { count = n < limit ? static_cast<uint32_t>(n) : limit; }
+
+    bool push(const T& item) {
+        if (count == limit) return false;
+        items[count++] = item;
+        return true;
+    }
+
+private:
+    friend class BatchPool<T>;
+
+    Batch(BatchPool<T>* pool, uint32_t slot, T* items, uint32_t limit)
+        : pool(pool), slot(slot), items(items), limit(limit) {}
+
+    void swap(Batch& other) noexcept {
+        std::swap(pool, other.pool);
+        std::swap(slot, other.slot);
+        std::swap(items, other.items);
+        std::swap(count, other.count);
+        std::swap(limit, other.limit);
+    }
+
+    void release() {
+        if (pool) pool->release(slot);
+        pool = nullptr;
+        items = nullptr;
+        count = 0;
+        limit = 0;
+    }
+
+    BatchPool<T>* pool = nullptr;
+    uint32_t slot = 0;
+    T* items = nullptr;
+    uint32_t count = 0;
+    uint32_t limit = 0;
+};
+
+template <typename T>
+class BatchPool {
+public:
+    BatchPool(uint32_t batches, uint32_t batchCapacity)
+        : capacity(batchCapacity), storage(new T[static_cast<size_t>(batches) * batchCapacity]) {
+        freeSlots.reserve(batches);
+        for (uint32_t i = batches; i > 0; i--) freeSlots.push_back(i - 1);
+    }
+
+    BatchPool(const BatchPool&) = delete;
+    BatchPool& operator=(const BatchPool&) = delete;
+
+    // Returns an empty (false) batch when the pool is exhausted.
+    Batch<T> acquire() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (freeSlots.empty()) return Batch<T>();
+        const uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return Batch<T>(this, slot, storage.get() + static_cast<size_t>(slot) * capacity, capacity);
+    }
+
+    size_t available() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return freeSlots.size();
+    }
+
+private:
+    friend class Batch<T>;
+
+    void release(uint32_t slot) {
+        std::lock_guard<std::mutex> guard(lock);
+        freeSlots.push_back(slot);  // never exceeds reserved size
+    }
+
+    mutable std::mutex lock;
+    const uint32_t capacity;
+    std::unique_ptr<T[]> storage;
+    std::vector<uint32_t> freeSlots;
+};
+
+using CanBatch = Batch<CanData>;
+using CanBatchPool = BatchPool<CanData>;
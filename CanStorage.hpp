@@ -0,0 +1,636 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <climits>
+#include <cstring>
+#include <sqlite3.h>
+#include "CanBatch.hpp"
+#include "Timestamp.hpp"
+#include "Rollup.hpp"
+#include "Trace.hpp"
+
+constexpr size_t PACK_MAX = CanColumns::CAPACITY;   // samples per packed row
+constexpr size_t PACKED_SAMPLE_MAX = 10 + 5 + 5;     // varint timestamp delta, id, value
+
+// SQLite buffer for decoded frames. All statements are prepared once in
+// open() and reused, so steady-state inserts and fetches don't re-parse SQL
+// and don't allocate. Inserted rows also feed the 1 s / 1 min / 1 h rollup
+// tables, written in the same transaction as the rows that close a bucket.
+//
+// Raw samples are keyed by seq, an INTEGER PRIMARY KEY: the table is the
+// rowid B-tree itself, appends go to its right edge and no AUTOINCREMENT
+// bookkeeping is done. seq is counted here rather than left to SQLite, which
+// would restart at 1 once the table is empty, so a seq already handed to an
+// upload in flight never names a newer row. seq order is receive order, and timestamps are on
+// the monotonic base, so seq ranges are time ranges without a second index.
+// With packing, up to packSamples samples of one insert share a row as a
+// BLOB of varints (timestamp delta, can_id, zigzag value), which removes
+// the per-row record and B-tree cell overhead. seq numbers samples, not
+// rows: a packed row takes the seq of its first sample and the following
+// ones are implied, so fetched samples carry consecutive seqs either way
+// and a gap means samples never made it out of the buffer. Upload positions
+// are sample seqs too, so an upload may stop inside a packed row; such a
+// row is deleted once its last sample is acknowledged.
+class CanStorage {
+public:
+    CanStorage() = default;
+    CanStorage(const CanStorage&) = delete;
+    CanStorage& operator=(const CanStorage&) = delete;
+    ~CanStorage() { close(); }
+
+    // packSamples > 1 selects the packed can_data_packed table, capped at
+    // PACK_MAX; 0 or 1 stores one row per sample in can_data.
+    bool open(const char* path, size_t packSamples = 0) {
+        pack = packSamples > PACK_MAX ? PACK_MAX : packSamples > 1 ? packSamples : 0;
+        int rc = sqlite3_open(path, &db);
+        if (rc != SQLITE_OK) return error();
+
+        // in memory nothing can be made durable, so skip syncing and keep the
+        // journal in RAM; on disk WAL appends instead of copying pages and
+        // NORMAL only syncs at checkpoints
+        const char* pragmaSQL = !strcmp(path, ":memory:")
+                                    ? "PRAGMA journal_mode = MEMORY; PRAGMA synchronous = OFF; PRAGMA temp_store = MEMORY;"
+                                    : "PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL; PRAGMA temp_store = MEMORY;";
+        rc = sqlite3_exec(db, pragmaSQL, nullptr, nullptr, nullptr);
+        if (rc != SQLITE_OK) return error();
+
+        const char* createTableSQL = pack ? "CREATE TABLE IF NOT EXISTS can_data_packed ("
+                                            "seq INTEGER PRIMARY KEY,"
+                                            "first_timestamp INTEGER NOT NULL,"
+                                            "count INTEGER NOT NULL,"
+                                            "samples BLOB NOT NULL);"
+                                          : "CREATE TABLE IF NOT EXISTS can_data ("
+                                            "seq INTEGER PRIMARY KEY,"
+                                            "can_id INTEGER NOT NULL,"
+                                            "value INTEGER NOT NULL,"
+                                            "timestamp INTEGER NOT NULL);";
+        rc = sqlite3_exec(db, createTableSQL, nullptr, nullptr, nullptr);
+        if (rc != SQLITE_OK) return error();
+        // for querySamples(): one id over a time range without a table scan
+        rc = sqlite3_exec(db, pack ? "CREATE INDEX IF NOT EXISTS can_data_packed_time ON can_data_packed (first_timestamp);"
+                                   : "CREATE INDEX IF NOT EXISTS can_data_id_time ON can_data (can_id, timestamp);",
+                          nullptr, nullptr, nullptr);
+        if (rc != SQLITE_OK) return error();
+        rc = sqlite3_exec(db, "CREATE TABLE IF NOT EXISTS clock_anchor ("
+                              "monotonic_us INTEGER PRIMARY KEY,"
+                              "realtime_us INTEGER NOT NULL);", nullptr, nullptr, nullptr);
+        if (rc != SQLITE_OK) return error();
+
+        for (int level = 0; level < ROLLUP_LEVELS; level++) {
+            const std::string table = ROLLUP_TABLES[level];
+            const std::string createRollupSQL = "CREATE TABLE IF NOT EXISTS " + table + " ("
+                                                "id INTEGER PRIMARY KEY,"
+                                                "can_id INTEGER NOT NULL,"
+                                                "bucket INTEGER NOT NULL,"
+                                                "min INTEGER NOT NULL,"
+                                                "max INTEGER NOT NULL,"
+                                                "sum INTEGER NOT NULL,"
+                                                "count INTEGER NOT NULL);";
+            rc = sqlite3_exec(db, createRollupSQL.c_str(), nullptr, nullptr, nullptr);
+            if (rc != SQLITE_OK) return error();
+            if (!prepare(("INSERT INTO " + table + " (can_id, bucket, min, max, sum, count) VALUES (?, ?, ?, ?, ?, ?);").c_str(),
+                         &rollupInsertStmt[level])
+                || !prepare(("SELECT id, can_id, bucket, min, max, sum, count FROM " + table + " ORDER BY id LIMIT ?;").c_str(),
+                            &rollupSelectStmt[level])
+                || !prepare(("DELETE FROM " + table + " WHERE id <= ?;").c_str(), &rollupDeleteStmt[level])
+                || !prepare(("DELETE FROM " + table + " WHERE id IN (SELECT id FROM " + table + " ORDER BY id LIMIT ?);").c_str(),
+                            &rollupEvictStmt[level])) {
+                return false;
+            }
+        }
+
+        const bool rawPrepared = pack
+            ? prepare("INSERT INTO can_data_packed (first_timestamp, count, samples, seq) VALUES (?, ?, ?, ?);", &insertStmt)
+                // the row holding sample ?1 + 1 starts at most PACK_MAX - 1 before it
+                && prepare(("SELECT seq, first_timestamp, count, samples FROM can_data_packed WHERE seq > ?1 - "
+                            + std::to_string(PACK_MAX) + " AND seq + count - 1 > ?1 ORDER BY seq LIMIT ?2;").c_str(),
+                            &selectStmt)
+                && prepare("DELETE FROM can_data_packed WHERE seq <= ?1 AND seq + count - 1 <= ?1;", &deleteStmt)
+                && prepare("SELECT COALESCE(SUM(count), 0) FROM can_data_packed WHERE seq <= ?1 AND seq + count - 1 <= ?1;",
+                           &countStmt)
+                && prepare("SELECT seq + count - 1, count FROM can_data_packed ORDER BY seq;", &headStmt)
+                && prepare("SELECT seq FROM can_data_packed WHERE first_timestamp <= ? ORDER BY first_timestamp DESC LIMIT 1;",
+                           &querySeekStmt)
+                && prepare("SELECT seq, first_timestamp, count, samples FROM can_data_packed WHERE seq >= ? ORDER BY seq LIMIT ?;",
+                           &queryStmt)
+            : prepare("INSERT INTO can_data (can_id, value, timestamp, seq) VALUES (?, ?, ?, ?);", &insertStmt)
+                && prepare("SELECT seq, can_id, value, timestamp FROM can_data WHERE seq > ?1 ORDER BY seq LIMIT ?2;",
+                           &selectStmt)
+                && prepare("DELETE FROM can_data WHERE seq <= ?;", &deleteStmt)
+                && prepare("SELECT COUNT(*) FROM can_data WHERE seq <= ?;", &countStmt)
+                && prepare("SELECT seq, 1 FROM can_data ORDER BY seq;", &headStmt)
+                && prepare("SELECT can_id, value, timestamp, seq FROM can_data WHERE can_id = ?1 AND timestamp >= ?2"
+                           " AND timestamp < ?3 AND (timestamp, seq) > (?2, ?4) ORDER BY timestamp, seq LIMIT ?5;",
+                           &queryStmt);
+        return rawPrepared
+            && prepare("BEGIN;", &beginStmt)
+            && prepare("COMMIT;", &commitStmt)
+            && prepare("INSERT OR REPLACE INTO clock_anchor (monotonic_us, realtime_us) VALUES (?, ?);", &anchorInsertStmt)
+            && prepare("SELECT monotonic_us, realtime_us FROM clock_anchor ORDER BY monotonic_us LIMIT ?;", &anchorSelectStmt)
+            && prepare("DELETE FROM clock_anchor WHERE monotonic_us <= ?;", &anchorDeleteStmt)
+            && restore();
+    }
+
+    void close() {
+        for (sqlite3_stmt* stmt : {beginStmt, commitStmt, insertStmt, selectStmt, deleteStmt, countStmt, headStmt,
+                                   queryStmt, querySeekStmt, anchorInsertStmt, anchorSelectStmt, anchorDeleteStmt}) {
+            sqlite3_finalize(stmt);
+        }
+        beginStmt = commitStmt = insertStmt = selectStmt = deleteStmt = countStmt = headStmt = nullptr;
+        queryStmt = querySeekStmt = nullptr;
+        anchorInsertStmt = anchorSelectStmt = anchorDeleteStmt = nullptr;
+        for (int level = 0; level < ROLLUP_LEVELS; level++) {
+            for (sqlite3_stmt** stmt : {&rollupInsertStmt[level], &rollupSelectStmt[level],
+                                        &rollupDeleteStmt[level], &rollupEvictStmt[level]}) {
+                sqlite3_finalize(*stmt);
+                *stmt = nullptr;
+            }
+        }
+        sqlite3_close(db);
+        db = nullptr;
+    }
+
+    // Inserts the whole batch in one transaction, returns rows stored.
+    size_t insert(const CanBatch& batch) {
+        const auto all = [](size_t) { return true; };
+        return insertRows(batch.size(), [&batch](size_t i) { return batch[i]; }, all, all);
+    }
+
+    // Bit i of rawMask stores row i as a sample, bit i of rollupMask folds
+    // it into the rollups; see Backpressure. Returns samples stored.
+    size_t insert(const CanColumns& cols, uint64_t rawMask = ~uint64_t{0}, uint64_t rollupMask = ~uint64_t{0}) {
+        return insertRows(cols.size(), [&cols](size_t i) { return cols.row(i); },
+                          [rawMask](size_t i) { return (rawMask >> i & 1) != 0; },
+                          [rollupMask](size_t i) { return (rollupMask >> i & 1) != 0; });
+    }
+
+    // Fills batch with the oldest samples after seq afterId, up to its
+    // capacity, stopping at the first one stamped at or after beforeUs so
+    // that nothing before lastId is left behind. lastId receives the seq of
+    // the last fetched sample. Packed rows are only cut by beforeUs, never by the
+    // capacity, so without a time bound lastId ends a row.
+    bool fetch(CanBatch& batch, int64_t afterId, int64_t& lastId, int64_t beforeUs = INT64_MAX) {
+        TRACE_SPAN("sqlite_select");
+        batch.clear();
+        lastId = afterId;
+        sqlite3_bind_int64(selectStmt, 1, afterId);
+        sqlite3_bind_int64(selectStmt, 2, static_cast<int64_t>(batch.capacity()));
+        bool bounded = false;
+        int rc;
+        while (!bounded && (rc = sqlite3_step(selectStmt)) == SQLITE_ROW) {
+            if (!pack) {
+                if (sqlite3_column_int64(selectStmt, 3) >= beforeUs) break;
+                batch.push({sqlite3_column_int(selectStmt, 1),
+                            sqlite3_column_int(selectStmt, 2),
+                            sqlite3_column_int64(selectStmt, 3),
+                            sqlite3_column_int64(selectStmt, 0)});
+                lastId = sqlite3_column_int64(selectStmt, 0);
+                continue;
+            }
+            const int64_t rowEnd = sqlite3_column_int64(selectStmt, 0) + sqlite3_column_int64(selectStmt, 2) - 1;
+            if (batch.size() + static_cast<size_t>(rowEnd - std::max<int64_t>(lastId, sqlite3_column_int64(selectStmt, 0) - 1))
+                > batch.capacity()) {
+                break;
+            }
+            const bool ok = unpackRow(selectStmt, [&](const CanData& sample) {
+                if (sample.seq <= afterId || bounded) return;
+                if (sample.timestamp >= beforeUs) {
+                    bounded = true;
+                    return;
+                }
+                batch.push(sample);
+                lastId = sample.seq;
+            });
+            if (!ok) {
+                std::cerr << "SQL error: malformed packed row " << sqlite3_column_int64(selectStmt, 0) << std::endl;
+                sqlite3_reset(selectStmt);
+                return false;
+            }
+        }
+        sqlite3_reset(selectStmt);
+        if (rc != SQLITE_DONE && rc != SQLITE_ROW) return error();
+        return true;
+    }
+
+    // Deletes all samples up to and including seq lastId; a packed row only
+    // goes once all of its samples do.
+    bool remove(int64_t lastId) {
+        TRACE_SPAN("sqlite_delete");
+        size_t deleted = 0;
+        if (pack) {
+            sqlite3_bind_int64(countStmt, 1, lastId);
+            if (sqlite3_step(countStmt) == SQLITE_ROW) deleted = static_cast<size_t>(sqlite3_column_int64(countStmt, 0));
+            sqlite3_reset(countStmt);
+        }
+        sqlite3_bind_int64(deleteStmt, 1, lastId);
+        if (!step(deleteStmt)) return false;
+        if (!pack) deleted = static_cast<size_t>(sqlite3_changes(db));
+        forget(rows, deleted);
+        return true;
+    }
+
+    // Position of a querySamples() scan; a fresh cursor starts at fromUs.
+    struct QueryCursor {
+        int64_t timestamp = 0;   // one row per sample: last sample returned
+        int64_t seq = -1;        // packed: next row to decode; -1 = not started
+        uint32_t taken = 0;      // packed: samples of row seq already returned
+        bool done = false;       // range exhausted
+    };
+
+    // Fills out with up to max samples of can_id with fromUs <= timestamp <
+    // toUs, in time order, continuing from cursor; returns how many and sets
+    // cursor.done at the end of the range. Each call is one bounded scan, so
+    // callers can release a lock in between. Only buffered (not yet
+    // uploaded) samples are seen. With one row per sample this is a range
+    // scan of the (can_id, timestamp) index. Packed rows have no per-id
+    // index: the scan seeks through first_timestamp and decodes every row
+    // up to toUs, so one id costs as much as all of them over the range, and
+    // a slice reads about max / PACK_MAX rows (at least one).
+    size_t querySamples(uint32_t can_id, int64_t fromUs, int64_t toUs, QueryCursor& cursor, CanData* out, size_t max) {
+        size_t count = 0;
+        int rc;
+        if (!pack) {
+            if (cursor.seq < 0) cursor = {fromUs, 0};
+            sqlite3_bind_int64(queryStmt, 1, can_id);
+            sqlite3_bind_int64(queryStmt, 2, cursor.timestamp);
+            sqlite3_bind_int64(queryStmt, 3, toUs);
+            sqlite3_bind_int64(queryStmt, 4, cursor.seq);
+            sqlite3_bind_int64(queryStmt, 5, static_cast<int64_t>(max));
+            while ((rc = sqlite3_step(queryStmt)) == SQLITE_ROW) {
+                out[count] = {sqlite3_column_int(queryStmt, 0), sqlite3_column_int(queryStmt, 1),
+                              sqlite3_column_int64(queryStmt, 2), sqlite3_column_int64(queryStmt, 3)};
+                cursor = {out[count].timestamp, out[count].seq};
+                count++;
+            }
+            sqlite3_reset(queryStmt);
+            if (rc != SQLITE_DONE) error();
+            cursor.done = count < max;
+            return count;
+        }
+
+        if (cursor.seq < 0) {
+            // the row holding fromUs starts at or before it
+            cursor.seq = 0;
+            sqlite3_bind_int64(querySeekStmt, 1, fromUs);
+            if (sqlite3_step(querySeekStmt) == SQLITE_ROW) cursor.seq = sqlite3_column_int64(querySeekStmt, 0);
+            sqlite3_reset(querySeekStmt);
+        }
+        const size_t limit = std::max<size_t>(max / PACK_MAX, 1);
+        sqlite3_bind_int64(queryStmt, 1, cursor.seq);
+        sqlite3_bind_int64(queryStmt, 2, static_cast<int64_t>(limit));
+        size_t rows = 0;
+        bool ended = false;
+        rc = SQLITE_DONE;
+        while (!ended && count < max && (rc = sqlite3_step(queryStmt)) == SQLITE_ROW) {
+            // rows are in receive order, so the first one starting at toUs ends the range
+            if (sqlite3_column_int64(queryStmt, 0) != cursor.seq) cursor.taken = 0;   // row uploaded meanwhile
+            if (sqlite3_column_int64(queryStmt, 1) >= toUs) {
+                ended = true;
+                break;
+            }
+            uint32_t match = 0;
+            bool full = false;
+            const bool ok = unpackRow(queryStmt, [&](const CanData& sample) {
+                if (static_cast<uint32_t>(sample.can_id) != can_id || sample.timestamp < fromUs || sample.timestamp >= toUs) {
+                    return;
+                }
+                // skip what the previous call returned of this row
+                if (match < cursor.taken) {
+                    match++;
+                } else if (count == max) {
+                    full = true;
+                } else {
+                    out[count++] = sample;
+                    match++;
+                }
+            });
+            rows++;
+            if (!ok) std::cerr << "SQL error: malformed packed row " << sqlite3_column_int64(queryStmt, 0) << std::endl;
+            if (full) {
+                // out is full inside this row, the next call resumes in it
+                cursor.taken = match;
+                break;
+            }
+            cursor.seq = sqlite3_column_int64(queryStmt, 0) + sqlite3_column_int64(queryStmt, 2);
+            cursor.taken = 0;
+        }
+        sqlite3_reset(queryStmt);
+        if (rc != SQLITE_DONE && rc != SQLITE_ROW) error();
+        cursor.done = ended || (rc == SQLITE_DONE && rows < limit);
+        return count;
+    }
+
+    // Writes rollup buckets of ids that went quiet, see RollupBuilder.
+    void flushRollups(int64_t nowUs) {
+        if (!step(beginStmt)) return;
+        rollups.flushIdle(nowUs, [this](int level, const RollupRow& row) { insertRollup(level, row); });
+        if (!step(commitStmt)) sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+
+    // Samples stamped before their id's open rollup bucket since the last
+    // call, see RollupBuilder.
+    uint64_t takeLateRollupSamples() { return rollups.takeLate(); }
+
+    // Fills out with up to max oldest rows of a rollup level, returns how
+    // many; lastId receives the id of the last one.
+    size_t fetchRollups(int level, RollupRow* out, size_t max, int64_t& lastId) {
+        sqlite3_stmt* stmt = rollupSelectStmt[level];
+        sqlite3_bind_int64(stmt, 1, static_cast<int64_t>(max));
+        size_t count = 0;
+        int rc;
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            lastId = sqlite3_column_int64(stmt, 0);
+            out[count++] = {static_cast<uint32_t>(sqlite3_column_int64(stmt, 1)), sqlite3_column_int64(stmt, 2),
+                            sqlite3_column_int(stmt, 3), sqlite3_column_int(stmt, 4),
+                            sqlite3_column_int64(stmt, 5), static_cast<uint32_t>(sqlite3_column_int64(stmt, 6))};
+        }
+        sqlite3_reset(stmt);
+        if (rc != SQLITE_DONE) error();
+        return count;
+    }
+
+    bool removeRollups(int level, int64_t lastId) {
+        sqlite3_bind_int64(rollupDeleteStmt[level], 1, lastId);
+        if (!step(rollupDeleteStmt[level])) return false;
+        forget(rollupRows[level], static_cast<size_t>(sqlite3_changes(db)));
+        return true;
+    }
+
+    // Keeps raw plus rollup rows within maxRows by deleting the oldest rows
+    // of the finest table first: raw rows (already folded into rollups),
+    // then 1 s, 1 min and 1 h buckets last. Returns rows evicted.
+    size_t enforceRetention(size_t maxRows) {
+        if (maxRows == 0 || totalRows() <= maxRows) return 0;
+        size_t evicted = evictRaw(totalRows() - maxRows);
+        for (int level = 0; level < ROLLUP_LEVELS && totalRows() > maxRows; level++) {
+            sqlite3_bind_int64(rollupEvictStmt[level], 1, static_cast<int64_t>(totalRows() - maxRows));
+            if (!step(rollupEvictStmt[level])) break;
+            const size_t deleted = static_cast<size_t>(sqlite3_changes(db));
+            forget(rollupRows[level], deleted);
+            evicted += deleted;
+        }
+        return evicted;
+    }
+
+    // Clock anchors are buffered next to the rows they date and uploaded
+    // ahead of them.
+    bool insertAnchor(const ClockAnchor& anchor) {
+        sqlite3_bind_int64(anchorInsertStmt, 1, anchor.monotonicUs);
+        sqlite3_bind_int64(anchorInsertStmt, 2, anchor.realtimeUs);
+        if (!step(anchorInsertStmt)) return false;
+        anchors++;
+        return true;
+    }
+
+    // Fills out with up to max oldest anchors, returns how many.
+    size_t fetchAnchors(ClockAnchor* out, size_t max) {
+        sqlite3_bind_int64(anchorSelectStmt, 1, static_cast<int64_t>(max));
+        size_t count = 0;
+        int rc;
+        while ((rc = sqlite3_step(anchorSelectStmt)) == SQLITE_ROW) {
+            out[count++] = {sqlite3_column_int64(anchorSelectStmt, 0), sqlite3_column_int64(anchorSelectStmt, 1)};
+        }
+        sqlite3_reset(anchorSelectStmt);
+        if (rc != SQLITE_DONE) error();
+        return count;
+    }
+
+    // Deletes anchors up to and including monotonicUs.
+    bool removeAnchors(int64_t monotonicUs) {
+        sqlite3_bind_int64(anchorDeleteStmt, 1, monotonicUs);
+        if (!step(anchorDeleteStmt)) return false;
+        const size_t deleted = static_cast<size_t>(sqlite3_changes(db));
+        anchors = deleted < anchors ? anchors - deleted : 0;
+        return true;
+    }
+
+    size_t backlog() const { return rows; }
+    size_t rollupBacklog(int level) const { return rollupRows[level]; }
+    size_t totalRows() const { return rows + rollupRows[0] + rollupRows[1] + rollupRows[2]; }
+    size_t anchorBacklog() const { return anchors; }
+    size_t packSamples() const { return pack; }
+    sqlite3* handle() const { return db; }
+
+private:
+    bool error() {
+        std::cerr << "SQL error: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    // raw(i) selects rows stored as samples, rollup(i) rows folded into the
+    // rollups; returns samples stored.
+    template <typename RowAt, typename Raw, typename Rollup>
+    size_t insertRows(size_t count, RowAt rowAt, Raw raw, Rollup rollup) {
+        if (count == 0) return 0;
+        TRACE_SPAN("sqlite_insert", static_cast<int64_t>(count));
+        if (!step(beginStmt)) return 0;
+        size_t stored = 0;
+        size_t pending = 0;          // samples in the packed buffer
+        int64_t firstTimestamp = 0;
+        int64_t previous = 0;
+        size_t bytes = 0;
+        for (size_t i = 0; i < count; i++) {
+            const CanData entry = rowAt(i);
+            if (rollup(i)) {
+                rollups.add(static_cast<uint32_t>(entry.can_id), entry.value, entry.timestamp,
+                            [this](int level, const RollupRow& row) { insertRollup(level, row); });
+            }
+            if (!raw(i)) continue;
+            if (!pack) {
+                sqlite3_bind_int(insertStmt, 1, entry.can_id);
+                sqlite3_bind_int(insertStmt, 2, entry.value);
+                sqlite3_bind_int64(insertStmt, 3, entry.timestamp);
+                stored += insertRaw(1);
+                continue;
+            }
+            if (pending == 0) {
+                firstTimestamp = previous = entry.timestamp;
+                bytes = 0;
+            }
+            bytes = packSample(entry, previous, bytes);
+            previous = entry.timestamp;
+            if (++pending == pack) {
+                stored += insertPacked(firstTimestamp, pending, bytes);
+                pending = 0;
+            }
+        }
+        if (pending) stored += insertPacked(firstTimestamp, pending, bytes);
+        if (!step(commitStmt)) {
+            sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+            return 0;
+        }
+        rows += stored;
+        return stored;
+    }
+
+    size_t insertPacked(int64_t firstTimestamp, size_t count, size_t bytes) {
+        sqlite3_bind_int64(insertStmt, 1, firstTimestamp);
+        sqlite3_bind_int64(insertStmt, 2, static_cast<int64_t>(count));
+        sqlite3_bind_blob(insertStmt, 3, packed, static_cast<int>(bytes), SQLITE_STATIC);
+        return insertRaw(count);
+    }
+
+    // Steps the bound insert statement under the next seq, which then moves
+    // on by the row's sample count.
+    size_t insertRaw(size_t samples) {
+        sqlite3_bind_int64(insertStmt, 4, nextSeq);
+        if (!step(insertStmt)) return 0;
+        nextSeq += static_cast<int64_t>(samples);
+        return samples;
+    }
+
+    void insertRollup(int level, const RollupRow& row) {
+        sqlite3_stmt* stmt = rollupInsertStmt[level];
+        sqlite3_bind_int64(stmt, 1, row.can_id);
+        sqlite3_bind_int64(stmt, 2, row.bucket);
+        sqlite3_bind_int(stmt, 3, row.min);
+        sqlite3_bind_int(stmt, 4, row.max);
+        sqlite3_bind_int64(stmt, 5, row.sum);
+        sqlite3_bind_int64(stmt, 6, row.count);
+        if (step(stmt)) rollupRows[level]++;
+    }
+
+    // Drops the oldest raw rows holding at least samples samples.
+    size_t evictRaw(size_t samples) {
+        int64_t lastSeq = 0;
+        size_t covered = 0;
+        while (covered < samples && sqlite3_step(headStmt) == SQLITE_ROW) {
+            lastSeq = sqlite3_column_int64(headStmt, 0);
+            covered += static_cast<size_t>(sqlite3_column_int64(headStmt, 1));
+        }
+        sqlite3_reset(headStmt);
+        const size_t before = rows;
+        if (covered == 0 || !remove(lastSeq)) return 0;
+        return before - rows;
+    }
+
+    size_t packSample(const CanData& entry, int64_t previous, size_t pos) {
+        pos = putVarint(packed, pos, zigzag(entry.timestamp - previous));
+        pos = putVarint(packed, pos, static_cast<uint32_t>(entry.can_id));
+        return putVarint(packed, pos, zigzag(entry.value));
+    }
+
+    // Passes the samples of stmt's current row (seq, first_timestamp, count,
+    // samples) to out(const CanData&).
+    template <typename Out>
+    bool unpackRow(sqlite3_stmt* stmt, Out out) {
+        const uint8_t* data = static_cast<const uint8_t*>(sqlite3_column_blob(stmt, 3));
+        const size_t size = static_cast<size_t>(sqlite3_column_bytes(stmt, 3));
+        const size_t count = static_cast<size_t>(sqlite3_column_int64(stmt, 2));
+        int64_t timestamp = sqlite3_column_int64(stmt, 1);
+        const int64_t seq = sqlite3_column_int64(stmt, 0);
+        size_t pos = 0;
+        for (size_t i = 0; i < count; i++) {
+            uint64_t delta, can_id, value;
+            if (!getVarint(data, size, pos, delta) || !getVarint(data, size, pos, can_id)
+                || !getVarint(data, size, pos, value)) {
+                return false;
+            }
+            timestamp += unzigzag(delta);
+            out(CanData{static_cast<int>(can_id), static_cast<int>(unzigzag(value)), timestamp,
+                        seq + static_cast<int64_t>(i)});
+        }
+        return pos == size;
+    }
+
+    static uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+    static int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    static size_t putVarint(uint8_t* out, size_t pos, uint64_t v) {
+        while (v >= 0x80) {
+            out[pos++] = static_cast<uint8_t>(v | 0x80);
+            v >>= 7;
+        }
+        out[pos++] = static_cast<uint8_t>(v);
+        return pos;
+    }
+
+    static bool getVarint(const uint8_t* in, size_t size, size_t& pos, uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64 && pos < size; shift += 7) {
+            const uint8_t byte = in[pos++];
+            v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    static void forget(size_t& count, size_t deleted) { count = deleted < count ? count - deleted : 0; }
+
+    bool prepare(const char* sql, sqlite3_stmt** stmt) {
+        TRACE_SPAN("sqlite_prepare");
+        if (sqlite3_prepare_v3(db, sql, -1, SQLITE_PREPARE_PERSISTENT, stmt, nullptr) != SQLITE_OK) return error();
+        return true;
+    }
+
+    bool step(sqlite3_stmt* stmt) {
+        const int rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        if (rc != SQLITE_DONE) return error();
+        return true;
+    }
+
+    // Picks up what a previous process left in a file buffer: the backlog
+    // counts and the next seq, so uploads resume after the last row that was
+    // acknowledged and deleted. Rollup buckets that were still open are lost.
+    bool restore() {
+        int64_t samples = 0, lastSeq = 0, anchorRows = 0;
+        if (!queryInt(pack ? "SELECT COALESCE(SUM(count), 0), COALESCE(MAX(seq + count - 1), 0) FROM can_data_packed;"
+                           : "SELECT COUNT(*), COALESCE(MAX(seq), 0) FROM can_data;", samples, &lastSeq)
+            || !queryInt("SELECT COUNT(*) FROM clock_anchor;", anchorRows)) {
+            return false;
+        }
+        rows = static_cast<size_t>(samples);
+        nextSeq = lastSeq + 1;
+        anchors = static_cast<size_t>(anchorRows);
+        for (int level = 0; level < ROLLUP_LEVELS; level++) {
+            int64_t count = 0;
+            if (!queryInt(("SELECT COUNT(*) FROM " + std::string(ROLLUP_TABLES[level]) + ";").c_str(), count)) return false;
+            rollupRows[level] = static_cast<size_t>(count);
+        }
+        return true;
+    }
+
+    // One-off query returning one or two integer columns, for open() only.
+    bool queryInt(const char* sql, int64_t& first, int64_t* second = nullptr) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return error();
+        const bool ok = sqlite3_step(stmt) == SQLITE_ROW;
+        if (ok) {
+            first = sqlite3_column_int64(stmt, 0);
+            if (second) *second = sqlite3_column_int64(stmt, 1);
+        } else {
+            error();
+        }
+        sqlite3_finalize(stmt);
+        return ok;
+    }
+
+    sqlite3* db = nullptr;
+    sqlite3_stmt* beginStmt = nullptr;
+    sqlite3_stmt* commitStmt = nullptr;
+    sqlite3_stmt* insertStmt = nullptr;
+    sqlite3_stmt* selectStmt = nullptr;
+    sqlite3_stmt* deleteStmt = nullptr;
+    sqlite3_stmt* countStmt = nullptr;
+    sqlite3_stmt* headStmt = nullptr;
+    sqlite3_stmt* queryStmt = nullptr;
+    sqlite3_stmt* querySeekStmt = nullptr;
+    sqlite3_stmt* anchorInsertStmt = nullptr;
+    sqlite3_stmt* anchorSelectStmt = nullptr;
+    sqlite3_stmt* anchorDeleteStmt = nullptr;
+    sqlite3_stmt* rollupInsertStmt[ROLLUP_LEVELS] = {};
+    sqlite3_stmt* rollupSelectStmt[ROLLUP_LEVELS] = {};
+    sqlite3_stmt* rollupDeleteStmt[ROLLUP_LEVELS] = {};
+    sqlite3_stmt* rollupEvictStmt[ROLLUP_LEVELS] = {};
+    RollupBuilder rollups;
+    size_t pack = 0;
+    int64_t nextSeq = 1;
+    uint8_t packed[PACK_MAX * PACKED_SAMPLE_MAX];
+    size_t rows = 0;
+    size_t rollupRows[ROLLUP_LEVELS] = {};
+    size_t anchors = 0;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <sys/stat.h>
+#include "CanBatch.hpp"
+
+// Append-only columnar store for received samples: a directory with one
+// file of packed little-endian values per column, row i of the table being
+// entry i of every file. Rows are buffered per column and written a block
+// at a time, so each file gets large sequential writes and a reader that
+// wants one signal's values scans only the columns it needs, e.g. in numpy:
+//   np.fromfile("can_id.u32", "<u4"), np.fromfile("value.i32", "<i4")
+class ColumnStore {
+public:
+    static constexpr size_t BLOCK = 4096;   // rows buffered per column
+
+    ColumnStore() = default;
+    ColumnStore(const ColumnStore&) = delete;
+    ColumnStore& operator=(const ColumnStore&) = delete;
+    ~ColumnStore() { close(); }
+
+    bool open(const std::string& dir) {
+        if (mkdir(dir.c_str(), 0755) < 0 && errno != EEXIST) {
+            perror(dir.c_str());
+            return false;
+        }
+        for (size_t c = 0; c < COLUMNS; c++) {
+            const std::string path = dir + "/" + NAMES[c];
+            files[c] = std::fopen(path.c_str(), "ab");
+            if (files[c] == nullptr) {
+                perror(path.c_str());
+                close();
+                return false;
+            }
+        }
+        indexes.reserve(BLOCK);
+        ids.reserve(BLOCK);
+        values.reserve(BLOCK);
+        timestamps.reserve(BLOCK);
+        received.reserve(BLOCK);
+        return true;
+    }
+
+    // index: publisher sequence number; receivedUs: local receive time.
+    bool append(uint32_t index, const CanData& sample, int64_t receivedUs) {
+        indexes.push_back(index);
+        ids.push_back(static_cast<uint32_t>(sample.can_id));
+        values.push_back(sample.value);
+        timestamps.push_back(sample.timestamp);
+        received.push_back(receivedUs);
+        rows++;
+        return indexes.size() < BLOCK || flush();
+    }
+
+    bool flush() {
+        bool ok = write(0, indexes) && write(1, ids) && write(2, values) && write(3, timestamps) && write(4, received);
+        for (std::FILE* file : files) ok = file && std::fflush(file) == 0 && ok;
+        indexes.clear();
+        ids.clear();
+        values.clear();
+        timestamps.clear();
+        received.clear();
+        if (!ok) perror("Column store write");
+        return ok;
+    }
+
+    void close() {
+        if (files[0] == nullptr) return;
+        flush();
+        for (std::FILE*& file : files) {
+            if (file) std::fclose(file);
+            file = nullptr;
+        }
+    }
+
+    uint64_t rowCount() const { return rows; }
+
+private:
+    static constexpr size_t COLUMNS = 5;
+    static constexpr const char* NAMES[COLUMNS] = {"index.u32", "can_id.u32", "value.i32", "timestamp.i64", "received.i64"};
+
+    template <typename T>
+    bool write(size_t column, const std::vector<T>& data) {
+        return data.empty() || std::fwrite(data.data(), sizeof(T), data.size(), files[column]) == data.size();
+    }
+
+    std::FILE* files[COLUMNS] = {};
+    std::vector<uint32_t> indexes;
+    std::vector<uint32_t> ids;
+    std::vector<int32_t> values;
+    std::vector<int64_t> timestamps;   // sender's monotonic µs, see README "Timestamps"
+    std::vector<int64_t> received;
+    uint64_t rows = 0;
+};
@@ -0,0 +1,455 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <cstdint>
+#include <climits>
+#include <csignal>
+#include <ctime>
+#include "Signals.hpp"
+
+struct SignalInfo {
+    std::string name;
+    std::string unit;
+    int32_t min = INT32_MIN;           // plausible raw value range
+    int32_t max = INT32_MAX;
+};
+
+inline std::map<uint32_t, SignalInfo> defaultSignals() {
+    std::map<uint32_t, SignalInfo> signals;
+    for (const SignalDef& s : SIGNALS) signals[s.can_id] = {s.name, s.unit};
+    return signals;
+}
+
+// One comparison of an alarm rule, on the signal's value or on its rate of
+// change per second. Once met it stays met until the value is back past the
+// threshold by more than hysteresis.
+struct AlarmCondition {
+    uint32_t can_id = 0;
+    bool rate = false;
+    bool above = false;                // '>' or '<'
+    double threshold = 0;
+    double hysteresis = 0;
+};
+
+// Raised while all of its conditions are met.
+struct AlarmRule {
+    std::string name;
+    std::vector<AlarmCondition> conditions;
+};
+
+// "0x103 < 150 hyst 10 and 0x100 > 1000", "0x104 rate > 2"
+inline bool parseAlarmRule(const std::string& name, const std::string& text, AlarmRule& rule) {
+    rule = {name, {}};
+    std::istringstream words(text);
+    std::string word, next;
+    while (words >> word) {
+        AlarmCondition cond;
+        cond.can_id = std::stoul(word, nullptr, 0);
+        std::string op;
+        if (!(words >> op)) return false;
+        if (op == "rate") {
+            cond.rate = true;
+            if (!(words >> op)) return false;
+        }
+        if (op != "<" && op != ">") return false;
+        cond.above = op == ">";
+        if (!(words >> word)) return false;
+        cond.threshold = std::stod(word);
+        next.clear();
+        words >> next;
+        if (next == "hyst") {
+            if (!(words >> word)) return false;
+            cond.hysteresis = std::stod(word);
+            next.clear();
+            words >> next;
+        }
+        rule.conditions.push_back(cond);
+        if (next.empty()) return true;
+        if (next != "and") return false;
+    }
+    return false;
+}
+
+// A receive lane of its own: socket, thread and buffer. "vcan1",
+// "vcan0 cpu 2 ids 0x200-0x2FF".
+struct ShardConfig {
+    std::string name;
+    std::string interface;
+    int cpu = -1;                      // core for its receive thread, -1 = not pinned
+    std::vector<uint32_t> ids;         // its CAN filter, empty = the filter key
+
+    bool operator==(const ShardConfig& other) const {
+        return name == other.name && interface == other.interface && cpu == other.cpu && ids == other.ids;
+    }
+};
+
+// Immutable configuration snapshot. Fields in the first group are read once
+// at startup, the rest are applied in place on SIGHUP.
+struct LoggerConfig {
+    // startup only
+    std::string interface = "vcan0";
+    std::string database = ":memory:";
+    size_t packSamples = 0;           // samples per SQLite row, 0 = one row each
+    int ddsDomain = 0;
+    std::string topicName = "CanLoggerTopic";
+    std::string clockTopicName = "CanLoggerClockTopic";
+    std::string alarmTopicName = "CanLoggerAlarmTopic";
+    std::string rollupTopicName = "CanLoggerRollupTopic";
+    std::string healthTopicName = "CanLoggerHealthTopic";
+    std::string queryTopicName = "CanLoggerQueryTopic";
+    std::string queryReplyTopicName = "CanLoggerQueryReplyTopic";
+    int maxSamples = 1000;
+    int allocatedSamples = 200;
+    std::string metricsFile = "/tmp/can_logger.prom";
+    std::string metricsSocket = "/tmp/can_logger.metrics.sock";
+    std::string traceFile = "/tmp/can_logger.trace.json";   // SIGUSR2 writes spans here, see Trace.hpp
+    std::string signalPartitionPrefix = "can/";  // readers in partition prefix + id want that id, empty = off
+    std::string lvcShm = "/can_logger_lvc";   // last value cache segment, empty = not shared
+    int rtCpu = -1;                    // core for the CAN receive thread, -1 = not pinned
+    int rtPriority = 0;                // its SCHED_FIFO priority, 0 = normal scheduling
+    bool lockMemory = false;           // mlockall and prefaulted stack
+    int rcvbufBytes = 0;               // CAN socket SO_RCVBUF, 0 = kernel default
+    bool supervise = false;            // run as supervisor + restartable worker
+    int watchdogMs = 5000;             // supervisor kills a worker silent this long, 0 = never
+    std::vector<ShardConfig> shards;   // empty = one on interface
+    int ioThreads = 2;                 // event loops for the upload stages, 1-3
+    bool ioUring = false;              // io_uring CAN receive and batched WAL writes
+    int flashEraseBlockKb = 0;         // database pages written per erase block of this size, 0 = as SQLite does
+    bool compressPages = false;        // database pages deflated in place by the logger VFS
+
+    // reloadable
+    size_t minEntriesToSend = 100;     // backlog rows that trigger an upload
+    int flushIntervalMs = 0;           // upload a smaller backlog after this, 0 = never
+    bool printFrames = true;
+    int anchorIntervalS = 60;          // clock anchor period, also written on clock steps
+    size_t maxBufferedRows = 1000000;  // raw + rollup rows kept while offline, 0 = unlimited
+    std::vector<uint32_t> criticalIds{0x100, 0x103, 0x200};   // never degraded: RPM, oil pressure, scoop load
+    std::vector<uint32_t> lowPriorityIds;   // downsampled first
+    std::array<size_t, 3> degradeRows{250000, 500000, 750000};   // backlog entering levels 1-3, 0 = off
+    std::array<size_t, 3> degradeMemoryMb{0, 0, 0};              // SQLite heap entering levels 1-3, 0 = off
+    int downsampleMs = 100;            // min spacing of stored low-priority rows while degraded
+    uint32_t busBitrate = 500000;      // for the bus load when the interface reports none (vcan)
+    int healthIntervalMs = 1000;       // bus health record period
+    int busOffRestartMs = 500;         // restart a bus-off controller after this, 0 = leave it to the kernel
+    int interestHoldS = 300;           // ids no matched reader asked for this long are deleted unsent, 0 = never
+    std::vector<uint32_t> filter;      // accepted CAN ids, empty = accept all
+    std::map<uint32_t, SignalInfo> signals = defaultSignals();
+    std::vector<AlarmRule> alarms;
+
+    const SignalInfo* signal(uint32_t can_id) const {
+        auto it = signals.find(can_id);
+        return it == signals.end() ? nullptr : &it->second;
+    }
+};
+
+inline std::string trim(const std::string& s) {
+    const size_t first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+}
+
+// "a, b, c": thresholds of the three degradation levels.
+inline bool parseLevels(const std::string& text, std::array<size_t, 3>& levels) {
+    std::istringstream list(text);
+    std::string item;
+    size_t n = 0;
+    while (std::getline(list, item, ',')) {
+        if (n == levels.size()) return false;
+        levels[n++] = std::stoul(trim(item));
+    }
+    return n == levels.size();
+}
+
+// "0x100-0x105, 0x200" -> expanded id list
+inline bool parseIdList(const std::string& text, std::vector<uint32_t>& ids) {
+    std::istringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        item = trim(item);
+        if (item.empty()) continue;
+        const size_t dash = item.find('-');
+        // 64-bit so that an id past 32 bits is refused rather than truncated
+        const uint64_t first = std::stoull(item.substr(0, dash), nullptr, 0);
+        const uint64_t last = dash == std::string::npos ? first : std::stoull(item.substr(dash + 1), nullptr, 0);
+        if (last < first || last > UINT32_MAX || last - first > 2048) return false;
+        for (uint64_t id = first; id <= last; id++) ids.push_back(static_cast<uint32_t>(id));
+    }
+    return true;
+}
+
+// "interface [cpu n] [ids list]", the id list last
+inline bool parseShard(const std::string& name, const std::string& text, ShardConfig& shard) {
+    shard = {name, "", -1, {}};
+    std::istringstream words(text);
+    std::string word;
+    if (!(words >> shard.interface)) return false;
+    while (words >> word) {
+        if (word == "cpu" && words >> word) {
+            shard.cpu = std::stoi(word);
+        } else if (word == "ids") {
+            std::string list;
+            std::getline(words, list);
+            return parseIdList(list, shard.ids) && !shard.ids.empty();
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parses "key = value" lines, '#' starts a comment. Returns false and
+// fills error on the first bad line, cfg is then partially updated.
+inline bool parseConfig(std::istream& in, LoggerConfig& cfg, std::string& error) {
+    std::string line;
+    for (int lineNo = 1; std::getline(in, line); lineNo++) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            error = "line " + std::to_string(lineNo) + ": expected key = value";
+            return false;
+        }
+        const std::string key = trim(line.substr(0, eq));
+        const std::string value = trim(line.substr(eq + 1));
+        try {
+            if (key == "interface") cfg.interface = value;
+            else if (key == "database") cfg.database = value;
+            else if (key == "pack_samples") cfg.packSamples = std::stoul(value);
+            else if (key == "dds_domain") cfg.ddsDomain = std::stoi(value);
+            else if (key == "topic") cfg.topicName = value;
+            else if (key == "clock_topic") cfg.clockTopicName = value;
+            else if (key == "alarm_topic") cfg.alarmTopicName = value;
+            else if (key == "rollup_topic") cfg.rollupTopicName = value;
+            else if (key == "health_topic") cfg.healthTopicName = value;
+            else if (key == "query_topic") cfg.queryTopicName = value;
+            else if (key == "query_reply_topic") cfg.queryReplyTopicName = value;
+            else if (key == "max_samples") cfg.maxSamples = std::stoi(value);
+            else if (key == "allocated_samples") cfg.allocatedSamples = std::stoi(value);
+            else if (key == "metrics_file") cfg.metricsFile = value;
+            else if (key == "metrics_socket") cfg.metricsSocket = value;
+            else if (key == "trace_file") cfg.traceFile = value;
+            else if (key == "signal_partition_prefix") cfg.signalPartitionPrefix = value;
+            else if (key == "lvc_shm") cfg.lvcShm = value;
+            else if (key == "rt_cpu") cfg.rtCpu = std::stoi(value);
+            else if (key == "rt_priority") cfg.rtPriority = std::stoi(value);
+            else if (key == "lock_memory") cfg.lockMemory = value == "true" || value == "1";
+            else if (key == "rcvbuf_bytes") cfg.rcvbufBytes = std::stoi(value);
+            else if (key == "supervise") cfg.supervise = value == "true" || value == "1";
+            else if (key == "watchdog_ms") cfg.watchdogMs = std::stoi(value);
+            else if (key == "io_threads") cfg.ioThreads = std::clamp(std::stoi(value), 1, 3);
+            else if (key == "io_uring") cfg.ioUring = value == "true" || value == "1";
+            else if (key == "flash_erase_block_kb") cfg.flashEraseBlockKb = std::clamp(std::stoi(value), 0, 4096);
+            else if (key == "compress_pages") cfg.compressPages = value == "true" || value == "1";
+            else if (key == "min_entries_to_send") cfg.minEntriesToSend = std::stoul(value);
+            else if (key == "flush_interval_ms") cfg.flushIntervalMs = std::stoi(value);
+            else if (key == "print_frames") cfg.printFrames = value == "true" || value == "1";
+            else if (key == "anchor_interval_s") cfg.anchorIntervalS = std::stoi(value);
+            else if (key == "max_buffered_rows") cfg.maxBufferedRows = std::stoul(value);
+            else if (key == "downsample_ms") cfg.downsampleMs = std::stoi(value);
+            else if (key == "bus_bitrate") cfg.busBitrate = std::stoul(value);
+            else if (key == "health_interval_ms") cfg.healthIntervalMs = std::stoi(value);
+            else if (key == "busoff_restart_ms") cfg.busOffRestartMs = std::stoi(value);
+            else if (key == "interest_hold_s") cfg.interestHoldS = std::stoi(value);
+            else if (key == "degrade_rows") {
+                if (!parseLevels(value, cfg.degradeRows)) throw std::invalid_argument(value);
+            } else if (key == "degrade_memory_mb") {
+                if (!parseLevels(value, cfg.degradeMemoryMb)) throw std::invalid_argument(value);
+            } else if (key == "critical_ids") {
+                cfg.criticalIds.clear();
+                if (!parseIdList(value, cfg.criticalIds)) throw std::invalid_argument(value);
+            } else if (key == "low_priority_ids") {
+                cfg.lowPriorityIds.clear();
+                if (!parseIdList(value, cfg.lowPriorityIds)) throw std::invalid_argument(value);
+            } else if (key == "filter") {
+                cfg.filter.clear();
+                if (!parseIdList(value, cfg.filter)) throw std::invalid_argument(value);
+            } else if (key.compare(0, 7, "signal.") == 0) {
+                // name, unit[, min, max]
+                const uint32_t can_id = std::stoul(key.substr(7), nullptr, 0);
+                std::vector<std::string> fields;
+                std::istringstream list(value);
+                std::string field;
+                while (std::getline(list, field, ',')) fields.push_back(trim(field));
+                if (fields.empty() || fields.size() == 3 || fields.size() > 4) throw std::invalid_argument(value);
+                SignalInfo& signal = cfg.signals[can_id];
+                signal = {fields[0], fields.size() > 1 ? fields[1] : ""};
+                if (fields.size() == 4) {
+                    signal.min = std::stoi(fields[2], nullptr, 0);
+                    signal.max = std::stoi(fields[3], nullptr, 0);
+                }
+            } else if (key.compare(0, 6, "shard.") == 0) {
+                ShardConfig shard;
+                if (key.size() == 6 || !parseShard(key.substr(6), value, shard)) throw std::invalid_argument(value);
+                cfg.shards.push_back(shard);
+            } else if (key.compare(0, 6, "alarm.") == 0) {
+                AlarmRule rule;
+                if (key.size() == 6 || !parseAlarmRule(key.substr(6), value, rule)) throw std::invalid_argument(value);
+                cfg.alarms.push_back(rule);
+            } else {
+                error = "line " + std::to_string(lineNo) + ": unknown key " + key;
+                return false;
+            }
+        } catch (const std::exception&) {
+            error = "line " + std::to_string(lineNo) + ": bad value for " + key;
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool loadConfig(const std::string& path, LoggerConfig& cfg) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Config " << path << " not found, using defaults" << std::endl;
+        return true;
+    }
+    std::string error;
+    if (!parseConfig(in, cfg, error)) {
+        std::cerr << "Config " << path << ": " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Holds the current snapshot behind one atomic pointer: readers take it with
+// a single acquire load and never block, reload publishes a new snapshot.
+// Replaced snapshots are retained until exit since a reader may still use
+// them; reloads are operator-driven and a snapshot is a few hundred bytes.
+class ConfigStore {
+public:
+    explicit ConfigStore(std::unique_ptr<const LoggerConfig> initial) { publish(std::move(initial)); }
+
+    const LoggerConfig& get() const { return *current.load(std::memory_order_acquire); }
+
+    void publish(std::unique_ptr<const LoggerConfig> cfg) {
+        std::lock_guard<std::mutex> guard(lock);
+        current.store(cfg.get(), std::memory_order_release);
+        versions.push_back(std::move(cfg));
+    }
+
+private:
+    std::atomic<const LoggerConfig*> current{nullptr};
+    std::mutex lock;
+    std::vector<std::unique_ptr<const LoggerConfig>> versions;
+};
+
+// Waits for SIGHUP on its own thread, parses the file there and publishes
+// the new snapshot, so the ingest thread is never interrupted. blockSignal()
+// must run before any other thread is created.
+class ConfigReloader {
+public:
+    using Callback = std::function<void(const LoggerConfig& previous, const LoggerConfig& next)>;
+
+    static void blockSignal() {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGHUP);
+        pthread_sigmask(SIG_BLOCK, &set, nullptr);
+    }
+
+    ~ConfigReloader() { stop(); }
+
+    void start(const std::string& configPath, ConfigStore& configStore, Callback applied) {
+        path = configPath;
+        store = &configStore;
+        onApplied = std::move(applied);
+        running = true;
+        worker = std::thread([this] { run(); });
+    }
+
+    void stop() {
+        if (!running.exchange(false)) return;
+        worker.join();
+    }
+
+private:
+    void reload() {
+        const LoggerConfig& previous = store->get();
+        auto next = std::make_unique<LoggerConfig>();
+        if (!loadConfig(path, *next)) {
+            std::cerr << "Config reload rejected, keeping current settings" << std::endl;
+            return;
+        }
+        if (next->interface != previous.interface || next->database != previous.database
+            || next->packSamples != previous.packSamples
+            || next->ddsDomain != previous.ddsDomain || next->topicName != previous.topicName
+            || next->clockTopicName != previous.clockTopicName || next->alarmTopicName != previous.alarmTopicName
+            || next->maxSamples != previous.maxSamples || next->allocatedSamples != previous.allocatedSamples
+            || next->metricsFile != previous.metricsFile || next->metricsSocket != previous.metricsSocket
+            || next->traceFile != previous.traceFile || next->signalPartitionPrefix != previous.signalPartitionPrefix
+            || next->lvcShm != previous.lvcShm || next->rollupTopicName != previous.rollupTopicName
+            || next->healthTopicName != previous.healthTopicName || next->queryTopicName != previous.queryTopicName
+            || next->queryReplyTopicName != previous.queryReplyTopicName
+            || next->rtCpu != previous.rtCpu || next->rtPriority != previous.rtPriority
+            || next->lockMemory != previous.lockMemory || next->rcvbufBytes != previous.rcvbufBytes
+            || next->supervise != previous.supervise || next->watchdogMs != previous.watchdogMs
+            || next->shards != previous.shards || next->ioThreads != previous.ioThreads
+            || next->ioUring != previous.ioUring || next->flashEraseBlockKb != previous.flashEraseBlockKb
+            || next->compressPages != previous.compressPages) {
+            std::cerr << "Config reload: interface, database, DDS, metrics, cache, real-time, supervisor and shard settings need a restart"
+                      << std::endl;
+        }
+        // keep startup-only settings as they are in effect
+        next->interface = previous.interface;
+        next->database = previous.database;
+        next->packSamples = previous.packSamples;
+        next->ddsDomain = previous.ddsDomain;
+        next->topicName = previous.topicName;
+        next->clockTopicName = previous.clockTopicName;
+        next->alarmTopicName = previous.alarmTopicName;
+        next->rollupTopicName = previous.rollupTopicName;
+        next->healthTopicName = previous.healthTopicName;
+        next->queryTopicName = previous.queryTopicName;
+        next->queryReplyTopicName = previous.queryReplyTopicName;
+        next->maxSamples = previous.maxSamples;
+        next->allocatedSamples = previous.allocatedSamples;
+        next->metricsFile = previous.metricsFile;
+        next->metricsSocket = previous.metricsSocket;
+        next->traceFile = previous.traceFile;
+        next->signalPartitionPrefix = previous.signalPartitionPrefix;
+        next->lvcShm = previous.lvcShm;
+        next->rtCpu = previous.rtCpu;
+        next->rtPriority = previous.rtPriority;
+        next->lockMemory = previous.lockMemory;
+        next->rcvbufBytes = previous.rcvbufBytes;
+        next->supervise = previous.supervise;
+        next->watchdogMs = previous.watchdogMs;
+        next->shards = previous.shards;
+        next->ioThreads = previous.ioThreads;
+        next->ioUring = previous.ioUring;
+        next->flashEraseBlockKb = previous.flashEraseBlockKb;
+        next->compressPages = previous.compressPages;
+        const LoggerConfig& applied = *next;
+        store->publish(std::move(next));
+        if (onApplied) onApplied(previous, applied);
+        std::cerr << "Config reloaded from " << path << std::endl;
+    }
+
+    void run() {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGHUP);
+        const struct timespec timeout{0, 200000000};
+        while (running) {
+            if (sigtimedwait(&set, nullptr, &timeout) == SIGHUP) reload();
+        }
+    }
+
+    std::string path;
+    ConfigStore* store = nullptr;
+    Callback onApplied;
+    std::atomic<bool> running{false};
+    std::thread worker;
+};
@@ -7,12 +7,16 @@
 #include <fastdds/dds/publisher/Publisher.hpp>
 #include <fastdds/dds/publisher/DataWriter.hpp>
 #include <fastdds/dds/publisher/DataWriterListener.hpp>
+#include <fastdds/dds/builtin/topic/SubscriptionBuiltinTopicData.hpp>
+
+#include <atomic>
 
 #include "LogEntryPubSubTypes.hpp"
 #include "LogEntry.hpp"
 
 struct PubListener : public eprosima::fastdds::dds::DataWriterListener {
     int matched{};
+    std::atomic<uint32_t> changes{0};   // bumped on every match and unmatch
 
     void on_publication_matched(
             eprosima::fastdds::dds::DataWriter*,
@@ -29,5 +33,6 @@ struct PubListener : public eprosima::fastdds::dds::DataWriterListener {
                       << " is not a valid value for PublicationMatchedStatus current count change" << std::endl;
         }
         std::cout << "matched count: " << matched << std::endl;
+        changes.fetch_add(1, std::memory_order_release);
     }
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
+
+#include <functional>
+#include <iostream>
+
+#include "LogEntryPubSubTypes.hpp"
+#include "LogEntry.hpp"
+
+template <typename Sample = CanLogEntry>
+struct SubListener : public eprosima::fastdds::dds::DataReaderListener {
+    int matched{};
+    std::function<void(const Sample&)> onSample;
+
+    void on_subscription_matched(
+            eprosima::fastdds::dds::DataReader*,
+            const eprosima::fastdds::dds::SubscriptionMatchedStatus& info) override
+    {
+        matched = info.current_count;
+        std::cerr << "Subscriber matched count: " << matched << std::endl;
+    }
+
+    void on_data_available(eprosima::fastdds::dds::DataReader* reader) override
+    {
+        Sample sample;
+        eprosima::fastdds::dds::SampleInfo info;
+        while (reader->take_next_sample(&sample, &info) == eprosima::fastdds::dds::RETCODE_OK) {
+            if (info.valid_data && onSample) onSample(sample);
+        }
+    }
+};
@@ -23,6 +23,7 @@
 #define FAST_DDS_GENERATED__LOGENTRY_HPP
 
 #include <cstdint>
+#include <string>
 #include <utility>
 
 #if defined(_WIN32)
@@ -192,7 +193,7 @@ public:
      * @param _can_id New value for member can_id
      */
     eProsima_user_DllExport void can_id(
-            uint8_t _can_id)
+            uint32_t _can_id)
     {
         m_can_id = _can_id;
     }
@@ -201,7 +202,7 @@ public:
      * @brief This function returns the value of member can_id
      * @return Value of member can_id
      */
-    eProsima_user_DllExport uint8_t can_id() const
+    eProsima_user_DllExport uint32_t can_id() const
     {
         return m_can_id;
     }
@@ -210,7 +211,7 @@ public:
      * @brief This function returns a reference to member can_id
      * @return Reference to member can_id
      */
-    eProsima_user_DllExport uint8_t& can_id()
+    eProsima_user_DllExport uint32_t& can_id()
     {
         return m_can_id;
     }
@@ -278,12 +279,2071 @@ public:
 private:
 
     uint32_t m_index{0};
-    uint8_t m_can_id{0};
+    uint32_t m_can_id{0};
     int32_t m_value{0};
     int64_t m_timestamp{0};
 
 };
 
+/*!
+ * @brief This class represents the structure CanClockAnchor defined by the user in the IDL file.
+ * @ingroup LogEntry
+ */
+class CanClockAnchor
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     */
+    eProsima_user_DllExport CanClockAnchor()
+    {
+    }
+
+    /*!
+     * @brief Default destructor.
+     */
+    eProsima_user_DllExport ~CanClockAnchor()
+    {
+    }
+
+    /*!
+     * @brief Copy constructor.
+     * @param x Reference to the object CanClockAnchor that will be copied.
+     */
+    eProsima_user_DllExport CanClockAnchor(
+            const CanClockAnchor& x)
+    {
+                    m_monotonic_us = x.m_monotonic_us;
+
+                    m_realtime_us = x.m_realtime_us;
+
+    }
+
+    /*!
+     * @brief Move constructor.
+     * @param x Reference to the object CanClockAnchor that will be copied.
+     */
+    eProsima_user_DllExport CanClockAnchor(
+            CanClockAnchor&& x) noexcept
+    {
+        m_monotonic_us = x.m_monotonic_us;
+        m_realtime_us = x.m_realtime_us;
+    }
+
+    /*!
+     * @brief Copy assignment.
+     * @param x Reference to the object CanClockAnchor that will be copied.
+     */
+    eProsima_user_DllExport CanClockAnchor& operator =(
+            const CanClockAnchor& x)
+    {
+
+                    m_monotonic_us = x.m_monotonic_us;
+
+                    m_realtime_us = x.m_realtime_us;
+
+        return *this;
+    }
+
+    /*!
+     * @brief Move assignment.
+     * @param x Reference to the object CanClockAnchor that will be copied.
+     */
+    eProsima_user_DllExport CanClockAnchor& operator =(
+            CanClockAnchor&& x) noexcept
+    {
+
+        m_monotonic_us = x.m_monotonic_us;
+        m_realtime_us = x.m_realtime_us;
+        return *this;
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanClockAnchor object to compare.
+     */
+    eProsima_user_DllExport bool operator ==(
+            const CanClockAnchor& x) const
+    {
+        return (m_monotonic_us == x.m_monotonic_us &&
+           m_realtime_us == x.m_realtime_us);
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanClockAnchor object to compare.
+     */
+    eProsima_user_DllExport bool operator !=(
+            const CanClockAnchor& x) const
+    {
+        return !(*this == x);
+    }
+
+    /*!
+     * @brief This function sets a value in member monotonic_us
+     * @param _monotonic_us New value for member monotonic_us
+     */
+    eProsima_user_DllExport void monotonic_us(
+            int64_t _monotonic_us)
+    {
+        m_monotonic_us = _monotonic_us;
+    }
+
+    /*!
+     * @brief This function returns the value of member monotonic_us
+     * @return Value of member monotonic_us
+     */
+    eProsima_user_DllExport int64_t monotonic_us() const
+    {
+        return m_monotonic_us;
+    }
+
+    /*!
+     * @brief This function returns a reference to member monotonic_us
+     * @return Reference to member monotonic_us
+     */
+    eProsima_user_DllExport int64_t& monotonic_us()
+    {
+        return m_monotonic_us;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member realtime_us
+     * @param _realtime_us New value for member realtime_us
+     */
+    eProsima_user_DllExport void realtime_us(
+            int64_t _realtime_us)
+    {
+        m_realtime_us = _realtime_us;
+    }
+
+    /*!
+     * @brief This function returns the value of member realtime_us
+     * @return Value of member realtime_us
+     */
+    eProsima_user_DllExport int64_t realtime_us() const
+    {
+        return m_realtime_us;
+    }
+
+    /*!
+     * @brief This function returns a reference to member realtime_us
+     * @return Reference to member realtime_us
+     */
+    eProsima_user_DllExport int64_t& realtime_us()
+    {
+        return m_realtime_us;
+    }
+
+
+
+private:
+
+    int64_t m_monotonic_us{0};
+    int64_t m_realtime_us{0};
+
+};
+
+/*!
+ * @brief This class represents the structure CanAlarm defined by the user in the IDL file.
+ * @ingroup LogEntry
+ */
+class CanAlarm
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     */
+    eProsima_user_DllExport CanAlarm()
+    {
+    }
+
+    /*!
+     * @brief Default destructor.
+     */
+    eProsima_user_DllExport ~CanAlarm()
+    {
+    }
+
+    /*!
+     * @brief Copy constructor.
+     * @param x Reference to the object CanAlarm that will be copied.
+     */
+    eProsima_user_DllExport CanAlarm(
+            const CanAlarm& x)
+    {
+                    m_name = x.m_name;
+
+                    m_active = x.m_active;
+
+                    m_can_id = x.m_can_id;
+
+                    m_value = x.m_value;
+
+                    m_timestamp = x.m_timestamp;
+
+    }
+
+    /*!
+     * @brief Move constructor.
+     * @param x Reference to the object CanAlarm that will be copied.
+     */
+    eProsima_user_DllExport CanAlarm(
+            CanAlarm&& x) noexcept
+    {
+        m_name = std::move(x.m_name);
+        m_active = x.m_active;
+        m_can_id = x.m_can_id;
+        m_value = x.m_value;
+        m_timestamp = x.m_timestamp;
+    }
+
+    /*!
+     * @brief Copy assignment.
+     * @param x Reference to the object CanAlarm that will be copied.
+     */
+    eProsima_user_DllExport CanAlarm& operator =(
+            const CanAlarm& x)
+    {
+
+                    m_name = x.m_name;
+
+                    m_active = x.m_active;
+
+                    m_can_id = x.m_can_id;
+
+                    m_value = x.m_value;
+
+                    m_timestamp = x.m_timestamp;
+
+        return *this;
+    }
+
+    /*!
+     * @brief Move assignment.
+     * @param x Reference to the object CanAlarm that will be copied.
+     */
+    eProsima_user_DllExport CanAlarm& operator =(
+            CanAlarm&& x) noexcept
+    {
+
+        m_name = std::move(x.m_name);
+        m_active = x.m_active;
+        m_can_id = x.m_can_id;
+        m_value = x.m_value;
+        m_timestamp = x.m_timestamp;
+        return *this;
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanAlarm object to compare.
+     */
+    eProsima_user_DllExport bool operator ==(
+            const CanAlarm& x) const
+    {
+        return (m_name == x.m_name &&
+           m_active == x.m_active &&
+           m_can_id == x.m_can_id &&
+           m_value == x.m_value &&
+           m_timestamp == x.m_timestamp);
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanAlarm object to compare.
+     */
+    eProsima_user_DllExport bool operator !=(
+            const CanAlarm& x) const
+    {
+        return !(*this == x);
+    }
+
+    /*!
+     * @brief This function copies the value in member name
+     * @param _name New value to be copied in member name
+     */
+    eProsima_user_DllExport void name(
+            const std::string& _name)
+    {
+        m_name = _name;
+    }
+
+    /*!
+     * @brief This function moves the value in member name
+     * @param _name New value to be moved in member name
+     */
+    eProsima_user_DllExport void name(
+            std::string&& _name)
+    {
+        m_name = std::move(_name);
+    }
+
+    /*!
+     * @brief This function returns a constant reference to member name
+     * @return Constant reference to member name
+     */
+    eProsima_user_DllExport const std::string& name() const
+    {
+        return m_name;
+    }
+
+    /*!
+     * @brief This function returns a reference to member name
+     * @return Reference to member name
+     */
+    eProsima_user_DllExport std::string& name()
+    {
+        return m_name;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member active
+     * @param _active New value for member active
+     */
+    eProsima_user_DllExport void active(
+            bool _active)
+    {
+        m_active = _active;
+    }
+
+    /*!
+     * @brief This function returns the value of member active
+     * @return Value of member active
+     */
+    eProsima_user_DllExport bool active() const
+    {
+        return m_active;
+    }
+
+    /*!
+     * @brief This function returns a reference to member active
+     * @return Reference to member active
+     */
+    eProsima_user_DllExport bool& active()
+    {
+        return m_active;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member can_id
+     * @param _can_id New value for member can_id
+     */
+    eProsima_user_DllExport void can_id(
+            uint32_t _can_id)
+    {
+        m_can_id = _can_id;
+    }
+
+    /*!
+     * @brief This function returns the value of member can_id
+     * @return Value of member can_id
+     */
+    eProsima_user_DllExport uint32_t can_id() const
+    {
+        return m_can_id;
+    }
+
+    /*!
+     * @brief This function returns a reference to member can_id
+     * @return Reference to member can_id
+     */
+    eProsima_user_DllExport uint32_t& can_id()
+    {
+        return m_can_id;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member value
+     * @param _value New value for member value
+     */
+    eProsima_user_DllExport void value(
+            int32_t _value)
+    {
+        m_value = _value;
+    }
+
+    /*!
+     * @brief This function returns the value of member value
+     * @return Value of member value
+     */
+    eProsima_user_DllExport int32_t value() const
+    {
+        return m_value;
+    }
+
+    /*!
+     * @brief This function returns a reference to member value
+     * @return Reference to member value
+     */
+    eProsima_user_DllExport int32_t& value()
+    {
+        return m_value;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member timestamp
+     * @param _timestamp New value for member timestamp
+     */
+    eProsima_user_DllExport void timestamp(
+            int64_t _timestamp)
+    {
+        m_timestamp = _timestamp;
+    }
+
+    /*!
+     * @brief This function returns the value of member timestamp
+     * @return Value of member timestamp
+     */
+    eProsima_user_DllExport int64_t timestamp() const
+    {
+        return m_timestamp;
+    }
+
+    /*!
+     * @brief This function returns a reference to member timestamp
+     * @return Reference to member timestamp
+     */
+    eProsima_user_DllExport int64_t& timestamp()
+    {
+        return m_timestamp;
+    }
+
+
+
+private:
+
+    std::string m_name;
+    bool m_active{false};
+    uint32_t m_can_id{0};
+    int32_t m_value{0};
+    int64_t m_timestamp{0};
+
+};
+
+/*!
+ * @brief This class represents the structure CanRollup defined by the user in the IDL file.
+ * @ingroup LogEntry
+ */
+class CanRollup
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     */
+    eProsima_user_DllExport CanRollup()
+    {
+    }
+
+    /*!
+     * @brief Default destructor.
+     */
+    eProsima_user_DllExport ~CanRollup()
+    {
+    }
+
+    /*!
+     * @brief Copy constructor.
+     * @param x Reference to the object CanRollup that will be copied.
+     */
+    eProsima_user_DllExport CanRollup(
+            const CanRollup& x)
+    {
+                    m_resolution_s = x.m_resolution_s;
+
+                    m_can_id = x.m_can_id;
+
+                    m_bucket_start = x.m_bucket_start;
+
+                    m_min = x.m_min;
+
+                    m_max = x.m_max;
+
+                    m_mean = x.m_mean;
+
+                    m_count = x.m_count;
+
+    }
+
+    /*!
+     * @brief Move constructor.
+     * @param x Reference to the object CanRollup that will be copied.
+     */
+    eProsima_user_DllExport CanRollup(
+            CanRollup&& x) noexcept
+    {
+        m_resolution_s = x.m_resolution_s;
+        m_can_id = x.m_can_id;
+        m_bucket_start = x.m_bucket_start;
+        m_min = x.m_min;
+        m_max = x.m_max;
+        m_mean = x.m_mean;
+        m_count = x.m_count;
+    }
+
+    /*!
+     * @brief Copy assignment.
+     * @param x Reference to the object CanRollup that will be copied.
+     */
+    eProsima_user_DllExport CanRollup& operator =(
+            const CanRollup& x)
+    {
+
+                    m_resolution_s = x.m_resolution_s;
+
+                    m_can_id = x.m_can_id;
+
+                    m_bucket_start = x.m_bucket_start;
+
+                    m_min = x.m_min;
+
+                    m_max = x.m_max;
+
+                    m_mean = x.m_mean;
+
+                    m_count = x.m_count;
+
+        return *this;
+    }
+
+    /*!
+     * @brief Move assignment.
+     * @param x Reference to the object CanRollup that will be copied.
+     */
+    eProsima_user_DllExport CanRollup& operator =(
+            CanRollup&& x) noexcept
+    {
+
+        m_resolution_s = x.m_resolution_s;
+        m_can_id = x.m_can_id;
+        m_bucket_start = x.m_bucket_start;
+        m_min = x.m_min;
+        m_max = x.m_max;
+        m_mean = x.m_mean;
+        m_count = x.m_count;
+        return *this;
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanRollup object to compare.
+     */
+    eProsima_user_DllExport bool operator ==(
+            const CanRollup& x) const
+    {
+        return (m_resolution_s == x.m_resolution_s &&
+           m_can_id == x.m_can_id &&
+           m_bucket_start == x.m_bucket_start &&
+           m_min == x.m_min &&
+           m_max == x.m_max &&
+           m_mean == x.m_mean &&
+           m_count == x.m_count);
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanRollup object to compare.
+     */
+    eProsima_user_DllExport bool operator !=(
+            const CanRollup& x) const
+    {
+        return !(*this == x);
+    }
+
+    /*!
+     * @brief This function sets a value in member resolution_s
+     * @param _resolution_s New value for member resolution_s
+     */
+    eProsima_user_DllExport void resolution_s(
+            uint32_t _resolution_s)
+    {
+        m_resolution_s = _resolution_s;
+    }
+
+    /*!
+     * @brief This function returns the value of member resolution_s
+     * @return Value of member resolution_s
+     */
+    eProsima_user_DllExport uint32_t resolution_s() const
+    {
+        return m_resolution_s;
+    }
+
+    /*!
+     * @brief This function returns a reference to member resolution_s
+     * @return Reference to member resolution_s
+     */
+    eProsima_user_DllExport uint32_t& resolution_s()
+    {
+        return m_resolution_s;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member can_id
+     * @param _can_id New value for member can_id
+     */
+    eProsima_user_DllExport void can_id(
+            uint32_t _can_id)
+    {
+        m_can_id = _can_id;
+    }
+
+    /*!
+     * @brief This function returns the value of member can_id
+     * @return Value of member can_id
+     */
+    eProsima_user_DllExport uint32_t can_id() const
+    {
+        return m_can_id;
+    }
+
+    /*!
+     * @brief This function returns a reference to member can_id
+     * @return Reference to member can_id
+     */
+    eProsima_user_DllExport uint32_t& can_id()
+    {
+        return m_can_id;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member bucket_start
+     * @param _bucket_start New value for member bucket_start
+     */
+    eProsima_user_DllExport void bucket_start(
+            int64_t _bucket_start)
+    {
+        m_bucket_start = _bucket_start;
+    }
+
+    /*!
+     * @brief This function returns the value of member bucket_start
+     * @return Value of member bucket_start
+     */
+    eProsima_user_DllExport int64_t bucket_start() const
+    {
+        return m_bucket_start;
+    }
+
+    /*!
+     * @brief This function returns a reference to member bucket_start
+     * @return Reference to member bucket_start
+     */
+    eProsima_user_DllExport int64_t& bucket_start()
+    {
+        return m_bucket_start;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member min
+     * @param _min New value for member min
+     */
+    eProsima_user_DllExport void min(
+            int32_t _min)
+    {
+        m_min = _min;
+    }
+
+    /*!
+     * @brief This function returns the value of member min
+     * @return Value of member min
+     */
+    eProsima_user_DllExport int32_t min() const
+    {
+        return m_min;
+    }
+
+    /*!
+     * @brief This function returns a reference to member min
+     * @return Reference to member min
+     */
+    eProsima_user_DllExport int32_t& min()
+    {
+        return m_min;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member max
+     * @param _max New value for member max
+     */
+    eProsima_user_DllExport void max(
+            int32_t _max)
+    {
+        m_max = _max;
+    }
+
+    /*!
+     * @brief This function returns the value of member max
+     * @return Value of member max
+     */
+    eProsima_user_DllExport int32_t max() const
+    {
+        return m_max;
+    }
+
+    /*!
+     * @brief This function returns a reference to member max
+     * @return Reference to member max
+     */
+    eProsima_user_DllExport int32_t& max()
+    {
+        return m_max;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member mean
+     * @param _mean New value for member mean
+     */
+    eProsima_user_DllExport void mean(
+            double _mean)
+    {
+        m_mean = _mean;
+    }
+
+    /*!
+     * @brief This function returns the value of member mean
+     * @return Value of member mean
+     */
+    eProsima_user_DllExport double mean() const
+    {
+        return m_mean;
+    }
+
+    /*!
+     * @brief This function returns a reference to member mean
+     * @return Reference to member mean
+     */
+    eProsima_user_DllExport double& mean()
+    {
+        return m_mean;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member count
+     * @param _count New value for member count
+     */
+    eProsima_user_DllExport void count(
+            uint32_t _count)
+    {
+        m_count = _count;
+    }
+
+    /*!
+     * @brief This function returns the value of member count
+     * @return Value of member count
+     */
+    eProsima_user_DllExport uint32_t count() const
+    {
+        return m_count;
+    }
+
+    /*!
+     * @brief This function returns a reference to member count
+     * @return Reference to member count
+     */
+    eProsima_user_DllExport uint32_t& count()
+    {
+        return m_count;
+    }
+
+
+
+private:
+
+    uint32_t m_resolution_s{0};
+    uint32_t m_can_id{0};
+    int64_t m_bucket_start{0};
+    int32_t m_min{0};
+    int32_t m_max{0};
+    double m_mean{0.0};
+    uint32_t m_count{0};
+
+};
+
+/*!
+ * @brief This class represents the structure CanBusHealth defined by the user in the IDL file.
+ * @ingroup LogEntry
+ */
+class CanBusHealth
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     */
+    eProsima_user_DllExport CanBusHealth()
+    {
+    }
+
+    /*!
+     * @brief Default destructor.
+     */
+    eProsima_user_DllExport ~CanBusHealth()
+    {
+    }
+
+    /*!
+     * @brief Copy constructor.
+     * @param x Reference to the object CanBusHealth that will be copied.
+     */
+    eProsima_user_DllExport CanBusHealth(
+            const CanBusHealth& x)
+    {
+                    m_timestamp = x.m_timestamp;
+
+                    m_state = x.m_state;
+
+                    m_tx_errors = x.m_tx_errors;
+
+                    m_rx_errors = x.m_rx_errors;
+
+                    m_load_permille = x.m_load_permille;
+
+                    m_frames = x.m_frames;
+
+                    m_error_frames = x.m_error_frames;
+
+                    m_bus_off_count = x.m_bus_off_count;
+
+                    m_reconnects = x.m_reconnects;
+
+                    m_bus = x.m_bus;
+
+    }
+
+    /*!
+     * @brief Move constructor.
+     * @param x Reference to the object CanBusHealth that will be copied.
+     */
+    eProsima_user_DllExport CanBusHealth(
+            CanBusHealth&& x) noexcept
+    {
+        m_timestamp = x.m_timestamp;
+        m_state = x.m_state;
+        m_tx_errors = x.m_tx_errors;
+        m_rx_errors = x.m_rx_errors;
+        m_load_permille = x.m_load_permille;
+        m_frames = x.m_frames;
+        m_error_frames = x.m_error_frames;
+        m_bus_off_count = x.m_bus_off_count;
+        m_reconnects = x.m_reconnects;
+        m_bus = std::move(x.m_bus);
+    }
+
+    /*!
+     * @brief Copy assignment.
+     * @param x Reference to the object CanBusHealth that will be copied.
+     */
+    eProsima_user_DllExport CanBusHealth& operator =(
+            const CanBusHealth& x)
+    {
+
+                    m_timestamp = x.m_timestamp;
+
+                    m_state = x.m_state;
+
+                    m_tx_errors = x.m_tx_errors;
+
+                    m_rx_errors = x.m_rx_errors;
+
+                    m_load_permille = x.m_load_permille;
+
+                    m_frames = x.m_frames;
+
+                    m_error_frames = x.m_error_frames;
+
+                    m_bus_off_count = x.m_bus_off_count;
+
+                    m_reconnects = x.m_reconnects;
+
+                    m_bus = x.m_bus;
+
+        return *this;
+    }
+
+    /*!
+     * @brief Move assignment.
+     * @param x Reference to the object CanBusHealth that will be copied.
+     */
+    eProsima_user_DllExport CanBusHealth& operator =(
+            CanBusHealth&& x) noexcept
+    {
+
+        m_timestamp = x.m_timestamp;
+        m_state = x.m_state;
+        m_tx_errors = x.m_tx_errors;
+        m_rx_errors = x.m_rx_errors;
+        m_load_permille = x.m_load_permille;
+        m_frames = x.m_frames;
+        m_error_frames = x.m_error_frames;
+        m_bus_off_count = x.m_bus_off_count;
+        m_reconnects = x.m_reconnects;
+        m_bus = std::move(x.m_bus);
+        return *this;
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanBusHealth object to compare.
+     */
+    eProsima_user_DllExport bool operator ==(
+            const CanBusHealth& x) const
+    {
+        return (m_timestamp == x.m_timestamp &&
+           m_state == x.m_state &&
+           m_tx_errors == x.m_tx_errors &&
+           m_rx_errors == x.m_rx_errors &&
+           m_load_permille == x.m_load_permille &&
+           m_frames == x.m_frames &&
+           m_error_frames == x.m_error_frames &&
+           m_bus_off_count == x.m_bus_off_count &&
+           m_reconnects == x.m_reconnects &&
+           m_bus == x.m_bus);
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanBusHealth object to compare.
+     */
+    eProsima_user_DllExport bool operator !=(
+            const CanBusHealth& x) const
+    {
+        return !(*this == x);
+    }
+
+    /*!
+     * @brief This function sets a value in member timestamp
+     * @param _timestamp New value for member timestamp
+     */
+    eProsima_user_DllExport void timestamp(
+            int64_t _timestamp)
+    {
+        m_timestamp = _timestamp;
+    }
+
+    /*!
+     * @brief This function returns the value of member timestamp
+     * @return Value of member timestamp
+     */
+    eProsima_user_DllExport int64_t timestamp() const
+    {
+        return m_timestamp;
+    }
+
+    /*!
+     * @brief This function returns a reference to member timestamp
+     * @return Reference to member timestamp
+     */
+    eProsima_user_DllExport int64_t& timestamp()
+    {
+        return m_timestamp;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member state
+     * @param _state New value for member state
+     */
+    eProsima_user_DllExport void state(
+            uint8_t _state)
+    {
+        m_state = _state;
+    }
+
+    /*!
+     * @brief This function returns the value of member state
+     * @return Value of member state
+     */
+    eProsima_user_DllExport uint8_t state() const
+    {
+        return m_state;
+    }
+
+    /*!
+     * @brief This function returns a reference to member state
+     * @return Reference to member state
+     */
+    eProsima_user_DllExport uint8_t& state()
+    {
+        return m_state;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member tx_errors
+     * @param _tx_errors New value for member tx_errors
+     */
+    eProsima_user_DllExport void tx_errors(
+            uint8_t _tx_errors)
+    {
+        m_tx_errors = _tx_errors;
+    }
+
+    /*!
+     * @brief This function returns the value of member tx_errors
+     * @return Value of member tx_errors
+     */
+    eProsima_user_DllExport uint8_t tx_errors() const
+    {
+        return m_tx_errors;
+    }
+
+    /*!
+     * @brief This function returns a reference to member tx_errors
+     * @return Reference to member tx_errors
+     */
+    eProsima_user_DllExport uint8_t& tx_errors()
+    {
+        return m_tx_errors;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member rx_errors
+     * @param _rx_errors New value for member rx_errors
+     */
+    eProsima_user_DllExport void rx_errors(
+            uint8_t _rx_errors)
+    {
+        m_rx_errors = _rx_errors;
+    }
+
+    /*!
+     * @brief This function returns the value of member rx_errors
+     * @return Value of member rx_errors
+     */
+    eProsima_user_DllExport uint8_t rx_errors() const
+    {
+        return m_rx_errors;
+    }
+
+    /*!
+     * @brief This function returns a reference to member rx_errors
+     * @return Reference to member rx_errors
+     */
+    eProsima_user_DllExport uint8_t& rx_errors()
+    {
+        return m_rx_errors;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member load_permille
+     * @param _load_permille New value for member load_permille
+     */
+    eProsima_user_DllExport void load_permille(
+            uint16_t _load_permille)
+    {
+        m_load_permille = _load_permille;
+    }
+
+    /*!
+     * @brief This function returns the value of member load_permille
+     * @return Value of member load_permille
+     */
+    eProsima_user_DllExport uint16_t load_permille() const
+    {
+        return m_load_permille;
+    }
+
+    /*!
+     * @brief This function returns a reference to member load_permille
+     * @return Reference to member load_permille
+     */
+    eProsima_user_DllExport uint16_t& load_permille()
+    {
+        return m_load_permille;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member frames
+     * @param _frames New value for member frames
+     */
+    eProsima_user_DllExport void frames(
+            uint32_t _frames)
+    {
+        m_frames = _frames;
+    }
+
+    /*!
+     * @brief This function returns the value of member frames
+     * @return Value of member frames
+     */
+    eProsima_user_DllExport uint32_t frames() const
+    {
+        return m_frames;
+    }
+
+    /*!
+     * @brief This function returns a reference to member frames
+     * @return Reference to member frames
+     */
+    eProsima_user_DllExport uint32_t& frames()
+    {
+        return m_frames;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member error_frames
+     * @param _error_frames New value for member error_frames
+     */
+    eProsima_user_DllExport void error_frames(
+            uint32_t _error_frames)
+    {
+        m_error_frames = _error_frames;
+    }
+
+    /*!
+     * @brief This function returns the value of member error_frames
+     * @return Value of member error_frames
+     */
+    eProsima_user_DllExport uint32_t error_frames() const
+    {
+        return m_error_frames;
+    }
+
+    /*!
+     * @brief This function returns a reference to member error_frames
+     * @return Reference to member error_frames
+     */
+    eProsima_user_DllExport uint32_t& error_frames()
+    {
+        return m_error_frames;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member bus_off_count
+     * @param _bus_off_count New value for member bus_off_count
+     */
+    eProsima_user_DllExport void bus_off_count(
+            uint32_t _bus_off_count)
+    {
+        m_bus_off_count = _bus_off_count;
+    }
+
+    /*!
+     * @brief This function returns the value of member bus_off_count
+     * @return Value of member bus_off_count
+     */
+    eProsima_user_DllExport uint32_t bus_off_count() const
+    {
+        return m_bus_off_count;
+    }
+
+    /*!
+     * @brief This function returns a reference to member bus_off_count
+     * @return Reference to member bus_off_count
+     */
+    eProsima_user_DllExport uint32_t& bus_off_count()
+    {
+        return m_bus_off_count;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member reconnects
+     * @param _reconnects New value for member reconnects
+     */
+    eProsima_user_DllExport void reconnects(
+            uint32_t _reconnects)
+    {
+        m_reconnects = _reconnects;
+    }
+
+    /*!
+     * @brief This function returns the value of member reconnects
+     * @return Value of member reconnects
+     */
+    eProsima_user_DllExport uint32_t reconnects() const
+    {
+        return m_reconnects;
+    }
+
+    /*!
+     * @brief This function returns a reference to member reconnects
+     * @return Reference to member reconnects
+     */
+    eProsima_user_DllExport uint32_t& reconnects()
+    {
+        return m_reconnects;
+    }
+
+
+    /*!
+     * @brief This function copies the value in member bus
+     * @param _bus New value to be copied in member bus
+     */
+    eProsima_user_DllExport void bus(
+            const std::string& _bus)
+    {
+        m_bus = _bus;
+    }
+
+    /*!
+     * @brief This function moves the value in member bus
+     * @param _bus New value to be moved in member bus
+     */
+    eProsima_user_DllExport void bus(
+            std::string&& _bus)
+    {
+        m_bus = std::move(_bus);
+    }
+
+    /*!
+     * @brief This function returns a constant reference to member bus
+     * @return Constant reference to member bus
+     */
+    eProsima_user_DllExport const std::string& bus() const
+    {
+        return m_bus;
+    }
+
+    /*!
+     * @brief This function returns a reference to member bus
+     * @return Reference to member bus
+     */
+    eProsima_user_DllExport std::string& bus()
+    {
+        return m_bus;
+    }
+
+
+
+private:
+
+    int64_t m_timestamp{0};
+    uint8_t m_state{0};
+    uint8_t m_tx_errors{0};
+    uint8_t m_rx_errors{0};
+    uint16_t m_load_permille{0};
+    uint32_t m_frames{0};
+    uint32_t m_error_frames{0};
+    uint32_t m_bus_off_count{0};
+    uint32_t m_reconnects{0};
+    std::string m_bus;
+
+};
+
+/*!
+ * @brief This class represents the structure CanQueryRequest defined by the user in the IDL file.
+ * @ingroup LogEntry
+ */
+class CanQueryRequest
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     */
+    eProsima_user_DllExport CanQueryRequest()
+    {
+    }
+
+    /*!
+     * @brief Default destructor.
+     */
+    eProsima_user_DllExport ~CanQueryRequest()
+    {
+    }
+
+    /*!
+     * @brief Copy constructor.
+     * @param x Reference to the object CanQueryRequest that will be copied.
+     */
+    eProsima_user_DllExport CanQueryRequest(
+            const CanQueryRequest& x)
+    {
+                    m_request_id = x.m_request_id;
+
+                    m_can_id = x.m_can_id;
+
+                    m_wall_clock = x.m_wall_clock;
+
+                    m_from_us = x.m_from_us;
+
+                    m_to_us = x.m_to_us;
+
+                    m_bucket_us = x.m_bucket_us;
+
+                    m_max_results = x.m_max_results;
+
+    }
+
+    /*!
+     * @brief Move constructor.
+     * @param x Reference to the object CanQueryRequest that will be copied.
+     */
+    eProsima_user_DllExport CanQueryRequest(
+            CanQueryRequest&& x) noexcept
+    {
+        m_request_id = x.m_request_id;
+        m_can_id = x.m_can_id;
+        m_wall_clock = x.m_wall_clock;
+        m_from_us = x.m_from_us;
+        m_to_us = x.m_to_us;
+        m_bucket_us = x.m_bucket_us;
+        m_max_results = x.m_max_results;
+    }
+
+    /*!
+     * @brief Copy assignment.
+     * @param x Reference to the object CanQueryRequest that will be copied.
+     */
+    eProsima_user_DllExport CanQueryRequest& operator =(
+            const CanQueryRequest& x)
+    {
+
+                    m_request_id = x.m_request_id;
+
+                    m_can_id = x.m_can_id;
+
+                    m_wall_clock = x.m_wall_clock;
+
+                    m_from_us = x.m_from_us;
+
+                    m_to_us = x.m_to_us;
+
+                    m_bucket_us = x.m_bucket_us;
+
+                    m_max_results = x.m_max_results;
+
+        return *this;
+    }
+
+    /*!
+     * @brief Move assignment.
+     * @param x Reference to the object CanQueryRequest that will be copied.
+     */
+    eProsima_user_DllExport CanQueryRequest& operator =(
+            CanQueryRequest&& x) noexcept
+    {
+
+        m_request_id = x.m_request_id;
+        m_can_id = x.m_can_id;
+        m_wall_clock = x.m_wall_clock;
+        m_from_us = x.m_from_us;
+        m_to_us = x.m_to_us;
+        m_bucket_us = x.m_bucket_us;
+        m_max_results = x.m_max_results;
+        return *this;
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanQueryRequest object to compare.
+     */
+    eProsima_user_DllExport bool operator ==(
+            const CanQueryRequest& x) const
+    {
+        return (m_request_id == x.m_request_id &&
+           m_can_id == x.m_can_id &&
+           m_wall_clock == x.m_wall_clock &&
+           m_from_us == x.m_from_us &&
+           m_to_us == x.m_to_us &&
+           m_bucket_us == x.m_bucket_us &&
+           m_max_results == x.m_max_results);
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanQueryRequest object to compare.
+     */
+    eProsima_user_DllExport bool operator !=(
+            const CanQueryRequest& x) const
+    {
+        return !(*this == x);
+    }
+
+    /*!
+     * @brief This function sets a value in member request_id
+     * @param _request_id New value for member request_id
+     */
+    eProsima_user_DllExport void request_id(
+            uint32_t _request_id)
+    {
+        m_request_id = _request_id;
+    }
+
+    /*!
+     * @brief This function returns the value of member request_id
+     * @return Value of member request_id
+     */
+    eProsima_user_DllExport uint32_t request_id() const
+    {
+        return m_request_id;
+    }
+
+    /*!
+     * @brief This function returns a reference to member request_id
+     * @return Reference to member request_id
+     */
+    eProsima_user_DllExport uint32_t& request_id()
+    {
+        return m_request_id;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member can_id
+     * @param _can_id New value for member can_id
+     */
+    eProsima_user_DllExport void can_id(
+            uint32_t _can_id)
+    {
+        m_can_id = _can_id;
+    }
+
+    /*!
+     * @brief This function returns the value of member can_id
+     * @return Value of member can_id
+     */
+    eProsima_user_DllExport uint32_t can_id() const
+    {
+        return m_can_id;
+    }
+
+    /*!
+     * @brief This function returns a reference to member can_id
+     * @return Reference to member can_id
+     */
+    eProsima_user_DllExport uint32_t& can_id()
+    {
+        return m_can_id;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member wall_clock
+     * @param _wall_clock New value for member wall_clock
+     */
+    eProsima_user_DllExport void wall_clock(
+            bool _wall_clock)
+    {
+        m_wall_clock = _wall_clock;
+    }
+
+    /*!
+     * @brief This function returns the value of member wall_clock
+     * @return Value of member wall_clock
+     */
+    eProsima_user_DllExport bool wall_clock() const
+    {
+        return m_wall_clock;
+    }
+
+    /*!
+     * @brief This function returns a reference to member wall_clock
+     * @return Reference to member wall_clock
+     */
+    eProsima_user_DllExport bool& wall_clock()
+    {
+        return m_wall_clock;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member from_us
+     * @param _from_us New value for member from_us
+     */
+    eProsima_user_DllExport void from_us(
+            int64_t _from_us)
+    {
+        m_from_us = _from_us;
+    }
+
+    /*!
+     * @brief This function returns the value of member from_us
+     * @return Value of member from_us
+     */
+    eProsima_user_DllExport int64_t from_us() const
+    {
+        return m_from_us;
+    }
+
+    /*!
+     * @brief This function returns a reference to member from_us
+     * @return Reference to member from_us
+     */
+    eProsima_user_DllExport int64_t& from_us()
+    {
+        return m_from_us;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member to_us
+     * @param _to_us New value for member to_us
+     */
+    eProsima_user_DllExport void to_us(
+            int64_t _to_us)
+    {
+        m_to_us = _to_us;
+    }
+
+    /*!
+     * @brief This function returns the value of member to_us
+     * @return Value of member to_us
+     */
+    eProsima_user_DllExport int64_t to_us() const
+    {
+        return m_to_us;
+    }
+
+    /*!
+     * @brief This function returns a reference to member to_us
+     * @return Reference to member to_us
+     */
+    eProsima_user_DllExport int64_t& to_us()
+    {
+        return m_to_us;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member bucket_us
+     * @param _bucket_us New value for member bucket_us
+     */
+    eProsima_user_DllExport void bucket_us(
+            int64_t _bucket_us)
+    {
+        m_bucket_us = _bucket_us;
+    }
+
+    /*!
+     * @brief This function returns the value of member bucket_us
+     * @return Value of member bucket_us
+     */
+    eProsima_user_DllExport int64_t bucket_us() const
+    {
+        return m_bucket_us;
+    }
+
+    /*!
+     * @brief This function returns a reference to member bucket_us
+     * @return Reference to member bucket_us
+     */
+    eProsima_user_DllExport int64_t& bucket_us()
+    {
+        return m_bucket_us;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member max_results
+     * @param _max_results New value for member max_results
+     */
+    eProsima_user_DllExport void max_results(
+            uint32_t _max_results)
+    {
+        m_max_results = _max_results;
+    }
+
+    /*!
+     * @brief This function returns the value of member max_results
+     * @return Value of member max_results
+     */
+    eProsima_user_DllExport uint32_t max_results() const
+    {
+        return m_max_results;
+    }
+
+    /*!
+     * @brief This function returns a reference to member max_results
+     * @return Reference to member max_results
+     */
+    eProsima_user_DllExport uint32_t& max_results()
+    {
+        return m_max_results;
+    }
+
+
+
+private:
+
+    uint32_t m_request_id{0};
+    uint32_t m_can_id{0};
+    bool m_wall_clock{false};
+    int64_t m_from_us{0};
+    int64_t m_to_us{0};
+    int64_t m_bucket_us{0};
+    uint32_t m_max_results{0};
+
+};
+
+/*!
+ * @brief This class represents the structure CanQueryReply defined by the user in the IDL file.
+ * @ingroup LogEntry
+ */
+class CanQueryReply
+{
+public:
+
+    /*!
+     * @brief Default constructor.
+     */
+    eProsima_user_DllExport CanQueryReply()
+    {
+    }
+
+    /*!
+     * @brief Default destructor.
+     */
+    eProsima_user_DllExport ~CanQueryReply()
+    {
+    }
+
+    /*!
+     * @brief Copy constructor.
+     * @param x Reference to the object CanQueryReply that will be copied.
+     */
+    eProsima_user_DllExport CanQueryReply(
+            const CanQueryReply& x)
+    {
+                    m_request_id = x.m_request_id;
+
+                    m_seq = x.m_seq;
+
+                    m_status = x.m_status;
+
+                    m_last = x.m_last;
+
+                    m_can_id = x.m_can_id;
+
+                    m_timestamp = x.m_timestamp;
+
+                    m_min = x.m_min;
+
+                    m_max = x.m_max;
+
+                    m_mean = x.m_mean;
+
+                    m_count = x.m_count;
+
+    }
+
+    /*!
+     * @brief Move constructor.
+     * @param x Reference to the object CanQueryReply that will be copied.
+     */
+    eProsima_user_DllExport CanQueryReply(
+            CanQueryReply&& x) noexcept
+    {
+        m_request_id = x.m_request_id;
+        m_seq = x.m_seq;
+        m_status = x.m_status;
+        m_last = x.m_last;
+        m_can_id = x.m_can_id;
+        m_timestamp = x.m_timestamp;
+        m_min = x.m_min;
+        m_max = x.m_max;
+        m_mean = x.m_mean;
+        m_count = x.m_count;
+    }
+
+    /*!
+     * @brief Copy assignment.
+     * @param x Reference to the object CanQueryReply that will be copied.
+     */
+    eProsima_user_DllExport CanQueryReply& operator =(
+            const CanQueryReply& x)
+    {
+
+                    m_request_id = x.m_request_id;
+
+                    m_seq = x.m_seq;
+
+                    m_status = x.m_status;
+
+                    m_last = x.m_last;
+
+                    m_can_id = x.m_can_id;
+
+                    m_timestamp = x.m_timestamp;
+
+                    m_min = x.m_min;
+
+                    m_max = x.m_max;
+
+                    m_mean = x.m_mean;
+
+                    m_count = x.m_count;
+
+        return *this;
+    }
+
+    /*!
+     * @brief Move assignment.
+     * @param x Reference to the object CanQueryReply that will be copied.
+     */
+    eProsima_user_DllExport CanQueryReply& operator =(
+            CanQueryReply&& x) noexcept
+    {
+
+        m_request_id = x.m_request_id;
+        m_seq = x.m_seq;
+        m_status = x.m_status;
+        m_last = x.m_last;
+        m_can_id = x.m_can_id;
+        m_timestamp = x.m_timestamp;
+        m_min = x.m_min;
+        m_max = x.m_max;
+        m_mean = x.m_mean;
+        m_count = x.m_count;
+        return *this;
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanQueryReply object to compare.
+     */
+    eProsima_user_DllExport bool operator ==(
+            const CanQueryReply& x) const
+    {
+        return (m_request_id == x.m_request_id &&
+           m_seq == x.m_seq &&
+           m_status == x.m_status &&
+           m_last == x.m_last &&
+           m_can_id == x.m_can_id &&
+           m_timestamp == x.m_timestamp &&
+           m_min == x.m_min &&
+           m_max == x.m_max &&
+           m_mean == x.m_mean &&
+           m_count == x.m_count);
+    }
+
+    /*!
+     * @brief Comparison operator.
+     * @param x CanQueryReply object to compare.
+     */
+    eProsima_user_DllExport bool operator !=(
+            const CanQueryReply& x) const
+    {
+        return !(*this == x);
+    }
+
+    /*!
+     * @brief This function sets a value in member request_id
+     * @param _request_id New value for member request_id
+     */
+    eProsima_user_DllExport void request_id(
+            uint32_t _request_id)
+    {
+        m_request_id = _request_id;
+    }
+
+    /*!
+     * @brief This function returns the value of member request_id
+     * @return Value of member request_id
+     */
+    eProsima_user_DllExport uint32_t request_id() const
+    {
+        return m_request_id;
+    }
+
+    /*!
+     * @brief This function returns a reference to member request_id
+     * @return Reference to member request_id
+     */
+    eProsima_user_DllExport uint32_t& request_id()
+    {
+        return m_request_id;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member seq
+     * @param _seq New value for member seq
+     */
+    eProsima_user_DllExport void seq(
+            uint32_t _seq)
+    {
+        m_seq = _seq;
+    }
+
+    /*!
+     * @brief This function returns the value of member seq
+     * @return Value of member seq
+     */
+    eProsima_user_DllExport uint32_t seq() const
+    {
+        return m_seq;
+    }
+
+    /*!
+     * @brief This function returns a reference to member seq
+     * @return Reference to member seq
+     */
+    eProsima_user_DllExport uint32_t& seq()
+    {
+        return m_seq;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member status
+     * @param _status New value for member status
+     */
+    eProsima_user_DllExport void status(
+            uint8_t _status)
+    {
+        m_status = _status;
+    }
+
+    /*!
+     * @brief This function returns the value of member status
+     * @return Value of member status
+     */
+    eProsima_user_DllExport uint8_t status() const
+    {
+        return m_status;
+    }
+
+    /*!
+     * @brief This function returns a reference to member status
+     * @return Reference to member status
+     */
+    eProsima_user_DllExport uint8_t& status()
+    {
+        return m_status;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member last
+     * @param _last New value for member last
+     */
+    eProsima_user_DllExport void last(
+            bool _last)
+    {
+        m_last = _last;
+    }
+
+    /*!
+     * @brief This function returns the value of member last
+     * @return Value of member last
+     */
+    eProsima_user_DllExport bool last() const
+    {
+        return m_last;
+    }
+
+    /*!
+     * @brief This function returns a reference to member last
+     * @return Reference to member last
+     */
+    eProsima_user_DllExport bool& last()
+    {
+        return m_last;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member can_id
+     * @param _can_id New value for member can_id
+     */
+    eProsima_user_DllExport void can_id(
+            uint32_t _can_id)
+    {
+        m_can_id = _can_id;
+    }
+
+    /*!
+     * @brief This function returns the value of member can_id
+     * @return Value of member can_id
+     */
+    eProsima_user_DllExport uint32_t can_id() const
+    {
+        return m_can_id;
+    }
+
+    /*!
+     * @brief This function returns a reference to member can_id
+     * @return Reference to member can_id
+     */
+    eProsima_user_DllExport uint32_t& can_id()
+    {
+        return m_can_id;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member timestamp
+     * @param _timestamp New value for member timestamp
+     */
+    eProsima_user_DllExport void timestamp(
+            int64_t _timestamp)
+    {
+        m_timestamp = _timestamp;
+    }
+
+    /*!
+     * @brief This function returns the value of member timestamp
+     * @return Value of member timestamp
+     */
+    eProsima_user_DllExport int64_t timestamp() const
+    {
+        return m_timestamp;
+    }
+
+    /*!
+     * @brief This function returns a reference to member timestamp
+     * @return Reference to member timestamp
+     */
+    eProsima_user_DllExport int64_t& timestamp()
+    {
+        return m_timestamp;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member min
+     * @param _min New value for member min
+     */
+    eProsima_user_DllExport void min(
+            int32_t _min)
+    {
+        m_min = _min;
+    }
+
+    /*!
+     * @brief This function returns the value of member min
+     * @return Value of member min
+     */
+    eProsima_user_DllExport int32_t min() const
+    {
+        return m_min;
+    }
+
+    /*!
+     * @brief This function returns a reference to member min
+     * @return Reference to member min
+     */
+    eProsima_user_DllExport int32_t& min()
+    {
+        return m_min;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member max
+     * @param _max New value for member max
+     */
+    eProsima_user_DllExport void max(
+            int32_t _max)
+    {
+        m_max = _max;
+    }
+
+    /*!
+     * @brief This function returns the value of member max
+     * @return Value of member max
+     */
+    eProsima_user_DllExport int32_t max() const
+    {
+        return m_max;
+    }
+
+    /*!
+     * @brief This function returns a reference to member max
+     * @return Reference to member max
+     */
+    eProsima_user_DllExport int32_t& max()
+    {
+        return m_max;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member mean
+     * @param _mean New value for member mean
+     */
+    eProsima_user_DllExport void mean(
+            double _mean)
+    {
+        m_mean = _mean;
+    }
+
+    /*!
+     * @brief This function returns the value of member mean
+     * @return Value of member mean
+     */
+    eProsima_user_DllExport double mean() const
+    {
+        return m_mean;
+    }
+
+    /*!
+     * @brief This function returns a reference to member mean
+     * @return Reference to member mean
+     */
+    eProsima_user_DllExport double& mean()
+    {
+        return m_mean;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member count
+     * @param _count New value for member count
+     */
+    eProsima_user_DllExport void count(
+            uint32_t _count)
+    {
+        m_count = _count;
+    }
+
+    /*!
+     * @brief This function returns the value of member count
+     * @return Value of member count
+     */
+    eProsima_user_DllExport uint32_t count() const
+    {
+        return m_count;
+    }
+
+    /*!
+     * @brief This function returns a reference to member count
+     * @return Reference to member count
+     */
+    eProsima_user_DllExport uint32_t& count()
+    {
+        return m_count;
+    }
+
+
+
+private:
+
+    uint32_t m_request_id{0};
+    uint32_t m_seq{0};
+    uint8_t m_status{0};
+    bool m_last{false};
+    uint32_t m_can_id{0};
+    int64_t m_timestamp{0};
+    int32_t m_min{0};
+    int32_t m_max{0};
+    double m_mean{0.0};
+    uint32_t m_count{0};
+
+};
+
 #endif // _FAST_DDS_GENERATED_LOGENTRY_HPP_
 
 
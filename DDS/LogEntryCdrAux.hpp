@@ -25,7 +25,25 @@
 #include "LogEntry.hpp"
 
 constexpr uint32_t CanLogEntry_max_cdr_typesize {24UL};
-constexpr uint32_t CanLogEntry_max_key_cdr_typesize {0UL};
+constexpr uint32_t CanLogEntry_max_key_cdr_typesize {4UL};
+
+constexpr uint32_t CanClockAnchor_max_cdr_typesize {20UL};
+constexpr uint32_t CanClockAnchor_max_key_cdr_typesize {0UL};
+
+constexpr uint32_t CanAlarm_max_cdr_typesize {284UL};
+constexpr uint32_t CanAlarm_max_key_cdr_typesize {0UL};
+
+constexpr uint32_t CanRollup_max_cdr_typesize {40UL};
+constexpr uint32_t CanRollup_max_key_cdr_typesize {0UL};
+
+constexpr uint32_t CanBusHealth_max_cdr_typesize {296UL};
+constexpr uint32_t CanBusHealth_max_key_cdr_typesize {0UL};
+
+constexpr uint32_t CanQueryRequest_max_cdr_typesize {44UL};
+constexpr uint32_t CanQueryRequest_max_key_cdr_typesize {0UL};
+
+constexpr uint32_t CanQueryReply_max_cdr_typesize {48UL};
+constexpr uint32_t CanQueryReply_max_key_cdr_typesize {0UL};
 
 
 namespace eprosima {
@@ -38,6 +56,30 @@ eProsima_user_DllExport void serialize_key(
         eprosima::fastcdr::Cdr& scdr,
         const CanLogEntry& data);
 
+eProsima_user_DllExport void serialize_key(
+        eprosima::fastcdr::Cdr& scdr,
+        const CanClockAnchor& data);
+
+eProsima_user_DllExport void serialize_key(
+        eprosima::fastcdr::Cdr& scdr,
+        const CanAlarm& data);
+
+eProsima_user_DllExport void serialize_key(
+        eprosima::fastcdr::Cdr& scdr,
+        const CanRollup& data);
+
+eProsima_user_DllExport void serialize_key(
+        eprosima::fastcdr::Cdr& scdr,
+        const CanBusHealth& data);
+
+eProsima_user_DllExport void serialize_key(
+        eprosima::fastcdr::Cdr& scdr,
+        const CanQueryRequest& data);
+
+eProsima_user_DllExport void serialize_key(
+        eprosima::fastcdr::Cdr& scdr,
+        const CanQueryReply& data);
+
 
 } // namespace fastcdr
 } // namespace eprosima
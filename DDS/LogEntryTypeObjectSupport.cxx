@@ -93,7 +93,7 @@ void register_CanLogEntry_type_identifier(
             ReturnCode_t return_code_can_id {eprosima::fastdds::dds::RETCODE_OK};
             return_code_can_id =
                 eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
-                "_byte", type_ids_can_id);
+                "_uint32_t", type_ids_can_id);
 
             if (eprosima::fastdds::dds::RETCODE_OK != return_code_can_id)
             {
@@ -102,7 +102,7 @@ void register_CanLogEntry_type_identifier(
                 return;
             }
             StructMemberFlag member_flags_can_id = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
-                    false, false, false, false);
+                    false, true, true, false);
             MemberId member_id_can_id = 0x00000001;
             bool common_can_id_ec {false};
             CommonStructMember common_can_id {TypeObjectUtils::build_common_struct_member(member_id_can_id, member_flags_can_id, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_can_id, common_can_id_ec))};
@@ -187,4 +187,1442 @@ void register_CanLogEntry_type_identifier(
         }
     }
 }
+// TypeIdentifier is returned by reference: dependent structures/unions are registered in this same method
+void register_CanClockAnchor_type_identifier(
+        TypeIdentifierPair& type_ids_CanClockAnchor)
+{
+
+    ReturnCode_t return_code_CanClockAnchor {eprosima::fastdds::dds::RETCODE_OK};
+    return_code_CanClockAnchor =
+        eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+        "CanClockAnchor", type_ids_CanClockAnchor);
+    if (eprosima::fastdds::dds::RETCODE_OK != return_code_CanClockAnchor)
+    {
+        StructTypeFlag struct_flags_CanClockAnchor = TypeObjectUtils::build_struct_type_flag(eprosima::fastdds::dds::xtypes::ExtensibilityKind::APPENDABLE,
+                false, false);
+        QualifiedTypeName type_name_CanClockAnchor = "CanClockAnchor";
+        eprosima::fastcdr::optional<AppliedBuiltinTypeAnnotations> type_ann_builtin_CanClockAnchor;
+        eprosima::fastcdr::optional<AppliedAnnotationSeq> ann_custom_CanClockAnchor;
+        CompleteTypeDetail detail_CanClockAnchor = TypeObjectUtils::build_complete_type_detail(type_ann_builtin_CanClockAnchor, ann_custom_CanClockAnchor, type_name_CanClockAnchor.to_string());
+        CompleteStructHeader header_CanClockAnchor;
+        header_CanClockAnchor = TypeObjectUtils::build_complete_struct_header(TypeIdentifier(), detail_CanClockAnchor);
+        CompleteStructMemberSeq member_seq_CanClockAnchor;
+        {
+            TypeIdentifierPair type_ids_monotonic_us;
+            ReturnCode_t return_code_monotonic_us {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_monotonic_us =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int64_t", type_ids_monotonic_us);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_monotonic_us)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "monotonic_us Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_monotonic_us = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_monotonic_us = 0x00000000;
+            bool common_monotonic_us_ec {false};
+            CommonStructMember common_monotonic_us {TypeObjectUtils::build_common_struct_member(member_id_monotonic_us, member_flags_monotonic_us, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_monotonic_us, common_monotonic_us_ec))};
+            if (!common_monotonic_us_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure monotonic_us member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_monotonic_us = "monotonic_us";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_monotonic_us;
+            ann_custom_CanClockAnchor.reset();
+            CompleteMemberDetail detail_monotonic_us = TypeObjectUtils::build_complete_member_detail(name_monotonic_us, member_ann_builtin_monotonic_us, ann_custom_CanClockAnchor);
+            CompleteStructMember member_monotonic_us = TypeObjectUtils::build_complete_struct_member(common_monotonic_us, detail_monotonic_us);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanClockAnchor, member_monotonic_us);
+        }
+        {
+            TypeIdentifierPair type_ids_realtime_us;
+            ReturnCode_t return_code_realtime_us {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_realtime_us =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int64_t", type_ids_realtime_us);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_realtime_us)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "realtime_us Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_realtime_us = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_realtime_us = 0x00000001;
+            bool common_realtime_us_ec {false};
+            CommonStructMember common_realtime_us {TypeObjectUtils::build_common_struct_member(member_id_realtime_us, member_flags_realtime_us, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_realtime_us, common_realtime_us_ec))};
+            if (!common_realtime_us_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure realtime_us member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_realtime_us = "realtime_us";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_realtime_us;
+            ann_custom_CanClockAnchor.reset();
+            CompleteMemberDetail detail_realtime_us = TypeObjectUtils::build_complete_member_detail(name_realtime_us, member_ann_builtin_realtime_us, ann_custom_CanClockAnchor);
+            CompleteStructMember member_realtime_us = TypeObjectUtils::build_complete_struct_member(common_realtime_us, detail_realtime_us);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanClockAnchor, member_realtime_us);
+        }
+        CompleteStructType struct_type_CanClockAnchor = TypeObjectUtils::build_complete_struct_type(struct_flags_CanClockAnchor, header_CanClockAnchor, member_seq_CanClockAnchor);
+        if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
+                TypeObjectUtils::build_and_register_struct_type_object(struct_type_CanClockAnchor, type_name_CanClockAnchor.to_string(), type_ids_CanClockAnchor))
+        {
+            EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                    "CanClockAnchor already registered in TypeObjectRegistry for a different type.");
+        }
+    }
+}
+// TypeIdentifier is returned by reference: dependent structures/unions are registered in this same method
+void register_CanAlarm_type_identifier(
+        TypeIdentifierPair& type_ids_CanAlarm)
+{
+
+    ReturnCode_t return_code_CanAlarm {eprosima::fastdds::dds::RETCODE_OK};
+    return_code_CanAlarm =
+        eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+        "CanAlarm", type_ids_CanAlarm);
+    if (eprosima::fastdds::dds::RETCODE_OK != return_code_CanAlarm)
+    {
+        StructTypeFlag struct_flags_CanAlarm = TypeObjectUtils::build_struct_type_flag(eprosima::fastdds::dds::xtypes::ExtensibilityKind::APPENDABLE,
+                false, false);
+        QualifiedTypeName type_name_CanAlarm = "CanAlarm";
+        eprosima::fastcdr::optional<AppliedBuiltinTypeAnnotations> type_ann_builtin_CanAlarm;
+        eprosima::fastcdr::optional<AppliedAnnotationSeq> ann_custom_CanAlarm;
+        CompleteTypeDetail detail_CanAlarm = TypeObjectUtils::build_complete_type_detail(type_ann_builtin_CanAlarm, ann_custom_CanAlarm, type_name_CanAlarm.to_string());
+        CompleteStructHeader header_CanAlarm;
+        header_CanAlarm = TypeObjectUtils::build_complete_struct_header(TypeIdentifier(), detail_CanAlarm);
+        CompleteStructMemberSeq member_seq_CanAlarm;
+        {
+            TypeIdentifierPair type_ids_name;
+            ReturnCode_t return_code_name {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_name =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "anonymous_string_unbounded", type_ids_name);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_name)
+            {
+                {
+                    SBound bound = 0;
+                    StringSTypeDefn string_sdefn = TypeObjectUtils::build_string_s_type_defn(bound);
+                    if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
+                            TypeObjectUtils::build_and_register_s_string_type_identifier(string_sdefn,
+                            "anonymous_string_unbounded", type_ids_name))
+                    {
+                        EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                            "anonymous_string_unbounded already registered in TypeObjectRegistry for a different type.");
+                    }
+                }
+                return_code_name =
+                    eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                    "anonymous_string_unbounded", type_ids_name);
+                if (eprosima::fastdds::dds::RETCODE_OK != return_code_name)
+                {
+                    EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                                "anonymous_string_unbounded: Given String TypeIdentifier unknown to TypeObjectRegistry.");
+                    return;
+                }
+            }
+            StructMemberFlag member_flags_name = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_name = 0x00000000;
+            bool common_name_ec {false};
+            CommonStructMember common_name {TypeObjectUtils::build_common_struct_member(member_id_name, member_flags_name, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_name, common_name_ec))};
+            if (!common_name_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure name member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_name = "name";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_name;
+            ann_custom_CanAlarm.reset();
+            CompleteMemberDetail detail_name = TypeObjectUtils::build_complete_member_detail(name_name, member_ann_builtin_name, ann_custom_CanAlarm);
+            CompleteStructMember member_name = TypeObjectUtils::build_complete_struct_member(common_name, detail_name);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanAlarm, member_name);
+        }
+        {
+            TypeIdentifierPair type_ids_active;
+            ReturnCode_t return_code_active {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_active =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_bool", type_ids_active);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_active)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "active Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_active = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_active = 0x00000001;
+            bool common_active_ec {false};
+            CommonStructMember common_active {TypeObjectUtils::build_common_struct_member(member_id_active, member_flags_active, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_active, common_active_ec))};
+            if (!common_active_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure active member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_active = "active";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_active;
+            ann_custom_CanAlarm.reset();
+            CompleteMemberDetail detail_active = TypeObjectUtils::build_complete_member_detail(name_active, member_ann_builtin_active, ann_custom_CanAlarm);
+            CompleteStructMember member_active = TypeObjectUtils::build_complete_struct_member(common_active, detail_active);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanAlarm, member_active);
+        }
+        {
+            TypeIdentifierPair type_ids_can_id;
+            ReturnCode_t return_code_can_id {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_can_id =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_can_id);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_can_id)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "can_id Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_can_id = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_can_id = 0x00000002;
+            bool common_can_id_ec {false};
+            CommonStructMember common_can_id {TypeObjectUtils::build_common_struct_member(member_id_can_id, member_flags_can_id, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_can_id, common_can_id_ec))};
+            if (!common_can_id_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure can_id member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_can_id = "can_id";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_can_id;
+            ann_custom_CanAlarm.reset();
+            CompleteMemberDetail detail_can_id = TypeObjectUtils::build_complete_member_detail(name_can_id, member_ann_builtin_can_id, ann_custom_CanAlarm);
+            CompleteStructMember member_can_id = TypeObjectUtils::build_complete_struct_member(common_can_id, detail_can_id);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanAlarm, member_can_id);
+        }
+        {
+            TypeIdentifierPair type_ids_value;
+            ReturnCode_t return_code_value {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_value =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int32_t", type_ids_value);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_value)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "value Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_value = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_value = 0x00000003;
+            bool common_value_ec {false};
+            CommonStructMember common_value {TypeObjectUtils::build_common_struct_member(member_id_value, member_flags_value, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_value, common_value_ec))};
+            if (!common_value_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure value member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_value = "value";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_value;
+            ann_custom_CanAlarm.reset();
+            CompleteMemberDetail detail_value = TypeObjectUtils::build_complete_member_detail(name_value, member_ann_builtin_value, ann_custom_CanAlarm);
+            CompleteStructMember member_value = TypeObjectUtils::build_complete_struct_member(common_value, detail_value);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanAlarm, member_value);
+        }
+        {
+            TypeIdentifierPair type_ids_timestamp;
+            ReturnCode_t return_code_timestamp {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_timestamp =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int64_t", type_ids_timestamp);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_timestamp)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "timestamp Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_timestamp = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_timestamp = 0x00000004;
+            bool common_timestamp_ec {false};
+            CommonStructMember common_timestamp {TypeObjectUtils::build_common_struct_member(member_id_timestamp, member_flags_timestamp, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_timestamp, common_timestamp_ec))};
+            if (!common_timestamp_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure timestamp member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_timestamp = "timestamp";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_timestamp;
+            ann_custom_CanAlarm.reset();
+            CompleteMemberDetail detail_timestamp = TypeObjectUtils::build_complete_member_detail(name_timestamp, member_ann_builtin_timestamp, ann_custom_CanAlarm);
+            CompleteStructMember member_timestamp = TypeObjectUtils::build_complete_struct_member(common_timestamp, detail_timestamp);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanAlarm, member_timestamp);
+        }
+        CompleteStructType struct_type_CanAlarm = TypeObjectUtils::build_complete_struct_type(struct_flags_CanAlarm, header_CanAlarm, member_seq_CanAlarm);
+        if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
+                TypeObjectUtils::build_and_register_struct_type_object(struct_type_CanAlarm, type_name_CanAlarm.to_string(), type_ids_CanAlarm))
+        {
+            EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                    "CanAlarm already registered in TypeObjectRegistry for a different type.");
+        }
+    }
+}
+// TypeIdentifier is returned by reference: dependent structures/unions are registered in this same method
+void register_CanRollup_type_identifier(
+        TypeIdentifierPair& type_ids_CanRollup)
+{
+
+    ReturnCode_t return_code_CanRollup {eprosima::fastdds::dds::RETCODE_OK};
+    return_code_CanRollup =
+        eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+        "CanRollup", type_ids_CanRollup);
+    if (eprosima::fastdds::dds::RETCODE_OK != return_code_CanRollup)
+    {
+        StructTypeFlag struct_flags_CanRollup = TypeObjectUtils::build_struct_type_flag(eprosima::fastdds::dds::xtypes::ExtensibilityKind::APPENDABLE,
+                false, false);
+        QualifiedTypeName type_name_CanRollup = "CanRollup";
+        eprosima::fastcdr::optional<AppliedBuiltinTypeAnnotations> type_ann_builtin_CanRollup;
+        eprosima::fastcdr::optional<AppliedAnnotationSeq> ann_custom_CanRollup;
+        CompleteTypeDetail detail_CanRollup = TypeObjectUtils::build_complete_type_detail(type_ann_builtin_CanRollup, ann_custom_CanRollup, type_name_CanRollup.to_string());
+        CompleteStructHeader header_CanRollup;
+        header_CanRollup = TypeObjectUtils::build_complete_struct_header(TypeIdentifier(), detail_CanRollup);
+        CompleteStructMemberSeq member_seq_CanRollup;
+        {
+            TypeIdentifierPair type_ids_resolution_s;
+            ReturnCode_t return_code_resolution_s {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_resolution_s =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_resolution_s);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_resolution_s)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "resolution_s Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_resolution_s = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_resolution_s = 0x00000000;
+            bool common_resolution_s_ec {false};
+            CommonStructMember common_resolution_s {TypeObjectUtils::build_common_struct_member(member_id_resolution_s, member_flags_resolution_s, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_resolution_s, common_resolution_s_ec))};
+            if (!common_resolution_s_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure resolution_s member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_resolution_s = "resolution_s";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_resolution_s;
+            ann_custom_CanRollup.reset();
+            CompleteMemberDetail detail_resolution_s = TypeObjectUtils::build_complete_member_detail(name_resolution_s, member_ann_builtin_resolution_s, ann_custom_CanRollup);
+            CompleteStructMember member_resolution_s = TypeObjectUtils::build_complete_struct_member(common_resolution_s, detail_resolution_s);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanRollup, member_resolution_s);
+        }
+        {
+            TypeIdentifierPair type_ids_can_id;
+            ReturnCode_t return_code_can_id {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_can_id =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_can_id);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_can_id)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "can_id Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_can_id = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_can_id = 0x00000001;
+            bool common_can_id_ec {false};
+            CommonStructMember common_can_id {TypeObjectUtils::build_common_struct_member(member_id_can_id, member_flags_can_id, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_can_id, common_can_id_ec))};
+            if (!common_can_id_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure can_id member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_can_id = "can_id";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_can_id;
+            ann_custom_CanRollup.reset();
+            CompleteMemberDetail detail_can_id = TypeObjectUtils::build_complete_member_detail(name_can_id, member_ann_builtin_can_id, ann_custom_CanRollup);
+            CompleteStructMember member_can_id = TypeObjectUtils::build_complete_struct_member(common_can_id, detail_can_id);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanRollup, member_can_id);
+        }
+        {
+            TypeIdentifierPair type_ids_bucket_start;
+            ReturnCode_t return_code_bucket_start {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_bucket_start =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int64_t", type_ids_bucket_start);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_bucket_start)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "bucket_start Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_bucket_start = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_bucket_start = 0x00000002;
+            bool common_bucket_start_ec {false};
+            CommonStructMember common_bucket_start {TypeObjectUtils::build_common_struct_member(member_id_bucket_start, member_flags_bucket_start, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_bucket_start, common_bucket_start_ec))};
+            if (!common_bucket_start_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure bucket_start member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_bucket_start = "bucket_start";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_bucket_start;
+            ann_custom_CanRollup.reset();
+            CompleteMemberDetail detail_bucket_start = TypeObjectUtils::build_complete_member_detail(name_bucket_start, member_ann_builtin_bucket_start, ann_custom_CanRollup);
+            CompleteStructMember member_bucket_start = TypeObjectUtils::build_complete_struct_member(common_bucket_start, detail_bucket_start);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanRollup, member_bucket_start);
+        }
+        {
+            TypeIdentifierPair type_ids_min;
+            ReturnCode_t return_code_min {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_min =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int32_t", type_ids_min);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_min)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "min Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_min = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_min = 0x00000003;
+            bool common_min_ec {false};
+            CommonStructMember common_min {TypeObjectUtils::build_common_struct_member(member_id_min, member_flags_min, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_min, common_min_ec))};
+            if (!common_min_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure min member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_min = "min";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_min;
+            ann_custom_CanRollup.reset();
+            CompleteMemberDetail detail_min = TypeObjectUtils::build_complete_member_detail(name_min, member_ann_builtin_min, ann_custom_CanRollup);
+            CompleteStructMember member_min = TypeObjectUtils::build_complete_struct_member(common_min, detail_min);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanRollup, member_min);
+        }
+        {
+            TypeIdentifierPair type_ids_max;
+            ReturnCode_t return_code_max {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_max =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int32_t", type_ids_max);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_max)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "max Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_max = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_max = 0x00000004;
+            bool common_max_ec {false};
+            CommonStructMember common_max {TypeObjectUtils::build_common_struct_member(member_id_max, member_flags_max, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_max, common_max_ec))};
+            if (!common_max_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure max member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_max = "max";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_max;
+            ann_custom_CanRollup.reset();
+            CompleteMemberDetail detail_max = TypeObjectUtils::build_complete_member_detail(name_max, member_ann_builtin_max, ann_custom_CanRollup);
+            CompleteStructMember member_max = TypeObjectUtils::build_complete_struct_member(common_max, detail_max);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanRollup, member_max);
+        }
+        {
+            TypeIdentifierPair type_ids_mean;
+            ReturnCode_t return_code_mean {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_mean =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_float64", type_ids_mean);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_mean)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "mean Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_mean = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_mean = 0x00000005;
+            bool common_mean_ec {false};
+            CommonStructMember common_mean {TypeObjectUtils::build_common_struct_member(member_id_mean, member_flags_mean, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_mean, common_mean_ec))};
+            if (!common_mean_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure mean member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_mean = "mean";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_mean;
+            ann_custom_CanRollup.reset();
+            CompleteMemberDetail detail_mean = TypeObjectUtils::build_complete_member_detail(name_mean, member_ann_builtin_mean, ann_custom_CanRollup);
+            CompleteStructMember member_mean = TypeObjectUtils::build_complete_struct_member(common_mean, detail_mean);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanRollup, member_mean);
+        }
+        {
+            TypeIdentifierPair type_ids_count;
+            ReturnCode_t return_code_count {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_count =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_count);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_count)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "count Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_count = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_count = 0x00000006;
+            bool common_count_ec {false};
+            CommonStructMember common_count {TypeObjectUtils::build_common_struct_member(member_id_count, member_flags_count, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_count, common_count_ec))};
+            if (!common_count_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure count member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_count = "count";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_count;
+            ann_custom_CanRollup.reset();
+            CompleteMemberDetail detail_count = TypeObjectUtils::build_complete_member_detail(name_count, member_ann_builtin_count, ann_custom_CanRollup);
+            CompleteStructMember member_count = TypeObjectUtils::build_complete_struct_member(common_count, detail_count);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanRollup, member_count);
+        }
+        CompleteStructType struct_type_CanRollup = TypeObjectUtils::build_complete_struct_type(struct_flags_CanRollup, header_CanRollup, member_seq_CanRollup);
+        if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
+                TypeObjectUtils::build_and_register_struct_type_object(struct_type_CanRollup, type_name_CanRollup.to_string(), type_ids_CanRollup))
+        {
+            EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                    "CanRollup already registered in TypeObjectRegistry for a different type.");
+        }
+    }
+}
+// TypeIdentifier is returned by reference: dependent structures/unions are registered in this same method
+void register_CanBusHealth_type_identifier(
+        TypeIdentifierPair& type_ids_CanBusHealth)
+{
+
+    ReturnCode_t return_code_CanBusHealth {eprosima::fastdds::dds::RETCODE_OK};
+    return_code_CanBusHealth =
+        eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+        "CanBusHealth", type_ids_CanBusHealth);
+    if (eprosima::fastdds::dds::RETCODE_OK != return_code_CanBusHealth)
+    {
+        StructTypeFlag struct_flags_CanBusHealth = TypeObjectUtils::build_struct_type_flag(eprosima::fastdds::dds::xtypes::ExtensibilityKind::APPENDABLE,
+                false, false);
+        QualifiedTypeName type_name_CanBusHealth = "CanBusHealth";
+        eprosima::fastcdr::optional<AppliedBuiltinTypeAnnotations> type_ann_builtin_CanBusHealth;
+        eprosima::fastcdr::optional<AppliedAnnotationSeq> ann_custom_CanBusHealth;
+        CompleteTypeDetail detail_CanBusHealth = TypeObjectUtils::build_complete_type_detail(type_ann_builtin_CanBusHealth, ann_custom_CanBusHealth, type_name_CanBusHealth.to_string());
+        CompleteStructHeader header_CanBusHealth;
+        header_CanBusHealth = TypeObjectUtils::build_complete_struct_header(TypeIdentifier(), detail_CanBusHealth);
+        CompleteStructMemberSeq member_seq_CanBusHealth;
+        {
+            TypeIdentifierPair type_ids_timestamp;
+            ReturnCode_t return_code_timestamp {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_timestamp =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int64_t", type_ids_timestamp);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_timestamp)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "timestamp Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_timestamp = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_timestamp = 0x00000000;
+            bool common_timestamp_ec {false};
+            CommonStructMember common_timestamp {TypeObjectUtils::build_common_struct_member(member_id_timestamp, member_flags_timestamp, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_timestamp, common_timestamp_ec))};
+            if (!common_timestamp_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure timestamp member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_timestamp = "timestamp";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_timestamp;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_timestamp = TypeObjectUtils::build_complete_member_detail(name_timestamp, member_ann_builtin_timestamp, ann_custom_CanBusHealth);
+            CompleteStructMember member_timestamp = TypeObjectUtils::build_complete_struct_member(common_timestamp, detail_timestamp);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_timestamp);
+        }
+        {
+            TypeIdentifierPair type_ids_state;
+            ReturnCode_t return_code_state {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_state =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_byte", type_ids_state);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_state)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "state Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_state = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_state = 0x00000001;
+            bool common_state_ec {false};
+            CommonStructMember common_state {TypeObjectUtils::build_common_struct_member(member_id_state, member_flags_state, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_state, common_state_ec))};
+            if (!common_state_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure state member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_state = "state";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_state;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_state = TypeObjectUtils::build_complete_member_detail(name_state, member_ann_builtin_state, ann_custom_CanBusHealth);
+            CompleteStructMember member_state = TypeObjectUtils::build_complete_struct_member(common_state, detail_state);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_state);
+        }
+        {
+            TypeIdentifierPair type_ids_tx_errors;
+            ReturnCode_t return_code_tx_errors {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_tx_errors =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_byte", type_ids_tx_errors);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_tx_errors)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "tx_errors Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_tx_errors = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_tx_errors = 0x00000002;
+            bool common_tx_errors_ec {false};
+            CommonStructMember common_tx_errors {TypeObjectUtils::build_common_struct_member(member_id_tx_errors, member_flags_tx_errors, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_tx_errors, common_tx_errors_ec))};
+            if (!common_tx_errors_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure tx_errors member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_tx_errors = "tx_errors";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_tx_errors;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_tx_errors = TypeObjectUtils::build_complete_member_detail(name_tx_errors, member_ann_builtin_tx_errors, ann_custom_CanBusHealth);
+            CompleteStructMember member_tx_errors = TypeObjectUtils::build_complete_struct_member(common_tx_errors, detail_tx_errors);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_tx_errors);
+        }
+        {
+            TypeIdentifierPair type_ids_rx_errors;
+            ReturnCode_t return_code_rx_errors {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_rx_errors =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_byte", type_ids_rx_errors);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_rx_errors)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "rx_errors Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_rx_errors = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_rx_errors = 0x00000003;
+            bool common_rx_errors_ec {false};
+            CommonStructMember common_rx_errors {TypeObjectUtils::build_common_struct_member(member_id_rx_errors, member_flags_rx_errors, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_rx_errors, common_rx_errors_ec))};
+            if (!common_rx_errors_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure rx_errors member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_rx_errors = "rx_errors";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_rx_errors;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_rx_errors = TypeObjectUtils::build_complete_member_detail(name_rx_errors, member_ann_builtin_rx_errors, ann_custom_CanBusHealth);
+            CompleteStructMember member_rx_errors = TypeObjectUtils::build_complete_struct_member(common_rx_errors, detail_rx_errors);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_rx_errors);
+        }
+        {
+            TypeIdentifierPair type_ids_load_permille;
+            ReturnCode_t return_code_load_permille {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_load_permille =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint16_t", type_ids_load_permille);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_load_permille)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "load_permille Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_load_permille = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_load_permille = 0x00000004;
+            bool common_load_permille_ec {false};
+            CommonStructMember common_load_permille {TypeObjectUtils::build_common_struct_member(member_id_load_permille, member_flags_load_permille, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_load_permille, common_load_permille_ec))};
+            if (!common_load_permille_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure load_permille member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_load_permille = "load_permille";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_load_permille;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_load_permille = TypeObjectUtils::build_complete_member_detail(name_load_permille, member_ann_builtin_load_permille, ann_custom_CanBusHealth);
+            CompleteStructMember member_load_permille = TypeObjectUtils::build_complete_struct_member(common_load_permille, detail_load_permille);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_load_permille);
+        }
+        {
+            TypeIdentifierPair type_ids_frames;
+            ReturnCode_t return_code_frames {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_frames =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_frames);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_frames)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "frames Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_frames = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_frames = 0x00000005;
+            bool common_frames_ec {false};
+            CommonStructMember common_frames {TypeObjectUtils::build_common_struct_member(member_id_frames, member_flags_frames, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_frames, common_frames_ec))};
+            if (!common_frames_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure frames member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_frames = "frames";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_frames;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_frames = TypeObjectUtils::build_complete_member_detail(name_frames, member_ann_builtin_frames, ann_custom_CanBusHealth);
+            CompleteStructMember member_frames = TypeObjectUtils::build_complete_struct_member(common_frames, detail_frames);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_frames);
+        }
+        {
+            TypeIdentifierPair type_ids_error_frames;
+            ReturnCode_t return_code_error_frames {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_error_frames =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_error_frames);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_error_frames)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "error_frames Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_error_frames = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_error_frames = 0x00000006;
+            bool common_error_frames_ec {false};
+            CommonStructMember common_error_frames {TypeObjectUtils::build_common_struct_member(member_id_error_frames, member_flags_error_frames, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_error_frames, common_error_frames_ec))};
+            if (!common_error_frames_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure error_frames member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_error_frames = "error_frames";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_error_frames;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_error_frames = TypeObjectUtils::build_complete_member_detail(name_error_frames, member_ann_builtin_error_frames, ann_custom_CanBusHealth);
+            CompleteStructMember member_error_frames = TypeObjectUtils::build_complete_struct_member(common_error_frames, detail_error_frames);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_error_frames);
+        }
+        {
+            TypeIdentifierPair type_ids_bus_off_count;
+            ReturnCode_t return_code_bus_off_count {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_bus_off_count =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_bus_off_count);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_bus_off_count)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "bus_off_count Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_bus_off_count = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_bus_off_count = 0x00000007;
+            bool common_bus_off_count_ec {false};
+            CommonStructMember common_bus_off_count {TypeObjectUtils::build_common_struct_member(member_id_bus_off_count, member_flags_bus_off_count, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_bus_off_count, common_bus_off_count_ec))};
+            if (!common_bus_off_count_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure bus_off_count member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_bus_off_count = "bus_off_count";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_bus_off_count;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_bus_off_count = TypeObjectUtils::build_complete_member_detail(name_bus_off_count, member_ann_builtin_bus_off_count, ann_custom_CanBusHealth);
+            CompleteStructMember member_bus_off_count = TypeObjectUtils::build_complete_struct_member(common_bus_off_count, detail_bus_off_count);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_bus_off_count);
+        }
+        {
+            TypeIdentifierPair type_ids_reconnects;
+            ReturnCode_t return_code_reconnects {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_reconnects =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_reconnects);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_reconnects)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "reconnects Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_reconnects = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_reconnects = 0x00000008;
+            bool common_reconnects_ec {false};
+            CommonStructMember common_reconnects {TypeObjectUtils::build_common_struct_member(member_id_reconnects, member_flags_reconnects, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_reconnects, common_reconnects_ec))};
+            if (!common_reconnects_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure reconnects member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_reconnects = "reconnects";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_reconnects;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_reconnects = TypeObjectUtils::build_complete_member_detail(name_reconnects, member_ann_builtin_reconnects, ann_custom_CanBusHealth);
+            CompleteStructMember member_reconnects = TypeObjectUtils::build_complete_struct_member(common_reconnects, detail_reconnects);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_reconnects);
+        }
+        {
+            TypeIdentifierPair type_ids_bus;
+            ReturnCode_t return_code_bus {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_bus =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "anonymous_string_unbounded", type_ids_bus);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_bus)
+            {
+                {
+                    SBound bound = 0;
+                    StringSTypeDefn string_sdefn = TypeObjectUtils::build_string_s_type_defn(bound);
+                    if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
+                            TypeObjectUtils::build_and_register_s_string_type_identifier(string_sdefn,
+                            "anonymous_string_unbounded", type_ids_bus))
+                    {
+                        EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                            "anonymous_string_unbounded already registered in TypeObjectRegistry for a different type.");
+                    }
+                }
+                return_code_bus =
+                    eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                    "anonymous_string_unbounded", type_ids_bus);
+                if (eprosima::fastdds::dds::RETCODE_OK != return_code_bus)
+                {
+                    EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                                "anonymous_string_unbounded: Given String TypeIdentifier unknown to TypeObjectRegistry.");
+                    return;
+                }
+            }
+            StructMemberFlag member_flags_bus = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_bus = 0x00000009;
+            bool common_bus_ec {false};
+            CommonStructMember common_bus {TypeObjectUtils::build_common_struct_member(member_id_bus, member_flags_bus, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_bus, common_bus_ec))};
+            if (!common_bus_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure bus member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_bus = "bus";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_bus;
+            ann_custom_CanBusHealth.reset();
+            CompleteMemberDetail detail_bus = TypeObjectUtils::build_complete_member_detail(name_bus, member_ann_builtin_bus, ann_custom_CanBusHealth);
+            CompleteStructMember member_bus = TypeObjectUtils::build_complete_struct_member(common_bus, detail_bus);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanBusHealth, member_bus);
+        }
+        CompleteStructType struct_type_CanBusHealth = TypeObjectUtils::build_complete_struct_type(struct_flags_CanBusHealth, header_CanBusHealth, member_seq_CanBusHealth);
+        if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
+                TypeObjectUtils::build_and_register_struct_type_object(struct_type_CanBusHealth, type_name_CanBusHealth.to_string(), type_ids_CanBusHealth))
+        {
+            EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                    "CanBusHealth already registered in TypeObjectRegistry for a different type.");
+        }
+    }
+}
+// TypeIdentifier is returned by reference: dependent structures/unions are registered in this same method
+void register_CanQueryRequest_type_identifier(
+        TypeIdentifierPair& type_ids_CanQueryRequest)
+{
+
+    ReturnCode_t return_code_CanQueryRequest {eprosima::fastdds::dds::RETCODE_OK};
+    return_code_CanQueryRequest =
+        eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+        "CanQueryRequest", type_ids_CanQueryRequest);
+    if (eprosima::fastdds::dds::RETCODE_OK != return_code_CanQueryRequest)
+    {
+        StructTypeFlag struct_flags_CanQueryRequest = TypeObjectUtils::build_struct_type_flag(eprosima::fastdds::dds::xtypes::ExtensibilityKind::APPENDABLE,
+                false, false);
+        QualifiedTypeName type_name_CanQueryRequest = "CanQueryRequest";
+        eprosima::fastcdr::optional<AppliedBuiltinTypeAnnotations> type_ann_builtin_CanQueryRequest;
+        eprosima::fastcdr::optional<AppliedAnnotationSeq> ann_custom_CanQueryRequest;
+        CompleteTypeDetail detail_CanQueryRequest = TypeObjectUtils::build_complete_type_detail(type_ann_builtin_CanQueryRequest, ann_custom_CanQueryRequest, type_name_CanQueryRequest.to_string());
+        CompleteStructHeader header_CanQueryRequest;
+        header_CanQueryRequest = TypeObjectUtils::build_complete_struct_header(TypeIdentifier(), detail_CanQueryRequest);
+        CompleteStructMemberSeq member_seq_CanQueryRequest;
+        {
+            TypeIdentifierPair type_ids_request_id;
+            ReturnCode_t return_code_request_id {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_request_id =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_request_id);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_request_id)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "request_id Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_request_id = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_request_id = 0x00000000;
+            bool common_request_id_ec {false};
+            CommonStructMember common_request_id {TypeObjectUtils::build_common_struct_member(member_id_request_id, member_flags_request_id, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_request_id, common_request_id_ec))};
+            if (!common_request_id_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure request_id member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_request_id = "request_id";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_request_id;
+            ann_custom_CanQueryRequest.reset();
+            CompleteMemberDetail detail_request_id = TypeObjectUtils::build_complete_member_detail(name_request_id, member_ann_builtin_request_id, ann_custom_CanQueryRequest);
+            CompleteStructMember member_request_id = TypeObjectUtils::build_complete_struct_member(common_request_id, detail_request_id);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryRequest, member_request_id);
+        }
+        {
+            TypeIdentifierPair type_ids_can_id;
+            ReturnCode_t return_code_can_id {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_can_id =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_can_id);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_can_id)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "can_id Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_can_id = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_can_id = 0x00000001;
+            bool common_can_id_ec {false};
+            CommonStructMember common_can_id {TypeObjectUtils::build_common_struct_member(member_id_can_id, member_flags_can_id, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_can_id, common_can_id_ec))};
+            if (!common_can_id_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure can_id member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_can_id = "can_id";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_can_id;
+            ann_custom_CanQueryRequest.reset();
+            CompleteMemberDetail detail_can_id = TypeObjectUtils::build_complete_member_detail(name_can_id, member_ann_builtin_can_id, ann_custom_CanQueryRequest);
+            CompleteStructMember member_can_id = TypeObjectUtils::build_complete_struct_member(common_can_id, detail_can_id);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryRequest, member_can_id);
+        }
+        {
+            TypeIdentifierPair type_ids_wall_clock;
+            ReturnCode_t return_code_wall_clock {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_wall_clock =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_bool", type_ids_wall_clock);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_wall_clock)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "wall_clock Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_wall_clock = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_wall_clock = 0x00000002;
+            bool common_wall_clock_ec {false};
+            CommonStructMember common_wall_clock {TypeObjectUtils::build_common_struct_member(member_id_wall_clock, member_flags_wall_clock, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_wall_clock, common_wall_clock_ec))};
+            if (!common_wall_clock_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure wall_clock member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_wall_clock = "wall_clock";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_wall_clock;
+            ann_custom_CanQueryRequest.reset();
+            CompleteMemberDetail detail_wall_clock = TypeObjectUtils::build_complete_member_detail(name_wall_clock, member_ann_builtin_wall_clock, ann_custom_CanQueryRequest);
+            CompleteStructMember member_wall_clock = TypeObjectUtils::build_complete_struct_member(common_wall_clock, detail_wall_clock);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryRequest, member_wall_clock);
+        }
+        {
+            TypeIdentifierPair type_ids_from_us;
+            ReturnCode_t return_code_from_us {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_from_us =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int64_t", type_ids_from_us);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_from_us)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "from_us Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_from_us = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_from_us = 0x00000003;
+            bool common_from_us_ec {false};
+            CommonStructMember common_from_us {TypeObjectUtils::build_common_struct_member(member_id_from_us, member_flags_from_us, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_from_us, common_from_us_ec))};
+            if (!common_from_us_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure from_us member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_from_us = "from_us";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_from_us;
+            ann_custom_CanQueryRequest.reset();
+            CompleteMemberDetail detail_from_us = TypeObjectUtils::build_complete_member_detail(name_from_us, member_ann_builtin_from_us, ann_custom_CanQueryRequest);
+            CompleteStructMember member_from_us = TypeObjectUtils::build_complete_struct_member(common_from_us, detail_from_us);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryRequest, member_from_us);
+        }
+        {
+            TypeIdentifierPair type_ids_to_us;
+            ReturnCode_t return_code_to_us {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_to_us =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int64_t", type_ids_to_us);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_to_us)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "to_us Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_to_us = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_to_us = 0x00000004;
+            bool common_to_us_ec {false};
+            CommonStructMember common_to_us {TypeObjectUtils::build_common_struct_member(member_id_to_us, member_flags_to_us, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_to_us, common_to_us_ec))};
+            if (!common_to_us_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure to_us member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_to_us = "to_us";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_to_us;
+            ann_custom_CanQueryRequest.reset();
+            CompleteMemberDetail detail_to_us = TypeObjectUtils::build_complete_member_detail(name_to_us, member_ann_builtin_to_us, ann_custom_CanQueryRequest);
+            CompleteStructMember member_to_us = TypeObjectUtils::build_complete_struct_member(common_to_us, detail_to_us);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryRequest, member_to_us);
+        }
+        {
+            TypeIdentifierPair type_ids_bucket_us;
+            ReturnCode_t return_code_bucket_us {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_bucket_us =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int64_t", type_ids_bucket_us);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_bucket_us)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "bucket_us Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_bucket_us = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_bucket_us = 0x00000005;
+            bool common_bucket_us_ec {false};
+            CommonStructMember common_bucket_us {TypeObjectUtils::build_common_struct_member(member_id_bucket_us, member_flags_bucket_us, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_bucket_us, common_bucket_us_ec))};
+            if (!common_bucket_us_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure bucket_us member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_bucket_us = "bucket_us";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_bucket_us;
+            ann_custom_CanQueryRequest.reset();
+            CompleteMemberDetail detail_bucket_us = TypeObjectUtils::build_complete_member_detail(name_bucket_us, member_ann_builtin_bucket_us, ann_custom_CanQueryRequest);
+            CompleteStructMember member_bucket_us = TypeObjectUtils::build_complete_struct_member(common_bucket_us, detail_bucket_us);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryRequest, member_bucket_us);
+        }
+        {
+            TypeIdentifierPair type_ids_max_results;
+            ReturnCode_t return_code_max_results {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_max_results =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_max_results);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_max_results)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "max_results Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_max_results = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_max_results = 0x00000006;
+            bool common_max_results_ec {false};
+            CommonStructMember common_max_results {TypeObjectUtils::build_common_struct_member(member_id_max_results, member_flags_max_results, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_max_results, common_max_results_ec))};
+            if (!common_max_results_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure max_results member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_max_results = "max_results";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_max_results;
+            ann_custom_CanQueryRequest.reset();
+            CompleteMemberDetail detail_max_results = TypeObjectUtils::build_complete_member_detail(name_max_results, member_ann_builtin_max_results, ann_custom_CanQueryRequest);
+            CompleteStructMember member_max_results = TypeObjectUtils::build_complete_struct_member(common_max_results, detail_max_results);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryRequest, member_max_results);
+        }
+        CompleteStructType struct_type_CanQueryRequest = TypeObjectUtils::build_complete_struct_type(struct_flags_CanQueryRequest, header_CanQueryRequest, member_seq_CanQueryRequest);
+        if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
+                TypeObjectUtils::build_and_register_struct_type_object(struct_type_CanQueryRequest, type_name_CanQueryRequest.to_string(), type_ids_CanQueryRequest))
+        {
+            EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                    "CanQueryRequest already registered in TypeObjectRegistry for a different type.");
+        }
+    }
+}
+// TypeIdentifier is returned by reference: dependent structures/unions are registered in this same method
+void register_CanQueryReply_type_identifier(
+        TypeIdentifierPair& type_ids_CanQueryReply)
+{
+
+    ReturnCode_t return_code_CanQueryReply {eprosima::fastdds::dds::RETCODE_OK};
+    return_code_CanQueryReply =
+        eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+        "CanQueryReply", type_ids_CanQueryReply);
+    if (eprosima::fastdds::dds::RETCODE_OK != return_code_CanQueryReply)
+    {
+        StructTypeFlag struct_flags_CanQueryReply = TypeObjectUtils::build_struct_type_flag(eprosima::fastdds::dds::xtypes::ExtensibilityKind::APPENDABLE,
+                false, false);
+        QualifiedTypeName type_name_CanQueryReply = "CanQueryReply";
+        eprosima::fastcdr::optional<AppliedBuiltinTypeAnnotations> type_ann_builtin_CanQueryReply;
+        eprosima::fastcdr::optional<AppliedAnnotationSeq> ann_custom_CanQueryReply;
+        CompleteTypeDetail detail_CanQueryReply = TypeObjectUtils::build_complete_type_detail(type_ann_builtin_CanQueryReply, ann_custom_CanQueryReply, type_name_CanQueryReply.to_string());
+        CompleteStructHeader header_CanQueryReply;
+        header_CanQueryReply = TypeObjectUtils::build_complete_struct_header(TypeIdentifier(), detail_CanQueryReply);
+        CompleteStructMemberSeq member_seq_CanQueryReply;
+        {
+            TypeIdentifierPair type_ids_request_id;
+            ReturnCode_t return_code_request_id {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_request_id =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_request_id);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_request_id)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "request_id Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_request_id = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_request_id = 0x00000000;
+            bool common_request_id_ec {false};
+            CommonStructMember common_request_id {TypeObjectUtils::build_common_struct_member(member_id_request_id, member_flags_request_id, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_request_id, common_request_id_ec))};
+            if (!common_request_id_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure request_id member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_request_id = "request_id";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_request_id;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_request_id = TypeObjectUtils::build_complete_member_detail(name_request_id, member_ann_builtin_request_id, ann_custom_CanQueryReply);
+            CompleteStructMember member_request_id = TypeObjectUtils::build_complete_struct_member(common_request_id, detail_request_id);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_request_id);
+        }
+        {
+            TypeIdentifierPair type_ids_seq;
+            ReturnCode_t return_code_seq {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_seq =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_seq);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_seq)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "seq Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_seq = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_seq = 0x00000001;
+            bool common_seq_ec {false};
+            CommonStructMember common_seq {TypeObjectUtils::build_common_struct_member(member_id_seq, member_flags_seq, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_seq, common_seq_ec))};
+            if (!common_seq_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure seq member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_seq = "seq";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_seq;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_seq = TypeObjectUtils::build_complete_member_detail(name_seq, member_ann_builtin_seq, ann_custom_CanQueryReply);
+            CompleteStructMember member_seq = TypeObjectUtils::build_complete_struct_member(common_seq, detail_seq);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_seq);
+        }
+        {
+            TypeIdentifierPair type_ids_status;
+            ReturnCode_t return_code_status {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_status =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_byte", type_ids_status);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_status)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "status Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_status = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_status = 0x00000002;
+            bool common_status_ec {false};
+            CommonStructMember common_status {TypeObjectUtils::build_common_struct_member(member_id_status, member_flags_status, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_status, common_status_ec))};
+            if (!common_status_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure status member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_status = "status";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_status;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_status = TypeObjectUtils::build_complete_member_detail(name_status, member_ann_builtin_status, ann_custom_CanQueryReply);
+            CompleteStructMember member_status = TypeObjectUtils::build_complete_struct_member(common_status, detail_status);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_status);
+        }
+        {
+            TypeIdentifierPair type_ids_last;
+            ReturnCode_t return_code_last {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_last =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_bool", type_ids_last);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_last)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "last Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_last = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_last = 0x00000003;
+            bool common_last_ec {false};
+            CommonStructMember common_last {TypeObjectUtils::build_common_struct_member(member_id_last, member_flags_last, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_last, common_last_ec))};
+            if (!common_last_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure last member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_last = "last";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_last;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_last = TypeObjectUtils::build_complete_member_detail(name_last, member_ann_builtin_last, ann_custom_CanQueryReply);
+            CompleteStructMember member_last = TypeObjectUtils::build_complete_struct_member(common_last, detail_last);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_last);
+        }
+        {
+            TypeIdentifierPair type_ids_can_id;
+            ReturnCode_t return_code_can_id {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_can_id =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_can_id);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_can_id)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "can_id Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_can_id = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_can_id = 0x00000004;
+            bool common_can_id_ec {false};
+            CommonStructMember common_can_id {TypeObjectUtils::build_common_struct_member(member_id_can_id, member_flags_can_id, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_can_id, common_can_id_ec))};
+            if (!common_can_id_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure can_id member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_can_id = "can_id";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_can_id;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_can_id = TypeObjectUtils::build_complete_member_detail(name_can_id, member_ann_builtin_can_id, ann_custom_CanQueryReply);
+            CompleteStructMember member_can_id = TypeObjectUtils::build_complete_struct_member(common_can_id, detail_can_id);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_can_id);
+        }
+        {
+            TypeIdentifierPair type_ids_timestamp;
+            ReturnCode_t return_code_timestamp {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_timestamp =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int64_t", type_ids_timestamp);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_timestamp)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "timestamp Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_timestamp = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_timestamp = 0x00000005;
+            bool common_timestamp_ec {false};
+            CommonStructMember common_timestamp {TypeObjectUtils::build_common_struct_member(member_id_timestamp, member_flags_timestamp, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_timestamp, common_timestamp_ec))};
+            if (!common_timestamp_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure timestamp member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_timestamp = "timestamp";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_timestamp;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_timestamp = TypeObjectUtils::build_complete_member_detail(name_timestamp, member_ann_builtin_timestamp, ann_custom_CanQueryReply);
+            CompleteStructMember member_timestamp = TypeObjectUtils::build_complete_struct_member(common_timestamp, detail_timestamp);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_timestamp);
+        }
+        {
+            TypeIdentifierPair type_ids_min;
+            ReturnCode_t return_code_min {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_min =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int32_t", type_ids_min);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_min)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "min Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_min = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_min = 0x00000006;
+            bool common_min_ec {false};
+            CommonStructMember common_min {TypeObjectUtils::build_common_struct_member(member_id_min, member_flags_min, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_min, common_min_ec))};
+            if (!common_min_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure min member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_min = "min";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_min;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_min = TypeObjectUtils::build_complete_member_detail(name_min, member_ann_builtin_min, ann_custom_CanQueryReply);
+            CompleteStructMember member_min = TypeObjectUtils::build_complete_struct_member(common_min, detail_min);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_min);
+        }
+        {
+            TypeIdentifierPair type_ids_max;
+            ReturnCode_t return_code_max {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_max =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_int32_t", type_ids_max);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_max)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "max Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_max = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_max = 0x00000007;
+            bool common_max_ec {false};
+            CommonStructMember common_max {TypeObjectUtils::build_common_struct_member(member_id_max, member_flags_max, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_max, common_max_ec))};
+            if (!common_max_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure max member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_max = "max";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_max;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_max = TypeObjectUtils::build_complete_member_detail(name_max, member_ann_builtin_max, ann_custom_CanQueryReply);
+            CompleteStructMember member_max = TypeObjectUtils::build_complete_struct_member(common_max, detail_max);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_max);
+        }
+        {
+            TypeIdentifierPair type_ids_mean;
+            ReturnCode_t return_code_mean {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_mean =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_float64", type_ids_mean);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_mean)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "mean Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_mean = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_mean = 0x00000008;
+            bool common_mean_ec {false};
+            CommonStructMember common_mean {TypeObjectUtils::build_common_struct_member(member_id_mean, member_flags_mean, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_mean, common_mean_ec))};
+            if (!common_mean_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure mean member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_mean = "mean";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_mean;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_mean = TypeObjectUtils::build_complete_member_detail(name_mean, member_ann_builtin_mean, ann_custom_CanQueryReply);
+            CompleteStructMember member_mean = TypeObjectUtils::build_complete_struct_member(common_mean, detail_mean);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_mean);
+        }
+        {
+            TypeIdentifierPair type_ids_count;
+            ReturnCode_t return_code_count {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_count =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint32_t", type_ids_count);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_count)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "count Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_count = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_count = 0x00000009;
+            bool common_count_ec {false};
+            CommonStructMember common_count {TypeObjectUtils::build_common_struct_member(member_id_count, member_flags_count, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_count, common_count_ec))};
+            if (!common_count_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure count member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_count = "count";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_count;
+            ann_custom_CanQueryReply.reset();
+            CompleteMemberDetail detail_count = TypeObjectUtils::build_complete_member_detail(name_count, member_ann_builtin_count, ann_custom_CanQueryReply);
+            CompleteStructMember member_count = TypeObjectUtils::build_complete_struct_member(common_count, detail_count);
+            TypeObjectUtils::add_complete_struct_member(member_seq_CanQueryReply, member_count);
+        }
+        CompleteStructType struct_type_CanQueryReply = TypeObjectUtils::build_complete_struct_type(struct_flags_CanQueryReply, header_CanQueryReply, member_seq_CanQueryReply);
+        if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
+                TypeObjectUtils::build_and_register_struct_type_object(struct_type_CanQueryReply, type_name_CanQueryReply.to_string(), type_ids_CanQueryReply))
+        {
+            EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                    "CanQueryReply already registered in TypeObjectRegistry for a different type.");
+        }
+    }
+}
 
@@ -0,0 +1,417 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// io_uring over the raw system calls, liburing isn't on the boards. A ring
+// belongs to one thread: SQEs are queued with sqe(), handed to the kernel
+// with one io_uring_enter() by submit(), and completions are read from the
+// shared CQ with peek()/seen() without a system call. The ring fd polls
+// readable while completions wait, so an IoLoop can await it like a socket.
+// enters counts io_uring_enter() calls for the benchmarks.
+class IoUring {
+public:
+    IoUring() = default;
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+    ~IoUring() { close(); }
+
+    // entries SQEs, cqEntries CQEs (0 = twice entries); false with errno set.
+    bool open(unsigned entries, unsigned cqEntries = 0) {
+        struct io_uring_params p{};
+        if (cqEntries) {
+            p.flags |= IORING_SETUP_CQSIZE;
+            p.cq_entries = cqEntries;
+        }
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &p));
+        if (ringFd < 0) return false;
+
+        sqMapSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cqMapSize = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+        if (p.features & IORING_FEAT_SINGLE_MMAP) sqMapSize = cqMapSize = std::max(sqMapSize, cqMapSize);
+        sqMap = mmap(nullptr, sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqMap == MAP_FAILED) return fail();
+        cqMap = sqMap;
+        if (!(p.features & IORING_FEAT_SINGLE_MMAP)) {
+            cqMap = mmap(nullptr, cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+            if (cqMap == MAP_FAILED) return fail();
+        }
+        sqesSize = p.sq_entries * sizeof(struct io_uring_sqe);
+        void* sqeMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqeMap == MAP_FAILED) return fail();
+        sqes = static_cast<struct io_uring_sqe*>(sqeMap);
+
+        char* sq = static_cast<char*>(sqMap);
+        char* cq = static_cast<char*>(cqMap);
+        sqHead = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        sqEntries = p.sq_entries;
+        cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes = reinterpret_cast<struct io_uring_cqe*>(cq + p.cq_off.cqes);
+        localTail = *sqTail;
+        queued = 0;
+        return true;
+    }
+
+    void close() {
+        if (sqes != nullptr) munmap(sqes, sqesSize);
+        if (cqMap != nullptr && cqMap != MAP_FAILED && cqMap != sqMap) munmap(cqMap, cqMapSize);
+        if (sqMap != nullptr && sqMap != MAP_FAILED) munmap(sqMap, sqMapSize);
+        if (ringFd >= 0) ::close(ringFd);
+        sqes = nullptr;
+        sqMap = cqMap = nullptr;
+        ringFd = -1;
+    }
+
+    bool active() const { return ringFd >= 0; }
+    int fd() const { return ringFd; }
+
+    // Next free SQE, cleared; nullptr while the SQ is full.
+    struct io_uring_sqe* sqe() {
+        if (localTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) return nullptr;
+        const unsigned index = localTail & sqMask;
+        struct io_uring_sqe* entry = &sqes[index];
+        memset(entry, 0, sizeof(*entry));
+        sqArray[index] = index;
+        localTail++;
+        queued++;
+        return entry;
+    }
+
+    // Hands the queued SQEs to the kernel and waits for waitFor completions.
+    // Returns the SQEs submitted, -1 with errno set on failure.
+    int submit(unsigned waitFor = 0) {
+        __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+        while (true) {
+            enters++;
+            const int n = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, queued, waitFor,
+                                                   waitFor ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+            if (n >= 0) {
+                queued -= static_cast<unsigned>(n);
+                return n;
+            }
+            if (errno != EINTR) return -1;
+        }
+    }
+
+    // Oldest completion not yet seen(), nullptr if none; no system call.
+    struct io_uring_cqe* peek() {
+        const unsigned head = *cqHead;
+        if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) return nullptr;
+        return &cqes[head & cqMask];
+    }
+
+    void seen() { __atomic_store_n(cqHead, *cqHead + 1, __ATOMIC_RELEASE); }
+
+    int registerOp(unsigned opcode, void* arg, unsigned count) {
+        return static_cast<int>(syscall(__NR_io_uring_register, ringFd, opcode, arg, count));
+    }
+
+    uint64_t enters = 0;
+
+private:
+    bool fail() {
+        const int saved = errno;
+        close();
+        errno = saved;
+        return false;
+    }
+
+    int ringFd = -1;
+    void* sqMap = nullptr;
+    void* cqMap = nullptr;
+    size_t sqMapSize = 0;
+    size_t cqMapSize = 0;
+    size_t sqesSize = 0;
+    struct io_uring_sqe* sqes = nullptr;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    struct io_uring_cqe* cqes = nullptr;
+    unsigned localTail = 0;   // SQEs filled, published to sqTail by submit()
+    unsigned queued = 0;      // filled, not yet taken by the kernel
+};
+
+// Provided buffer ring: count buffers of size bytes in one mapping, which
+// the kernel picks from for requests with IOSQE_BUFFER_SELECT on group. A
+// completion names its buffer, which goes back with recycle() once read;
+// recycled buffers are published together by commit().
+class BufferRing {
+public:
+    BufferRing() = default;
+    BufferRing(const BufferRing&) = delete;
+    BufferRing& operator=(const BufferRing&) = delete;
+    ~BufferRing() { unmap(); }
+
+    // count a power of two; false with errno set.
+    bool open(IoUring& ring, uint16_t groupId, unsigned count, size_t size) {
+        entries = count;
+        bufferSize = (size + 15) & ~size_t{15};
+        ringSize = count * sizeof(struct io_uring_buf);
+        mapSize = ringSize + count * bufferSize;
+        void* map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+        if (map == MAP_FAILED) return false;
+        bufs = static_cast<struct io_uring_buf*>(map);
+        data = static_cast<char*>(map) + ringSize;
+
+        struct io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(bufs);
+        reg.ring_entries = count;
+        reg.bgid = groupId;
+        if (ring.registerOp(IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+            const int saved = errno;
+            unmap();
+            errno = saved;
+            return false;
+        }
+        group = groupId;
+        tail = 0;
+        for (unsigned id = 0; id < count; id++) recycle(id);
+        commit();
+        return true;
+    }
+
+    // After the ring it was registered with is closed, or before it.
+    void unmap() {
+        if (bufs != nullptr) munmap(bufs, mapSize);
+        bufs = nullptr;
+    }
+
+    uint16_t groupId() const { return group; }
+    size_t size() const { return bufferSize; }
+    char* buffer(unsigned id) { return data + id * bufferSize; }
+
+    void recycle(unsigned id) {
+        struct io_uring_buf& buf = bufs[tail & (entries - 1)];
+        buf.addr = reinterpret_cast<uint64_t>(buffer(id));
+        buf.len = static_cast<uint32_t>(bufferSize);
+        buf.bid = static_cast<uint16_t>(id);
+        tail++;
+    }
+
+    // the ring tail is the resv field of the first entry
+    void commit() { __atomic_store_n(&bufs[0].resv, tail, __ATOMIC_RELEASE); }
+
+private:
+    // Not io_uring_buf_ring: its flexible array sits behind an empty struct,
+    // which takes a byte in C++, so bufs[] would be off by 8.
+    struct io_uring_buf* bufs = nullptr;
+    char* data = nullptr;
+    size_t mapSize = 0;
+    size_t ringSize = 0;
+    size_t bufferSize = 0;
+    unsigned entries = 0;
+    uint16_t group = 0;
+    uint16_t tail = 0;
+};
+
+// Multishot recvmsg on one datagram socket: armed once, the request stays in
+// the kernel and posts a completion per message into a provided buffer, laid
+// out as io_uring_recvmsg_out, control messages, payload. Reading a batch is
+// then a walk over the CQ without any system call; only when the kernel ran
+// out of buffers (or the socket failed) does the request end, and receive()
+// arms it again with one io_uring_enter(). The ring fd is what to wait on.
+class RingReceiver {
+public:
+    static constexpr unsigned BUFFERS = 256;   // messages the kernel can fill before they are read
+    static constexpr uint16_t GROUP = 0;
+
+    RingReceiver() = default;
+    RingReceiver(const RingReceiver&) = delete;
+    RingReceiver& operator=(const RingReceiver&) = delete;
+    ~RingReceiver() { close(); }
+
+    // controlBytes and payloadBytes as for a recvmsg() of one message.
+    // False with errno set when the kernel lacks io_uring, provided buffer
+    // rings (5.19) or multishot recvmsg (6.0).
+    bool open(int s, size_t controlBytes, size_t payloadBytes) {
+        close();
+        socket = s;
+        msg = {};
+        msg.msg_controllen = controlBytes;
+        payloadRoom = payloadBytes;
+        if (!ring.open(8, 2 * BUFFERS)) return false;
+        if (!buffers.open(ring, GROUP, BUFFERS, sizeof(struct io_uring_recvmsg_out) + controlBytes + payloadBytes)
+            || !arm()) {
+            return fail();
+        }
+        // an unsupported request completes at once with an error
+        struct io_uring_cqe* cqe = ring.peek();
+        if (cqe != nullptr && cqe->res < 0 && !(cqe->flags & IORING_CQE_F_MORE)) {
+            errno = -cqe->res;
+            return fail();
+        }
+        return true;
+    }
+
+    void close() {
+        ring.close();   // cancels the request
+        buffers.unmap();
+        armed = false;
+    }
+
+    bool active() const { return ring.active(); }
+    int fd() const { return ring.fd(); }
+    uint64_t enters() const { return ring.enters; }
+
+    // Calls onMessage(msghdr& control, const char* payload, size_t length)
+    // for at most max received messages; the msghdr only carries the control
+    // messages. Returns the messages read, -1 with errno set when
+    // the socket failed.
+    template <typename OnMessage>
+    ssize_t receive(size_t max, OnMessage onMessage) {
+        ssize_t n = 0;
+        int error = 0;
+        struct io_uring_cqe* cqe;
+        while (static_cast<size_t>(n) < max && (cqe = ring.peek()) != nullptr) {
+            const int res = cqe->res;
+            const unsigned flags = cqe->flags;
+            ring.seen();
+            if (!(flags & IORING_CQE_F_MORE)) armed = false;
+            if (res < 0) {
+                if (res != -ENOBUFS) error = -res;   // out of buffers: rearmed below
+                continue;
+            }
+            if (!(flags & IORING_CQE_F_BUFFER)) continue;
+            const unsigned id = flags >> IORING_CQE_BUFFER_SHIFT;
+            char* buffer = buffers.buffer(id);
+            const auto* out = reinterpret_cast<const struct io_uring_recvmsg_out*>(buffer);
+            char* control = buffer + sizeof(*out) + msg.msg_namelen;
+            struct msghdr received{};
+            received.msg_control = control;
+            received.msg_controllen = out->controllen;
+            onMessage(received, control + msg.msg_controllen, std::min<size_t>(out->payloadlen, payloadRoom));
+            buffers.recycle(id);
+            n++;
+        }
+        buffers.commit();
+        if (error) {
+            errno = error;
+            return -1;
+        }
+        if (!armed && !arm()) return -1;
+        return n;
+    }
+
+private:
+    bool arm() {
+        struct io_uring_sqe* sqe = ring.sqe();
+        if (sqe == nullptr) {
+            errno = EBUSY;
+            return false;
+        }
+        sqe->opcode = IORING_OP_RECVMSG;
+        sqe->fd = socket;
+        sqe->addr = reinterpret_cast<uint64_t>(&msg);
+        sqe->len = 1;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = buffers.groupId();
+        if (ring.submit() < 0) return false;
+        armed = true;
+        return true;
+    }
+
+    bool fail() {
+        const int saved = errno;
+        close();
+        errno = saved;
+        return false;
+    }
+
+    IoUring ring;
+    BufferRing buffers;
+    struct msghdr msg{};        // name and control sizes for the kernel, read at arm()
+    size_t payloadRoom = 0;
+    int socket = -1;
+    bool armed = false;
+};
+
+// Queues writes and an fsync on a ring as one linked chain: each SQE but the
+// last carries IOSQE_IO_LINK, so the fsync only starts once every write
+// completed in full, and a failed write cancels the rest. run() submits the
+// chain and waits for all of it with a single io_uring_enter().
+class LinkedWrites {
+public:
+    explicit LinkedWrites(IoUring& ring) : ring(ring) {}
+
+    // False when the SQ is full; run() what is queued and start again.
+    bool write(int fd, const void* data, size_t length, int64_t offset) {
+        struct io_uring_sqe* sqe = next();
+        if (sqe == nullptr) return false;
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<uint64_t>(data);
+        sqe->len = static_cast<uint32_t>(length);
+        sqe->off = static_cast<uint64_t>(offset);
+        sqe->user_data = length;
+        return true;
+    }
+
+    bool fsync(int fd, bool dataOnly) {
+        struct io_uring_sqe* sqe = next();
+        if (sqe == nullptr) return false;
+        sqe->opcode = IORING_OP_FSYNC;
+        sqe->fd = fd;
+        sqe->fsync_flags = dataOnly ? IORING_FSYNC_DATASYNC : 0;
+        sqe->user_data = 0;
+        return true;
+    }
+
+    size_t size() const { return count; }
+
+    // Returns 0, or the errno of the first failed entry; a short write counts
+    // as EIO.
+    int run() {
+        if (count == 0) return 0;
+        if (last != nullptr) last->flags &= ~IOSQE_IO_LINK;
+        const unsigned expected = static_cast<unsigned>(count);
+        count = 0;
+        last = nullptr;
+        if (ring.submit(expected) < 0) return errno;
+        int error = 0;
+        for (unsigned done = 0; done < expected;) {
+            struct io_uring_cqe* cqe = ring.peek();
+            if (cqe == nullptr) {
+                if (ring.submit(expected - done) < 0) return errno;
+                continue;
+            }
+            if (error == 0 && cqe->res < 0) error = -cqe->res;
+            if (error == 0 && cqe->user_data && static_cast<uint64_t>(cqe->res) != cqe->user_data) error = EIO;
+            ring.seen();
+            done++;
+        }
+        return error;
+    }
+
+private:
+    struct io_uring_sqe* next() {
+        struct io_uring_sqe* sqe = ring.sqe();
+        if (sqe == nullptr) return nullptr;
+        if (last != nullptr) last->flags |= IOSQE_IO_LINK;
+        last = sqe;
+        count++;
+        return sqe;
+    }
+
+    IoUring& ring;
+    struct io_uring_sqe* last = nullptr;
+    size_t count = 0;
+};
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <linux/can.h>
+#include "CanBatch.hpp"
+#include "Timestamp.hpp"
+
+// Latest value of every standard (11-bit) CAN id, in a shared-memory segment
+// other processes map read-only. One seqlock covers the whole segment, with
+// room for several writers: each shard's receive thread counts a write
+// section begun and ended around each batch and never waits, readers copy
+// what they need and retry unless no section was open before and none began
+// during the copy, so a snapshot of several signals is always from whole
+// batches. Reading is plain loads, no syscalls.
+// Fields are atomics (relaxed) so the racy copy is defined behaviour; all of
+// them are lock-free and therefore address-free across processes.
+
+constexpr uint32_t LVC_MAGIC = 0x43564C43;   // "CLVC"
+constexpr uint32_t LVC_VERSION = 2;
+constexpr uint32_t LVC_SLOTS = CAN_SFF_MASK + 1;
+
+struct LvcSlot {
+    std::atomic<int32_t> value;
+    std::atomic<uint32_t> updates;      // 0 = never seen
+    std::atomic<int64_t> timestamp;     // receive time, monotonic µs
+};
+
+struct LvcSegment {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t size;
+    std::atomic<uint64_t> begun;        // write sections started
+    std::atomic<uint64_t> ended;        // and finished; equal when no batch is being written
+    std::atomic<int64_t> anchorMonotonicUs;   // latest clock anchor, see Timestamp.hpp
+    std::atomic<int64_t> anchorRealtimeUs;
+    LvcSlot slots[LVC_SLOTS];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free,
+              "shared-memory seqlock needs lock-free 64-bit atomics");
+
+struct LvcValue {
+    uint32_t can_id;
+    int32_t value;
+    int64_t timestamp;
+    bool valid;          // id has been received at least once
+};
+
+// Reads ids[0..n) into out as one consistent snapshot. Gives up and returns
+// false after maxTries concurrent writes, which needs a pathological bus.
+inline bool lvcSnapshot(const LvcSegment& seg, const uint32_t* ids, size_t n, LvcValue* out,
+                        ClockAnchor* anchor = nullptr, int maxTries = 1000) {
+    for (int attempt = 0; attempt < maxTries; attempt++) {
+        const uint64_t ended = seg.ended.load(std::memory_order_acquire);
+        const uint64_t before = seg.begun.load(std::memory_order_acquire);
+        if (before != ended) continue;
+        for (size_t i = 0; i < n; i++) {
+            if (ids[i] >= LVC_SLOTS) {
+                out[i] = {ids[i], 0, 0, false};
+                continue;
+            }
+            const LvcSlot& slot = seg.slots[ids[i]];
+            out[i].can_id = ids[i];
+            out[i].value = slot.value.load(std::memory_order_relaxed);
+            out[i].timestamp = slot.timestamp.load(std::memory_order_relaxed);
+            out[i].valid = slot.updates.load(std::memory_order_relaxed) != 0;
+        }
+        if (anchor) {
+            anchor->monotonicUs = seg.anchorMonotonicUs.load(std::memory_order_relaxed);
+            anchor->realtimeUs = seg.anchorRealtimeUs.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seg.begun.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+
+// Writer side, shared by the receive threads; writes of one thread do not
+// wait for another's. An empty name keeps the segment in private memory, for
+// in-process readers only.
+class LastValueCache {
+public:
+    LastValueCache() = default;
+    LastValueCache(const LastValueCache&) = delete;
+    LastValueCache& operator=(const LastValueCache&) = delete;
+    ~LastValueCache() { close(); }
+
+    // With reattach, a segment left by a previous writer with the same layout
+    // is taken over with its values, so readers keep their mapping across a
+    // worker restart; otherwise a new one replaces it.
+    bool open(const std::string& shmName, bool reattach = false) {
+        name = shmName;
+        if (reattach && !name.empty() && attach()) return true;
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        int fd = -1;
+        if (!name.empty()) {
+            shm_unlink(name.c_str());   // readers of a previous run keep their old mapping
+            fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+            if (fd < 0 || ftruncate(fd, sizeof(LvcSegment)) < 0) {
+                perror("Last value cache shm");
+                if (fd >= 0) ::close(fd);
+                return false;
+            }
+            flags = MAP_SHARED;
+        }
+        void* mem = mmap(nullptr, sizeof(LvcSegment), PROT_READ | PROT_WRITE, flags, fd, 0);
+        if (fd >= 0) ::close(fd);
+        if (mem == MAP_FAILED) {
+            perror("Last value cache mmap");
+            return false;
+        }
+        // fresh mappings are zero-filled, which is a valid empty cache
+        seg = static_cast<LvcSegment*>(mem);
+        seg->slotCount = LVC_SLOTS;
+        seg->size = sizeof(LvcSegment);
+        seg->version = LVC_VERSION;
+        std::atomic_thread_fence(std::memory_order_release);
+        seg->magic = LVC_MAGIC;
+        return true;
+    }
+
+    void close() {
+        if (seg == nullptr) return;
+        munmap(seg, sizeof(LvcSegment));
+        if (!name.empty()) shm_unlink(name.c_str());
+        seg = nullptr;
+    }
+
+    // One seqlock write section per decoded batch. Extended ids are skipped.
+    // Shards on different buses may carry the same id; the last write wins.
+    void update(const CanColumns& cols) {
+        if (seg == nullptr || cols.empty()) return;
+        beginWrite();
+        for (size_t i = 0; i < cols.size(); i++) {
+            if (cols.ids[i] >= LVC_SLOTS) continue;
+            LvcSlot& slot = seg->slots[cols.ids[i]];
+            slot.value.store(cols.values[i], std::memory_order_relaxed);
+            slot.timestamp.store(cols.timestamps[i], std::memory_order_relaxed);
+            slot.updates.fetch_add(1, std::memory_order_relaxed);
+        }
+        endWrite();
+    }
+
+    void setAnchor(const ClockAnchor& anchor) {
+        if (seg == nullptr) return;
+        beginWrite();
+        seg->anchorMonotonicUs.store(anchor.monotonicUs, std::memory_order_relaxed);
+        seg->anchorRealtimeUs.store(anchor.realtimeUs, std::memory_order_relaxed);
+        endWrite();
+    }
+
+    bool snapshot(const uint32_t* ids, size_t n, LvcValue* out) const {
+        return seg != nullptr && lvcSnapshot(*seg, ids, n, out);
+    }
+
+private:
+    bool attach() {
+        const int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) return false;
+        struct stat st;
+        void* mem = fstat(fd, &st) == 0 && st.st_size == static_cast<off_t>(sizeof(LvcSegment))
+                        ? mmap(nullptr, sizeof(LvcSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                        : MAP_FAILED;
+        ::close(fd);
+        if (mem == MAP_FAILED) return false;
+        LvcSegment* mapped = static_cast<LvcSegment*>(mem);
+        if (mapped->magic != LVC_MAGIC || mapped->version != LVC_VERSION || mapped->size != sizeof(LvcSegment)) {
+            munmap(mem, sizeof(LvcSegment));
+            return false;
+        }
+        // a writer that died inside a batch left its section open; close it
+        // so readers stop retrying (that batch may be half applied)
+        mapped->ended.store(mapped->begun.load(std::memory_order_relaxed), std::memory_order_release);
+        seg = mapped;
+        return true;
+    }
+
+    void beginWrite() {
+        seg->begun.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void endWrite() { seg->ended.fetch_add(1, std::memory_order_release); }
+
+    std::string name;
+    LvcSegment* seg = nullptr;
+};
+
+// Read-only view of the segment for other processes; only open() makes
+// syscalls.
+class LastValueReader {
+public:
+    LastValueReader() = default;
+    LastValueReader(const LastValueReader&) = delete;
+    LastValueReader& operator=(const LastValueReader&) = delete;
+    ~LastValueReader() {
+        if (seg) munmap(const_cast<LvcSegment*>(seg), sizeof(LvcSegment));
+    }
+
+    bool open(const std::string& shmName) {
+        const int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            perror("Last value cache shm");
+            return false;
+        }
+        void* mem = mmap(nullptr, sizeof(LvcSegment), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) {
+            perror("Last value cache mmap");
+            return false;
+        }
+        const LvcSegment* mapped = static_cast<const LvcSegment*>(mem);
+        if (mapped->magic != LVC_MAGIC || mapped->version != LVC_VERSION || mapped->size != sizeof(LvcSegment)) {
+            std::fprintf(stderr, "Last value cache %s has an unknown layout\n", shmName.c_str());
+            munmap(mem, sizeof(LvcSegment));
+            return false;
+        }
+        seg = mapped;
+        return true;
+    }
+
+    bool snapshot(const uint32_t* ids, size_t n, LvcValue* out, ClockAnchor* anchor = nullptr) const {
+        return seg != nullptr && lvcSnapshot(*seg, ids, n, out, anchor);
+    }
+
+    bool read(uint32_t can_id, LvcValue& out) const { return snapshot(&can_id, 1, &out); }
+
+private:
+    const LvcSegment* seg = nullptr;
+};
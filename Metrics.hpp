@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Lock-free metrics: every updating thread owns a cache-line padded slot,
+// so the hot path is a single uncontended relaxed atomic add. Slots are
+// summed only by the exporter. Registration happens once at startup.
+
+constexpr int METRICS_MAX_THREADS = 8;
+
+inline int metricsThreadSlot() {
+    static std::atomic<int> next{0};
+    thread_local const int slot = next.fetch_add(1, std::memory_order_relaxed) % METRICS_MAX_THREADS;
+    return slot;
+}
+
+inline int64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+struct alignas(64) PaddedCounter {
+    std::atomic<uint64_t> value{0};
+};
+
+class Metric {
+public:
+    Metric(const char* name, const char* help);
+    virtual ~Metric() = default;
+    virtual void render(std::ostream& out) const = 0;
+
+    const char* name;
+    const char* help;
+};
+
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    void add(Metric* metric) {
+        std::lock_guard<std::mutex> guard(lock);
+        metrics.push_back(metric);
+    }
+
+    std::string render() const {
+        std::ostringstream out;
+        std::lock_guard<std::mutex> guard(lock);
+        for (const Metric* metric : metrics) {
+            metric->render(out);
+        }
+        return out.str();
+    }
+
+private:
+    mutable std::mutex lock;
+    std::vector<Metric*> metrics;
+};
+
+inline Metric::Metric(const char* name, const char* help) : name(name), help(help) {
+    MetricsRegistry::instance().add(this);
+}
+
+class MetricCounter : public Metric {
+public:
+    using Metric::Metric;
+
+    void inc(uint64_t n = 1) {
+        slots[metricsThreadSlot()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const {
+        uint64_t sum = 0;
+        for (const auto& slot : slots) sum += slot.value.load(std::memory_order_relaxed);
+        return sum;
+    }
+
+    void render(std::ostream& out) const override {
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << " counter\n"
+            << name << ' ' << value() << '\n';
+    }
+
+private:
+    std::array<PaddedCounter, METRICS_MAX_THREADS> slots;
+};
+
+class MetricGauge : public Metric {
+public:
+    using Metric::Metric;
+
+    void set(int64_t v) { current.store(v, std::memory_order_relaxed); }
+    void add(int64_t v) { current.fetch_add(v, std::memory_order_relaxed); }
+    int64_t value() const { return current.load(std::memory_order_relaxed); }
+
+    void render(std::ostream& out) const override {
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << " gauge\n"
+            << name << ' ' << value() << '\n';
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> current{0};
+};
+
+// HDR-style log-linear histogram of nanosecond values: exact below 8, then
+// 8 sub-buckets per power of two (worst case 12.5% relative error).
+class MetricHistogram : public Metric {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;
+    static constexpr int BUCKETS = SUB_COUNT + (64 - SUB_BITS) * SUB_COUNT;
+
+    using Metric::Metric;
+
+    static int bucketOf(uint64_t v) {
+        if (v < SUB_COUNT) return static_cast<int>(v);
+        const int msb = 63 - __builtin_clzll(v);
+        const int sub = static_cast<int>(v >> (msb - SUB_BITS)) & (SUB_COUNT - 1);
+        return SUB_COUNT + (msb - SUB_BITS) * SUB_COUNT + sub;
+    }
+
+    // inclusive upper bound of the bucket
+    static uint64_t bucketLimit(int bucket) {
+        if (bucket < SUB_COUNT) return bucket;
+        const int msb = (bucket - SUB_COUNT) / SUB_COUNT + SUB_BITS;
+        const uint64_t sub = (bucket - SUB_COUNT) % SUB_COUNT;
+        const uint64_t lower = (SUB_COUNT + sub) << (msb - SUB_BITS);
+        return lower + (uint64_t{1} << (msb - SUB_BITS)) - 1;
+    }
+
+    void observe(int64_t ns) {
+        const uint64_t v = ns < 0 ? 0 : static_cast<uint64_t>(ns);
+        Slot& slot = slots[metricsThreadSlot()];
+        slot.counts[bucketOf(v)].fetch_add(1, std::memory_order_relaxed);
+        slot.sum.fetch_add(v, std::memory_order_relaxed);
+    }
+
+    void observeSince(int64_t startNs) { observe(monotonicNs() - startNs); }
+
+    void render(std::ostream& out) const override {
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << " histogram\n";
+        uint64_t cumulative = 0;
+        uint64_t sum = 0;
+        for (const Slot& slot : slots) sum += slot.sum.load(std::memory_order_relaxed);
+        for (int b = 0; b < BUCKETS; b++) {
+            uint64_t count = 0;
+            for (const Slot& slot : slots) count += slot.counts[b].load(std::memory_order_relaxed);
+            if (count == 0) continue;
+            cumulative += count;
+            out << name << "_bucket{le=\"" << bucketLimit(b) << "\"} " << cumulative << '\n';
+        }
+        out << name << "_bucket{le=\"+Inf\"} " << cumulative << '\n'
+            << name << "_sum " << sum << '\n'
+            << name << "_count " << cumulative << '\n';
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::array<std::atomic<uint64_t>, BUCKETS> counts{};
+        std::atomic<uint64_t> sum{0};
+    };
+    std::array<Slot, METRICS_MAX_THREADS> slots;
+};
+
+// Publishes the registry in Prometheus text format: rewrites a file
+// atomically every period and answers each connection on a Unix socket.
+class MetricsExporter {
+public:
+    ~MetricsExporter() { stop(); }
+
+    bool start(const std::string& filePath, const std::string& socketPath, int periodMs = 1000) {
+        file = filePath;
+        period = periodMs;
+        if (!socketPath.empty()) {
+            listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            struct sockaddr_un addr{};
+            addr.sun_family = AF_UNIX;
+            strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+            unlink(addr.sun_path);
+            if (listenFd < 0
+                || bind(listenFd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0
+                || listen(listenFd, 4) < 0) {
+                perror("Metrics socket");
+                if (listenFd >= 0) close(listenFd);
+                listenFd = -1;
+            } else {
+                sockPath = socketPath;
+            }
+        }
+        running = true;
+        worker = std::thread([this] { run(); });
+        return socketPath.empty() || listenFd >= 0;
+    }
+
+    void stop() {
+        if (!running.exchange(false)) return;
+        worker.join();
+        if (listenFd >= 0) {
+            close(listenFd);
+            unlink(sockPath.c_str());
+            listenFd = -1;
+        }
+    }
+
+private:
+    void writeFile() {
+        if (file.empty()) return;
+        const std::string tmp = file + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::trunc);
+            out << MetricsRegistry::instance().render();
+        }
+        std::rename(tmp.c_str(), file.c_str());
+    }
+
+    void serveClient() {
+        int client = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) return;
+        const std::string text = MetricsRegistry::instance().render();
+        size_t sent = 0;
+        while (sent < text.size()) {
+            ssize_t n = send(client, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) break;
+            sent += n;
+        }
+        close(client);
+    }
+
+    void run() {
+        int64_t nextWrite = 0;
+        while (running) {
+            const int64_t now = monotonicNs();
+            if (now >= nextWrite) {
+                writeFile();
+                nextWrite = now + static_cast<int64_t>(period) * 1000000;
+            }
+            struct pollfd pfd{listenFd, POLLIN, 0};
+            const int timeout = static_cast<int>((nextWrite - now) / 1000000) + 1;
+            if (poll(&pfd, listenFd >= 0 ? 1 : 0, std::min(timeout, 200)) > 0 && (pfd.revents & POLLIN)) {
+                serveClient();
+            }
+        }
+    }
+
+    std::atomic<bool> running{false};
+    std::thread worker;
+    std::string file;
+    std::string sockPath;
+    int listenFd = -1;
+    int period = 1000;
+};
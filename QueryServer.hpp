@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include "CanStorage.hpp"
+
+struct QueryRequest {
+    uint32_t id;
+    uint32_t can_id;
+    int64_t fromUs;         // monotonic µs, from inclusive, to exclusive
+    int64_t toUs;
+    int64_t bucketUs;       // 0 = the samples themselves, else min/max/mean per bucket
+    uint32_t maxResults;    // 0 = QueryServer::MAX_RESULTS
+    int64_t offsetUs;       // requester's clock minus monotonic, added to result timestamps
+    int64_t receivedNs;     // monotonic ns the request arrived, for the reply's latency
+};
+
+// One sample (min = max = mean = value, count 1) or one bucket.
+struct QueryResult {
+    uint32_t can_id;
+    int64_t timestamp;      // sample time or bucket start
+    int32_t min;
+    int32_t max;
+    double mean;
+    uint32_t count;
+};
+
+enum class QueryStatus : uint8_t { Ok, Truncated, Rejected };
+
+// Answers range queries over the buffer on a thread of its own, so neither
+// the ingest loop nor the DDS listener waits for one. Storage is scanned a
+// SLICE samples at a time under the storage lock, so a query over hours of
+// buffer delays an insert by one slice at most. Buckets are aligned to
+// multiples of bucketUs and aggregated here, only the results go out.
+// With sharded ingestion a query reads the first buffer that takes its id,
+// a buffer without an id list taking every id.
+class QueryServer {
+public:
+    static constexpr size_t QUEUE = 16;           // pending requests
+    static constexpr size_t SLICE = 256;          // samples per locked scan
+    static constexpr uint32_t MAX_RESULTS = 100000;
+
+    // Called with each slice of results, first being the number of results
+    // sent before; last is set on the final call, which may carry none.
+    // Returns false to abandon the query.
+    using Reply = std::function<bool(const QueryRequest&, const QueryResult*, size_t count, uint32_t first, bool last,
+                                     QueryStatus)>;
+
+    ~QueryServer() { stop(); }
+
+    // Before start(); ids empty = every id.
+    void add(CanStorage& buffer, std::mutex& bufferLock, const std::vector<uint32_t>& ids) {
+        buffers.push_back({&buffer, &bufferLock, ids});
+    }
+
+    void start(Reply replyFn) {
+        reply = std::move(replyFn);
+        running = true;
+        worker = std::thread([this] { run(); });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!running) return;
+            running = false;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    // Queues a request; false if QUEUE requests are already waiting.
+    bool submit(const QueryRequest& request) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!running || pending.size() >= QUEUE) return false;
+            pending.push_back(request);
+        }
+        wake.notify_one();
+        return true;
+    }
+
+private:
+    struct Buffer {
+        CanStorage* storage;
+        std::mutex* lock;
+        std::vector<uint32_t> ids;
+    };
+
+    void run() {
+        while (true) {
+            QueryRequest request;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [this] { return !pending.empty() || !running; });
+                if (!running) break;
+                request = pending.front();
+                pending.erase(pending.begin());
+            }
+            execute(request);
+        }
+    }
+
+    void execute(const QueryRequest& request) {
+        const uint32_t limit = request.maxResults && request.maxResults < MAX_RESULTS ? request.maxResults : MAX_RESULTS;
+        const Buffer* buffer = find(request.can_id);
+        if (request.toUs <= request.fromUs || request.bucketUs < 0) {
+            reply(request, nullptr, 0, 0, true, QueryStatus::Rejected);
+            return;
+        }
+        if (buffer == nullptr) {
+            reply(request, nullptr, 0, 0, true, QueryStatus::Ok);
+            return;
+        }
+        CanData samples[SLICE];
+        QueryResult results[SLICE];
+        CanStorage::QueryCursor cursor;
+        QueryResult bucket{request.can_id, 0, 0, 0, 0.0, 0};
+        int64_t sum = 0;
+        uint32_t sent = 0;
+        const auto closeBucket = [&](size_t& n) {
+            bucket.mean = static_cast<double>(sum) / bucket.count;
+            results[n++] = bucket;
+            bucket.count = 0;
+        };
+
+        while (!cursor.done) {
+            size_t count;
+            {
+                std::lock_guard<std::mutex> guard(*buffer->lock);
+                count = buffer->storage->querySamples(request.can_id, request.fromUs, request.toUs, cursor, samples, SLICE);
+            }
+            size_t n = 0;
+            for (size_t i = 0; i < count && sent + n < limit; i++) {
+                const CanData& sample = samples[i];
+                if (request.bucketUs == 0) {
+                    results[n++] = {request.can_id, sample.timestamp + request.offsetUs, sample.value, sample.value,
+                                    static_cast<double>(sample.value), 1};
+                    continue;
+                }
+                // aligned in the requester's time base, so wall-clock minutes start at :00
+                const int64_t time = sample.timestamp + request.offsetUs;
+                const int64_t start = time - floorMod(time, request.bucketUs);
+                if (bucket.count && start != bucket.timestamp) closeBucket(n);
+                if (bucket.count == 0) {
+                    bucket.timestamp = start;
+                    bucket.min = bucket.max = sample.value;
+                    sum = 0;
+                }
+                if (sample.value < bucket.min) bucket.min = sample.value;
+                if (sample.value > bucket.max) bucket.max = sample.value;
+                sum += sample.value;
+                bucket.count++;
+            }
+            const uint32_t first = sent;
+            sent += static_cast<uint32_t>(n);
+            if (sent >= limit) {
+                reply(request, results, n, first, true, QueryStatus::Truncated);
+                return;
+            }
+            if (n && !reply(request, results, n, first, false, QueryStatus::Ok)) return;
+        }
+        size_t n = 0;
+        if (bucket.count) closeBucket(n);
+        reply(request, results, n, sent, true, QueryStatus::Ok);
+    }
+
+    const Buffer* find(uint32_t can_id) const {
+        for (const Buffer& buffer : buffers) {
+            if (buffer.ids.empty() || std::find(buffer.ids.begin(), buffer.ids.end(), can_id) != buffer.ids.end()) {
+                return &buffer;
+            }
+        }
+        return nullptr;
+    }
+
+    static int64_t floorMod(int64_t value, int64_t divisor) {
+        const int64_t mod = value % divisor;
+        return mod < 0 ? mod + divisor : mod;
+    }
+
+    std::vector<Buffer> buffers;
+    Reply reply;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::vector<QueryRequest> pending;
+    bool running = false;
+    std::thread worker;
+};
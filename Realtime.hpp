@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+
+// Real-time setup of the CAN receive path: the ingest thread gets a core of
+// its own at SCHED_FIFO priority with all memory locked, every other thread
+// (storage, upload, DDS, metrics) stays SCHED_OTHER on the remaining cores.
+// Threads inherit affinity and policy from their creator, so the process
+// first moves off the receive core with avoidCpu() before it starts any
+// thread, and the ingest thread claims that core last with pinToCpu().
+
+constexpr size_t RT_STACK_PREFAULT = 256 * 1024;
+
+inline bool setAffinity(const cpu_set_t& set) {
+    const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        errno = rc;
+        perror("pthread_setaffinity_np");
+        return false;
+    }
+    return true;
+}
+
+// Restricts the calling thread, and every thread it starts from now on, to
+// all online CPUs except cpu. No-op on a single core.
+inline bool avoidCpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int i = 0; i < cpus && i < CPU_SETSIZE; i++) {
+        if (i != cpu) CPU_SET(i, &set);
+    }
+    if (CPU_COUNT(&set) == 0) return true;
+    return setAffinity(set);
+}
+
+inline bool pinToCpu(int cpu) {
+    if (cpu < 0 || cpu >= sysconf(_SC_NPROCESSORS_ONLN)) {
+        std::fprintf(stderr, "CPU %d not online\n", cpu);
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return setAffinity(set);
+}
+
+// SCHED_FIFO for the calling thread, needs CAP_SYS_NICE or an RLIMIT_RTPRIO.
+inline bool setFifoPriority(int priority) {
+    struct sched_param param{};
+    param.sched_priority = priority;
+    const int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (rc != 0) {
+        errno = rc;
+        perror("SCHED_FIFO");
+        return false;
+    }
+    return true;
+}
+
+// Locks current and future pages and keeps freed heap mapped, so neither
+// the ingest thread nor SQLite ever takes a page fault after warm-up.
+inline bool lockMemory() {
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        perror("mlockall");
+        return false;
+    }
+    return true;
+}
+
+// Touches RT_STACK_PREFAULT bytes of the calling thread's stack, so its pages
+// are mapped (and locked) before the first deep call in the receive loop.
+__attribute__((noinline)) inline void prefaultStack() {
+    volatile char stack[RT_STACK_PREFAULT];
+    for (size_t i = 0; i < sizeof(stack); i += 4096) stack[i] = 0;
+}
+
+// Asks for bytes of socket receive buffer; SO_RCVBUFFORCE lifts the
+// rmem_max cap where we have CAP_NET_ADMIN. Returns the size the kernel
+// granted (it doubles the request for bookkeeping), 0 on error.
+inline int setReceiveBuffer(int s, int bytes) {
+    if (setsockopt(s, SOL_SOCKET, SO_RCVBUFFORCE, &bytes, sizeof(bytes)) < 0
+        && setsockopt(s, SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes)) < 0) {
+        perror("SO_RCVBUF");
+        return 0;
+    }
+    int granted = 0;
+    socklen_t len = sizeof(granted);
+    getsockopt(s, SOL_SOCKET, SO_RCVBUF, &granted, &len);
+    return granted;
+}
+
+// With SO_RXQ_OVFL every received message carries the socket's running count
+// of frames dropped because its receive queue was full.
+constexpr size_t RX_DROPS_CONTROL_SIZE = CMSG_SPACE(sizeof(uint32_t));
+
+inline bool enableRxDropCount(int s) {
+    const int on = 1;
+    if (setsockopt(s, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on)) < 0) {
+        perror("SO_RXQ_OVFL");
+        return false;
+    }
+    return true;
+}
+
+// Drop counter from the control messages; false if the message has none.
+inline bool rxDropCount(struct msghdr& msg, uint32_t& drops) {
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL) {
+            memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <linux/can.h>
+
+// Cascading min/max/mean/count rollups per CAN id: raw rows feed 1 s
+// buckets, each closed 1 s bucket feeds the 1 min level and each closed
+// 1 min bucket the 1 h level. Buckets are aligned on the monotonic µs
+// timestamps; the clock anchors map them to wall time like raw rows.
+constexpr int ROLLUP_LEVELS = 3;
+constexpr int64_t ROLLUP_WIDTH_US[ROLLUP_LEVELS] = {1000000LL, 60000000LL, 3600000000LL};
+constexpr const char* ROLLUP_TABLES[ROLLUP_LEVELS] = {"can_rollup_1s", "can_rollup_1m", "can_rollup_1h"};
+
+struct RollupRow {
+    uint32_t can_id;
+    int64_t bucket;      // bucket start, monotonic µs
+    int32_t min;
+    int32_t max;
+    int64_t sum;         // mean = sum / count
+    uint32_t count;
+};
+
+// Open bucket of every standard id at every level, allocated once. Extended
+// ids are kept raw only. emit(level, row) is called for each bucket that
+// closes, in level order, so a 1 min row follows the 1 s row that closed it.
+// Buckets of an id only move forward, so (can_id, bucket) is emitted once:
+// a sample stamped before its id's open bucket (a clock step, or stamps from
+// another source) is folded into the open bucket, or dropped if none is
+// open, and counted in late().
+class RollupBuilder {
+public:
+    static constexpr size_t SLOTS = CAN_SFF_MASK + 1;
+
+    // closed buckets keep their start; INT64_MIN = none yet
+    RollupBuilder() : open(ROLLUP_LEVELS * SLOTS, RollupRow{0, INT64_MIN, 0, 0, 0, 0}) {}
+
+    template <typename Emit>
+    void add(uint32_t can_id, int32_t value, int64_t timestamp, Emit emit) {
+        if (can_id >= SLOTS) return;
+        merge(0, {can_id, timestamp, value, value, value, 1}, emit);
+    }
+
+    // Closes buckets that ended more than one width before now, so quiet ids
+    // don't hold their last bucket back forever.
+    template <typename Emit>
+    void flushIdle(int64_t now, Emit emit) {
+        for (int level = 0; level < ROLLUP_LEVELS; level++) {
+            for (size_t slot = 0; slot < SLOTS; slot++) {
+                RollupRow& bucket = at(level, slot);
+                if (bucket.count == 0 || bucket.bucket + 2 * ROLLUP_WIDTH_US[level] > now) continue;
+                close(level, bucket, emit);
+            }
+        }
+    }
+
+    // Late samples since the last call.
+    uint64_t takeLate() {
+        const uint64_t n = late;
+        late = 0;
+        return n;
+    }
+
+private:
+    RollupRow& at(int level, size_t slot) { return open[level * SLOTS + slot]; }
+
+    // Folds a row (raw sample or closed finer bucket) into level's bucket.
+    template <typename Emit>
+    void merge(int level, const RollupRow& row, Emit emit) {
+        const int64_t width = ROLLUP_WIDTH_US[level];
+        const int64_t start = row.bucket - ((row.bucket % width) + width) % width;
+        RollupRow& bucket = at(level, row.can_id);
+        if (start < bucket.bucket || (start == bucket.bucket && bucket.count == 0)) {
+            // its bucket was emitted already
+            late += row.count;
+            if (bucket.count == 0) return;
+        } else if (bucket.count != 0 && bucket.bucket != start) {
+            close(level, bucket, emit);
+        }
+        if (bucket.count == 0) {
+            bucket = row;
+            bucket.bucket = start;
+            return;
+        }
+        if (row.min < bucket.min) bucket.min = row.min;
+        if (row.max > bucket.max) bucket.max = row.max;
+        bucket.sum += row.sum;
+        bucket.count += row.count;
+    }
+
+    template <typename Emit>
+    void close(int level, RollupRow& bucket, Emit emit) {
+        const RollupRow closed = bucket;
+        bucket.count = 0;
+        emit(level, closed);
+        if (level + 1 < ROLLUP_LEVELS) merge(level + 1, closed, emit);
+    }
+
+    std::vector<RollupRow> open;
+    uint64_t late = 0;
+};
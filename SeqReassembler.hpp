@@ -0,0 +1,176 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// CanLogEntry.index of a sample: the storage shard it was uploaded from in
+// the top INDEX_SHARD_BITS, its seq in that shard below, wrapping. Shards
+// number their samples on their own and the upload interleaves them by
+// time, so only indexes of one shard follow each other; receivers
+// reassemble each shard's indexes separately.
+constexpr unsigned INDEX_SHARD_BITS = 2;
+constexpr unsigned INDEX_SEQ_BITS = 32 - INDEX_SHARD_BITS;
+constexpr uint32_t INDEX_SEQ_MASK = (uint32_t{1} << INDEX_SEQ_BITS) - 1;
+
+inline uint32_t sampleIndex(size_t shard, int64_t seq) {
+    return static_cast<uint32_t>(shard) << INDEX_SEQ_BITS | (static_cast<uint32_t>(seq) & INDEX_SEQ_MASK);
+}
+
+inline size_t indexShard(uint32_t index) { return index >> INDEX_SEQ_BITS; }
+
+// Puts samples back in index order and accounts for the ones that never
+// arrive. Indexes are BITS wide and wrap; the distance to the next expected
+// index decides what a sample is:
+//   behind, within WINDOW       duplicate (a replayed chunk) or too late
+//   ahead, within WINDOW        held until the gap before it fills
+//   further ahead or behind     the sender restarted its count, start over
+// A gap is given up on, and counted lost, when a sample arrives more than
+// WINDOW ahead of it or when expire() finds it older than the timeout.
+template <typename Sample, unsigned BITS = 32>
+class SeqReassembler {
+public:
+    static constexpr uint32_t WINDOW = 4096;
+    static constexpr uint32_t MASK = BITS == 32 ? ~uint32_t{0} : (uint32_t{1} << BITS) - 1;
+    static_assert(BITS > 13 && BITS <= 32, "the window must fit the index space");
+
+    struct Stats {
+        uint64_t delivered = 0;
+        uint64_t lost = 0;
+        uint64_t duplicates = 0;
+        uint64_t reordered = 0;   // arrived ahead of a gap and were held
+        uint64_t restarts = 0;
+    };
+
+    SeqReassembler() : slots(WINDOW), present(WINDOW, false) {}
+
+    // emit(const Sample&) is called for every sample that becomes in order.
+    template <typename Emit>
+    void push(uint32_t index, const Sample& sample, int64_t nowUs, Emit emit) {
+        index &= MASK;
+        if (!started) {
+            started = true;
+            next = index;
+        }
+        // index - next in BITS bits, sign-extended
+        const int32_t distance = static_cast<int32_t>((index - next) << (32 - BITS)) >> (32 - BITS);
+        if (distance < 0) {
+            if (distance > -static_cast<int32_t>(WINDOW)) {
+                stats.duplicates++;
+                return;
+            }
+            restart(index, emit);
+        } else if (static_cast<uint32_t>(distance) >= WINDOW) {
+            if (static_cast<uint32_t>(distance) >= 2 * WINDOW) {
+                restart(index, emit);
+            } else {
+                skipTo((index - WINDOW + 1) & MASK, emit);
+            }
+        }
+
+        const uint32_t slot = index % WINDOW;
+        if (index != next) {
+            if (present[slot]) {
+                stats.duplicates++;
+                return;
+            }
+            if (held == 0) gapSince = nowUs;
+            held++;
+            stats.reordered++;
+            slots[slot] = sample;
+            present[slot] = true;
+            return;
+        }
+        deliver(sample, emit);
+        drain(emit);
+    }
+
+    // Gives up on the gap at the head once samples behind it have waited
+    // timeoutUs, delivering them and counting the gap lost.
+    template <typename Emit>
+    void expire(int64_t nowUs, int64_t timeoutUs, Emit emit) {
+        while (held > 0 && nowUs - gapSince >= timeoutUs) {
+            skipGap(emit);
+            gapSince = nowUs;
+        }
+    }
+
+    // Delivers everything held, counting the gaps before it lost; for shutdown.
+    template <typename Emit>
+    void finish(Emit emit) {
+        while (held > 0) skipGap(emit);
+    }
+
+    const Stats& counts() const { return stats; }
+    uint32_t expected() const { return next; }
+    size_t pending() const { return held; }
+
+private:
+    template <typename Emit>
+    void deliver(const Sample& sample, Emit& emit) {
+        emit(sample);
+        stats.delivered++;
+        next = (next + 1) & MASK;
+    }
+
+    template <typename Emit>
+    void drain(Emit& emit) {
+        while (held > 0 && present[next % WINDOW]) {
+            const uint32_t slot = next % WINDOW;
+            present[slot] = false;
+            held--;
+            deliver(slots[slot], emit);
+        }
+    }
+
+    // Counts the gap at the head lost and delivers what follows it.
+    template <typename Emit>
+    void skipGap(Emit& emit) {
+        while (!present[next % WINDOW]) {
+            stats.lost++;
+            next = (next + 1) & MASK;
+        }
+        drain(emit);
+    }
+
+    // Moves the head to index, delivering held samples on the way and
+    // counting the holes lost.
+    template <typename Emit>
+    void skipTo(uint32_t index, Emit& emit) {
+        while (next != index) {
+            const uint32_t slot = next % WINDOW;
+            if (present[slot]) {
+                present[slot] = false;
+                held--;
+                deliver(slots[slot], emit);
+            } else {
+                stats.lost++;
+                next = (next + 1) & MASK;
+            }
+        }
+    }
+
+    // Sender restarted: flush what is held (its gaps are unknowable) and
+    // expect index next.
+    template <typename Emit>
+    void restart(uint32_t index, Emit& emit) {
+        for (uint32_t i = 0; held > 0 && i < WINDOW; i++) {
+            const uint32_t slot = (next + i) % WINDOW;
+            if (!present[slot]) continue;
+            present[slot] = false;
+            held--;
+            emit(slots[slot]);
+            stats.delivered++;
+        }
+        stats.restarts++;
+        next = index;
+    }
+
+    std::vector<Sample> slots;
+    std::vector<bool> present;
+    size_t held = 0;
+    uint32_t next = 0;
+    bool started = false;
+    int64_t gapSince = 0;
+    Stats stats;
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <climits>
+#include <cstdint>
+#include "CanBatch.hpp"
+#include "CanStorage.hpp"
+#include "SeqReassembler.hpp"
+
+constexpr size_t MAX_SHARDS = 4;
+static_assert(MAX_SHARDS <= size_t{1} << INDEX_SHARD_BITS, "every shard needs an index space");
+
+// Upload position in every shard: seq of the last sample taken from each.
+struct ShardCursor {
+    std::array<int64_t, MAX_SHARDS> seq{};
+};
+
+// Merge-on-upload for sharded ingestion: every shard stores into a buffer of
+// its own, under its own lock, and this interleaves them into one stream in
+// timestamp order for the upload pipeline. Each shard is read through a
+// lookahead batch, refilled with one fetch when it runs empty, and the head
+// with the oldest timestamp goes next (ties to the lower shard).
+//
+// A shard's receive thread advances its watermark once everything stamped
+// before it is stored. A drain only takes samples older than the lowest
+// watermark at its start, so a shard that is behind cannot store a sample
+// older than one already sent, and the stream never goes back in time.
+//
+// Each buffer numbers its samples itself, so seqs are only ordered within a
+// shard: a merged sample leaves with seq replaced by its upload index,
+// sampleIndex(shard, seq). Within a shard indexes only go up (a drain after
+// a failed one repeats them from the last commit); those of different
+// shards interleave in time order, and receivers reassemble each shard's
+// indexes on their own. Commit deletes each shard's samples
+// up to the chunk's cursor; the reader, encoder and writer stages are the
+// UploadPipeline's, the merge only runs on its reader thread.
+class ShardMerge {
+public:
+    ShardMerge() = default;
+    ShardMerge(const ShardMerge&) = delete;
+    ShardMerge& operator=(const ShardMerge&) = delete;
+
+    // Before the pipeline starts; lookahead is a free batch of the upload's size.
+    void add(CanStorage& storage, std::mutex& lock, const std::atomic<int64_t>& watermarkUs, CanBatch lookahead) {
+        Lane& lane = lanes[count++];
+        lane.storage = &storage;
+        lane.lock = &lock;
+        lane.watermarkUs = &watermarkUs;
+        lane.rows = std::move(lookahead);
+    }
+
+    size_t shards() const { return count; }
+
+    // Reader thread, at the start of a drain: lookahead is dropped, reading
+    // resumes after what was committed.
+    void begin() {
+        boundUs = INT64_MAX;
+        for (size_t i = 0; i < count; i++) {
+            const int64_t watermark = lanes[i].watermarkUs->load(std::memory_order_acquire);
+            if (watermark < boundUs) boundUs = watermark;
+        }
+        for (size_t i = 0; i < count; i++) {
+            Lane& lane = lanes[i];
+            lane.rows.clear();
+            lane.pos = 0;
+            lane.fetched = lane.committed.load(std::memory_order_relaxed);
+            lane.drained = false;
+        }
+    }
+
+    // Reader thread: fills out with the next samples in timestamp order,
+    // seq set to the upload index; last is after plus the seqs taken. No
+    // rows = drained up to the bound.
+    bool fetch(CanBatch& out, const ShardCursor& after, ShardCursor& last) {
+        out.clear();
+        last = after;
+        while (out.size() < out.capacity()) {
+            size_t next = count;
+            for (size_t i = 0; i < count; i++) {
+                Lane& lane = lanes[i];
+                if (lane.pos == lane.rows.size() && !lane.drained && !refill(lane)) return false;
+                if (lane.pos < lane.rows.size()
+                    && (next == count || lane.rows[lane.pos].timestamp < lanes[next].rows[lanes[next].pos].timestamp)) {
+                    next = i;
+                }
+            }
+            if (next == count) break;
+            const CanData& sample = lanes[next].rows[lanes[next].pos++];
+            out.push({sample.can_id, sample.value, sample.timestamp, sampleIndex(next, sample.seq)});
+            last.seq[next] = sample.seq;
+        }
+        return true;
+    }
+
+    // Writer thread, once a chunk is published.
+    bool commit(const ShardCursor& last) {
+        for (size_t i = 0; i < count; i++) {
+            Lane& lane = lanes[i];
+            if (last.seq[i] <= lane.committed.load(std::memory_order_relaxed)) continue;
+            std::lock_guard<std::mutex> guard(*lane.lock);
+            if (!lane.storage->remove(last.seq[i])) return false;
+            lane.committed.store(last.seq[i], std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+private:
+    struct Lane {
+        CanStorage* storage = nullptr;
+        std::mutex* lock = nullptr;
+        const std::atomic<int64_t>* watermarkUs = nullptr;
+        CanBatch rows;                    // lookahead, rows[pos..] not yet taken
+        size_t pos = 0;
+        int64_t fetched = 0;              // seq of the last sample in rows
+        std::atomic<int64_t> committed{0};
+        bool drained = false;             // nothing left before the bound
+    };
+
+    bool refill(Lane& lane) {
+        std::lock_guard<std::mutex> guard(*lane.lock);
+        lane.pos = 0;
+        const int64_t after = lane.fetched;
+        if (!lane.storage->fetch(lane.rows, after, lane.fetched, boundUs)) return false;
+        lane.drained = lane.rows.empty();
+        return true;
+    }
+
+    std::array<Lane, MAX_SHARDS> lanes;
+    size_t count = 0;
+    int64_t boundUs = INT64_MAX;
+};
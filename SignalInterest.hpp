@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <climits>
+#include "CanDecode.hpp"
+
+// A CAN id from a filter literal, a filter parameter or a partition name:
+// decimal, 0x hex, at most 32 bits, nothing after it.
+inline bool parseInterestId(const std::string& text, uint32_t& can_id) {
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) return false;
+    char* end = nullptr;
+    const unsigned long long value = std::strtoull(text.c_str(), &end, 0);
+    if (*end != '\0' || value > UINT32_MAX) return false;
+    can_id = static_cast<uint32_t>(value);
+    return true;
+}
+
+// Ids a DDS-SQL content filter selects, if it selects by can_id alone:
+// comparisons `can_id = 256`, `can_id = %0` (the value in params) or
+// `256 = can_id`, joined with OR, in parentheses or not. False for any other
+// filter, which can only be read as wanting every id.
+inline bool filterIds(const std::string& expression, const std::vector<std::string>& params,
+                      std::vector<uint32_t>& ids) {
+    std::vector<std::string> tokens;
+    int depth = 0;
+    for (size_t i = 0; i < expression.size();) {
+        const char c = expression[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            i++;
+        } else if (c == '(' || c == ')') {
+            // only ORs, so the grouping changes nothing
+            depth += c == '(' ? 1 : -1;
+            if (depth < 0) return false;
+            i++;
+        } else if (c == '=') {
+            tokens.emplace_back(1, c);
+            i++;
+        } else {
+            size_t j = i;
+            while (j < expression.size()
+                   && (std::isalnum(static_cast<unsigned char>(expression[j])) || expression[j] == '_' || expression[j] == '%')) {
+                j++;
+            }
+            if (j == i) return false;
+            tokens.push_back(expression.substr(i, j - i));
+            i = j;
+        }
+    }
+    if (depth != 0 || tokens.empty()) return false;
+
+    const auto value = [&params](const std::string& token, uint32_t& can_id) {
+        if (token[0] != '%') return parseInterestId(token, can_id);
+        uint32_t index;
+        return parseInterestId(token.substr(1), index) && index < params.size() && parseInterestId(params[index], can_id);
+    };
+    const auto isOr = [](const std::string& token) {
+        return token.size() == 2 && std::toupper(static_cast<unsigned char>(token[0])) == 'O'
+               && std::toupper(static_cast<unsigned char>(token[1])) == 'R';
+    };
+    for (size_t i = 0; i < tokens.size(); i += 4) {
+        if (i + 3 > tokens.size() || tokens[i + 1] != "=") return false;
+        if (i + 3 < tokens.size() && !isOr(tokens[i + 3])) return false;
+        uint32_t can_id;
+        if (!(tokens[i] == "can_id" && value(tokens[i + 2], can_id))
+            && !(tokens[i + 2] == "can_id" && value(tokens[i], can_id))) {
+            return false;
+        }
+        ids.push_back(can_id);
+    }
+    return tokens.size() % 4 == 3;
+}
+
+// Ids of the partitions a reader joined, if every one of them is named
+// prefix + id ("can/0x100"); false otherwise.
+inline bool partitionIds(const std::vector<std::string>& partitions, const std::string& prefix,
+                         std::vector<uint32_t>& ids) {
+    if (prefix.empty() || partitions.empty()) return false;
+    for (const std::string& name : partitions) {
+        uint32_t can_id;
+        if (name.compare(0, prefix.size(), prefix) != 0 || !parseInterestId(name.substr(prefix.size()), can_id)) {
+            return false;
+        }
+        ids.push_back(can_id);
+    }
+    return true;
+}
+
+// Which CAN ids the data topic's matched readers asked for, so the upload
+// only encodes and writes those. A reader asks with a content filter on
+// can_id or by joining partitions named after ids (see filterIds() and
+// partitionIds()), both narrow what it wants; a reader with neither, or with
+// one that can't be read, wants everything. The union over the readers is
+// one bit per standard id, extended ids share one bit as in LimitTable.
+// The buffer is store and forward, so an id stays wanted until no reader has
+// asked for it for the hold time; only then are its rows left out. While no
+// reader is matched nobody can ask, so every id stays wanted.
+class SignalInterest {
+public:
+    static constexpr size_t WORDS = (LimitTable::SLOTS + 63) / 64;
+
+    struct Reader {
+        bool all = true;
+        std::vector<uint32_t> ids;
+
+        // Keeps the ids that are in both, the reader asked for both.
+        void narrow(std::vector<uint32_t> to) {
+            std::sort(to.begin(), to.end());
+            if (!all) {
+                std::vector<uint32_t> both;
+                std::sort(ids.begin(), ids.end());
+                std::set_intersection(ids.begin(), ids.end(), to.begin(), to.end(), std::back_inserter(both));
+                to.swap(both);
+            }
+            ids.swap(to);
+            all = false;
+        }
+    };
+
+    SignalInterest() {
+        std::fill(words, words + WORDS, ~uint64_t{0});
+        std::fill(wantedNs, wantedNs + LimitTable::SLOTS, INT64_MAX);
+    }
+
+    bool wants(uint32_t can_id) const {
+        const size_t slot = LimitTable::slot(can_id);
+        return (words[slot / 64] >> (slot % 64) & 1) != 0;
+    }
+
+    // Takes what the readers ask for now; no readers keeps every id. An id
+    // is wanted if some reader asked for it within holdNs of nowNs, holdNs
+    // 0 keeps every id. Returns the ids the readers ask for,
+    // LimitTable::SLOTS if all.
+    size_t set(const std::vector<Reader>& readers, int64_t nowNs, int64_t holdNs) {
+        uint64_t asked[WORDS] = {};
+        for (const Reader& reader : readers) {
+            if (reader.all) {
+                std::fill(asked, asked + WORDS, ~uint64_t{0});
+                break;
+            }
+            for (uint32_t can_id : reader.ids) {
+                const size_t slot = LimitTable::slot(can_id);
+                asked[slot / 64] |= uint64_t{1} << (slot % 64);
+            }
+        }
+        if (readers.empty()) std::fill(asked, asked + WORDS, ~uint64_t{0});
+        size_t count = 0;
+        std::fill(words, words + WORDS, 0);
+        for (size_t slot = 0; slot < LimitTable::SLOTS; slot++) {
+            if (asked[slot / 64] >> (slot % 64) & 1) {
+                wantedNs[slot] = nowNs;
+                count++;
+            } else if (wantedNs[slot] == INT64_MAX) {
+                wantedNs[slot] = nowNs;    // the hold starts with the first readers
+            }
+            if (holdNs <= 0 || nowNs - wantedNs[slot] < holdNs) words[slot / 64] |= uint64_t{1} << (slot % 64);
+        }
+        return count;
+    }
+
+private:
+    uint64_t words[WORDS];
+    int64_t wantedNs[LimitTable::SLOTS];   // last time a reader asked for the id
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <linux/can.h>
+
+enum class SignalSource { Ecu, Scales };
+
+// Wire layout of one signal: a big-endian integer of `bytes` bytes from data
+// byte `offset` of the `dlc`-byte frame `can_id`; the value is the integer
+// plus `bias` (J1939 style, so one unsigned byte carries -40..215 °C).
+struct SignalDef {
+    uint32_t can_id;
+    uint8_t dlc;
+    uint8_t offset;
+    uint8_t bytes;
+    bool isSigned;
+    int32_t bias;
+    SignalSource source;               // which mock sends it
+    int32_t mockMin;                   // range the mock draws from
+    int32_t mockMax;
+    const char* name;
+    const char* unit;
+};
+
+// Every signal the mocks send and the logger decodes. A new signal is one
+// line here: ecu_mock/scales_mock encode it, decodeFrame() and the SIMD
+// kernels unpack it and the default signal names come from it.
+inline constexpr std::array SIGNALS = {
+    SignalDef{0x100, 2, 0, 2, false, 0, SignalSource::Ecu, 800, 6500, "Engine RPM", "RPM"},
+    SignalDef{0x101, 1, 0, 1, false, -40, SignalSource::Ecu, -40, 120, "Coolant Temperature", "°C"},
+    SignalDef{0x102, 1, 0, 1, false, -40, SignalSource::Ecu, -30, 150, "Engine Oil Temperature", "°C"},
+    SignalDef{0x103, 2, 0, 2, false, 0, SignalSource::Ecu, 0, 700, "Engine Oil Pressure", "kPa"},
+    SignalDef{0x104, 1, 0, 1, false, -40, SignalSource::Ecu, -20, 140, "Hydraulic Oil Temperature", "°C"},
+    SignalDef{0x105, 2, 0, 2, false, 0, SignalSource::Ecu, 0, 600, "Hydraulic Oil Pressure", "bar"},
+    SignalDef{0x200, 2, 0, 2, false, 0, SignalSource::Scales, 10000, 25000, "Scoop Bucket Load Weight", "kg"},
+};
+
+using SignalIndices = std::make_index_sequence<SIGNALS.size()>;
+
+constexpr bool signalFieldsFit(const SignalDef& s) {
+    return s.can_id <= CAN_SFF_MASK && s.bytes >= 1 && s.bytes <= 4 && s.dlc <= CAN_MAX_DLEN
+           && s.offset + s.bytes <= s.dlc;
+}
+
+// Raw integer range of the field, and the mock's range shifted by the bias
+// has to lie in it.
+constexpr bool signalRangeFits(const SignalDef& s) {
+    const int64_t span = int64_t{1} << (8 * s.bytes);
+    const int64_t low = s.isSigned ? -span / 2 : 0, high = s.isSigned ? span / 2 - 1 : span - 1;
+    return s.mockMin <= s.mockMax && int64_t{s.mockMin} - s.bias >= low && int64_t{s.mockMax} - s.bias <= high;
+}
+
+// Two signals of one frame must agree on its length and not share a byte.
+constexpr bool signalsOverlap(const SignalDef& a, const SignalDef& b) {
+    return a.can_id == b.can_id
+           && (a.dlc != b.dlc || (a.offset < b.offset + b.bytes && b.offset < a.offset + a.bytes));
+}
+
+template <size_t N>
+constexpr bool signalTableValid(const std::array<SignalDef, N>& table, bool (*check)(const SignalDef&)) {
+    for (const SignalDef& s : table) {
+        if (!check(s)) return false;
+    }
+    return true;
+}
+
+template <size_t N>
+constexpr bool signalLayoutsDisjoint(const std::array<SignalDef, N>& table) {
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = i + 1; j < N; j++) {
+            if (signalsOverlap(table[i], table[j])) return false;
+        }
+    }
+    return true;
+}
+
+template <size_t N>
+constexpr bool signalIdsUnique(const std::array<SignalDef, N>& table) {
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = i + 1; j < N; j++) {
+            if (table[i].can_id == table[j].can_id) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(signalTableValid(SIGNALS, signalFieldsFit), "signal field outside its frame, or not 1-4 bytes");
+static_assert(signalTableValid(SIGNALS, signalRangeFits), "signal mock range does not fit its field");
+static_assert(signalLayoutsDisjoint(SIGNALS), "signals overlap in a frame");
+static_assert(signalIdsUnique(SIGNALS), "one signal per CAN id: the buffer keys values by id");
+
+// Calls f(std::integral_constant<size_t, I>) for every signal, in table
+// order, so f can use SIGNALS[I] as a constant.
+template <typename F, size_t... I>
+constexpr void forEachSignal(F&& f, std::index_sequence<I...>) {
+    (f(std::integral_constant<size_t, I>{}), ...);
+}
+
+template <typename F>
+constexpr void forEachSignal(F&& f) {
+    forEachSignal(f, SignalIndices{});
+}
+
+// Fills a frame with signal I at value, the unused bytes zero.
+template <size_t I>
+inline void encodeSignal(struct can_frame& frame, int32_t value) {
+    constexpr SignalDef s = SIGNALS[I];
+    const uint32_t raw = static_cast<uint32_t>(value - s.bias);
+    frame = {};
+    frame.can_id = s.can_id;
+    frame.can_dlc = s.dlc;
+    for (size_t b = 0; b < s.bytes; b++) {
+        frame.data[s.offset + b] = static_cast<uint8_t>(raw >> (8 * (s.bytes - 1 - b)));
+    }
+}
+
+// Signal I from a frame that carries it: all eight data bytes as one
+// big-endian word, the field shifted to the top and back down, arithmetic
+// for signed fields; no branch, the shifts are constants.
+template <size_t I>
+inline int32_t unpackSignal(const struct can_frame& frame) {
+    constexpr SignalDef s = SIGNALS[I];
+    uint64_t word;
+    memcpy(&word, frame.data, sizeof(word));
+    word = __builtin_bswap64(word) << (8 * s.offset);
+    int64_t raw;
+    if constexpr (s.isSigned) raw = static_cast<int64_t>(word) >> (64 - 8 * s.bytes);
+    else raw = static_cast<int64_t>(word >> (64 - 8 * s.bytes));
+    return static_cast<int32_t>(raw + s.bias);
+}
+
+// Signals unpacked the same way share the code for it: each belongs to the
+// first signal of the table with its layout.
+constexpr size_t signalLayout(size_t i) {
+    for (size_t j = 0; j < i; j++) {
+        const SignalDef& a = SIGNALS[i];
+        const SignalDef& b = SIGNALS[j];
+        if (a.offset == b.offset && a.bytes == b.bytes && a.isSigned == b.isSigned && a.bias == b.bias) return j;
+    }
+    return i;
+}
+
+template <size_t I>
+inline constexpr canid_t signalId = SIGNALS[I].can_id;
+
+// True if id is one of the signals with layout L, compares against constants.
+template <size_t L, size_t... I>
+inline bool idHasLayout(canid_t id, std::index_sequence<I...>) {
+    return ((signalLayout(I) == L && id == signalId<I>) || ...);
+}
+
+// Unpacks signal I; valid is false if the frame is too short for it.
+template <size_t I>
+inline bool unpackInto(const struct can_frame& frame, int32_t& value, bool& valid) {
+    constexpr SignalDef s = SIGNALS[I];
+    value = unpackSignal<I>(frame);
+    valid = frame.can_dlc >= s.offset + s.bytes;
+    return true;
+}
+
+// One compare chain on the id against the table's constants, branching to
+// one unpack per layout, which the compiler turns into the switch one would
+// write by hand. False if the id has no signal.
+template <size_t... I>
+inline bool unpackKnown(const struct can_frame& frame, int32_t& value, bool& valid, std::index_sequence<I...> all) {
+    const canid_t id = frame.can_id;
+    return ((signalLayout(I) == I && idHasLayout<I>(id, all) && unpackInto<I>(frame, value, valid)) || ...);
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sqlite3.h>
+
+// Recycling size-class allocator for SQLite (SQLITE_CONFIG_MALLOC).
+// Distribution builds of SQLite are often compiled with OMIT_LOOKASIDE, so
+// every sqlite3_step() mallocs cursors and record buffers. Freed blocks are
+// kept on per-class free lists instead of going back to the system heap, so
+// after warm-up the insert/select/delete cycle reuses the same blocks and the
+// heap doesn't fragment over long uptimes. The lists are split into arenas,
+// each under its own lock: a thread allocates from the arena it picked with
+// useArena() (0 unless it did), and a block goes back to the arena it came
+// from, so threads on different arenas (the shards' receive threads) never
+// wait for each other.
+class SqliteMemPool {
+public:
+    static constexpr int SUB_BITS = 2;                 // 4 classes per power of two
+    static constexpr int MIN_SHIFT = 4;                // smallest class 16 bytes
+    static constexpr int MAX_SHIFT = 17;               // largest pooled block 128 KiB
+    static constexpr int CLASSES = (MAX_SHIFT - MIN_SHIFT + 1) << SUB_BITS;
+    static constexpr uint32_t UNPOOLED = 0xFFFFFFFF;
+    static constexpr size_t ARENAS = 8;
+
+    // Must run before the first sqlite3_open()
+    static bool install() {
+        static sqlite3_mem_methods methods = {
+            xMalloc, xFree, xRealloc, xSize, xRoundup, xInit, xShutdown, nullptr
+        };
+        return sqlite3_config(SQLITE_CONFIG_MALLOC, &methods) == SQLITE_OK;
+    }
+
+    // Arena of the calling thread's allocations from now on, modulo ARENAS.
+    static void useArena(size_t arena) { threadArena() = arena % ARENAS; }
+
+    // Blocks obtained from the system heap so far; flat in steady state.
+    static uint64_t systemAllocs() { return state().systemAllocs.load(std::memory_order_relaxed); }
+
+    static uint32_t classOf(size_t size) {
+        if (size <= (size_t{1} << MIN_SHIFT)) return 0;
+        const int msb = 63 - __builtin_clzll(size - 1);
+        if (msb >= MAX_SHIFT) return UNPOOLED;
+        const int shift = msb - SUB_BITS;
+        const uint32_t sub = static_cast<uint32_t>((size - 1) >> shift) & ((1u << SUB_BITS) - 1);
+        return ((msb - MIN_SHIFT) << SUB_BITS) + sub + 1;
+    }
+
+    static size_t classSize(uint32_t cls) {
+        if (cls == 0) return size_t{1} << MIN_SHIFT;
+        const int msb = static_cast<int>((cls - 1) >> SUB_BITS) + MIN_SHIFT;
+        const size_t sub = (cls - 1) & ((1u << SUB_BITS) - 1);
+        return ((size_t{1} << SUB_BITS) + sub + 1) << (msb - SUB_BITS);
+    }
+
+private:
+    // 8-byte header keeps payload 8-byte aligned, as SQLite requires
+    struct Header {
+        uint16_t cls;        // UNPOOLED_BLOCK if from the system heap
+        uint16_t arena;
+        uint32_t size;
+    };
+
+    static constexpr uint16_t UNPOOLED_BLOCK = 0xFFFF;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct alignas(64) Arena {
+        std::mutex lock;
+        FreeBlock* freeLists[CLASSES] = {};
+    };
+
+    struct State {
+        Arena arenas[ARENAS];
+        std::atomic<uint64_t> systemAllocs{0};
+    };
+
+    static State& state() {
+        static State instance;
+        return instance;
+    }
+
+    static size_t& threadArena() {
+        thread_local size_t arena = 0;
+        return arena;
+    }
+
+    static void* xMalloc(int n) {
+        if (n <= 0) return nullptr;
+        const uint32_t cls = classOf(static_cast<size_t>(n));
+        State& st = state();
+        const size_t arena = threadArena();
+        if (cls != UNPOOLED) {
+            Arena& pool = st.arenas[arena];
+            std::lock_guard<std::mutex> guard(pool.lock);
+            if (FreeBlock* block = pool.freeLists[cls]) {
+                pool.freeLists[cls] = block->next;
+                // the header below it still names this class and arena
+                return block;
+            }
+        }
+        const size_t size = cls == UNPOOLED ? static_cast<size_t>(n) : classSize(cls);
+        Header* header = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+        if (header == nullptr) return nullptr;
+        st.systemAllocs.fetch_add(1, std::memory_order_relaxed);
+        header->cls = cls == UNPOOLED ? UNPOOLED_BLOCK : static_cast<uint16_t>(cls);
+        header->arena = static_cast<uint16_t>(arena);
+        header->size = static_cast<uint32_t>(size);
+        return header + 1;
+    }
+
+    static void xFree(void* p) {
+        if (p == nullptr) return;
+        Header* header = static_cast<Header*>(p) - 1;
+        if (header->cls == UNPOOLED_BLOCK) {
+            std::free(header);
+            return;
+        }
+        Arena& pool = state().arenas[header->arena];
+        std::lock_guard<std::mutex> guard(pool.lock);
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = pool.freeLists[header->cls];
+        pool.freeLists[header->cls] = block;
+    }
+
+    static void* xRealloc(void* p, int n) {
+        if (p == nullptr) return xMalloc(n);
+        if (n <= 0) {
+            xFree(p);
+            return nullptr;
+        }
+        const Header* header = static_cast<Header*>(p) - 1;
+        if (static_cast<size_t>(n) <= header->size) return p;
+        void* grown = xMalloc(n);
+        if (grown == nullptr) return nullptr;
+        std::memcpy(grown, p, header->size);
+        xFree(p);
+        return grown;
+    }
+
+    static int xSize(void* p) {
+        return p ? static_cast<int>((static_cast<Header*>(p) - 1)->size) : 0;
+    }
+
+    static int xRoundup(int n) {
+        const uint32_t cls = classOf(static_cast<size_t>(n));
+        return cls == UNPOOLED ? (n + 7) & ~7 : static_cast<int>(classSize(cls));
+    }
+
+    static int xInit(void*) { return SQLITE_OK; }
+    static void xShutdown(void*) {}
+};
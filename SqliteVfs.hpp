@@ -0,0 +1,644 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sqlite3.h>
+#include <zlib.h>
+#include "IoUring.hpp"
+
+// Counters of the logger VFS over all files, for metrics and benchmarks.
+// Write amplification is physicalBytes / logicalBytes.
+struct LoggerVfsStats {
+    std::atomic<uint64_t> writes{0};          // xWrite calls from SQLite
+    std::atomic<uint64_t> logicalBytes{0};    // bytes SQLite asked to write
+    std::atomic<uint64_t> physicalBytes{0};   // bytes written to the files: gap fills added, compression saved
+    std::atomic<uint64_t> databaseLogical{0}; // the database's share of both, the WAL's is the rest
+    std::atomic<uint64_t> databasePhysical{0};
+    std::atomic<uint64_t> extents{0};         // writes issued to the kernel after merging
+    std::atomic<uint64_t> blocks{0};          // erase blocks written into by a database flush
+    std::atomic<uint64_t> fillBytes{0};       // unchanged bytes rewritten to close gaps inside a block
+    std::atomic<uint64_t> pagesCompressed{0};
+    std::atomic<uint64_t> flushes{0};         // batches handed over
+    std::atomic<uint64_t> syncs{0};           // fsyncs, linked behind a batch or alone
+    std::atomic<uint64_t> enters{0};          // io_uring_enter() calls
+};
+
+inline LoggerVfsStats loggerVfsStats;
+
+struct LoggerVfsOptions {
+    bool ring = false;              // io_uring writes, else pwrite()
+    size_t eraseBlock = 0;          // database pages coalesced per aligned block of this many bytes, 0 = off
+    bool compressPages = false;     // database pages deflated within their slot
+};
+
+// SQLite VFS "canlogger" for the disk-backed buffer: a shim over the default
+// (unix) VFS that batches writes for flash storage.
+//
+// The write-ahead log: SQLite writes each WAL frame as two xWrite() calls,
+// 24-byte header then page, so a transaction costs a pwrite() per frame
+// half. Here WAL writes are copied to a staging buffer, contiguous ones
+// merged into extents, and handed to the kernel when the frame carrying the
+// commit mark (nonzero database size in its header) has been written: as
+// one chain of io_uring writes and a single io_uring_enter(), or pwrite()
+// per extent without io_uring. xSync() links an fsync behind the pending
+// writes in the same chain. The batch is in the file before xWrite()
+// returns to SQLite, which only then publishes the commit in the WAL index,
+// so readers and crash recovery see what they did before.
+//
+// The database, with eraseBlock or compressPages set: a checkpoint copies
+// pages from the WAL in page order and syncs at the end. Pages are staged
+// until that xSync(), a lock release or a full stage, then written sorted
+// and grouped by erase block: never a write across a block boundary, and
+// dirty pages of one block separated by at most an eighth of it of clean
+// ones are written as one extent, the gap read back from the file. So the
+// flash translation layer sees whole-block rewrites instead of scattered
+// 4 KiB updates. With compressPages, every page but the first (SQLite
+// reads its header directly) is deflated and, when that saves a
+// sector, stored at the front of its own slot behind a 0xFFFFFFFF marker a
+// valid page never starts with, written rounded to sectors; reads inflate
+// it, compressPages set or not. Offsets stay those of SQLite's pages, so no
+// mapping table has to be kept crash-safe; memory mapping is refused. Only
+// connections through this VFS can read such a file.
+//
+// Reads, size and truncate calls flush first. Every other file is the
+// default VFS's untouched.
+class LoggerVfs {
+public:
+    static constexpr const char* NAME = "canlogger";
+    static constexpr size_t STAGE_BYTES = 256 * 1024;     // per WAL, flushed early when full
+    static constexpr size_t MAX_EXTENTS = 16;
+    static constexpr unsigned RING_ENTRIES = 32;          // MAX_EXTENTS writes and the fsync
+    static constexpr size_t DB_STAGE_BYTES = 1024 * 1024; // per database
+    static constexpr size_t MAX_ERASE_BLOCK = 4 * 1024 * 1024;
+    static constexpr size_t SECTOR = 512;
+
+    // Registers the VFS as default, so CanStorage's sqlite3_open() picks it
+    // up. After SqliteMemPool::install() (this initializes SQLite), before
+    // the first sqlite3_open(). Installing again switches files opened
+    // from then on.
+    static bool install(const LoggerVfsOptions& with) {
+        static sqlite3_vfs vfs;
+        options = with;
+        options.eraseBlock = std::min(options.eraseBlock / SECTOR * SECTOR, MAX_ERASE_BLOCK);
+        sqlite3_vfs* real = sqlite3_vfs_find(nullptr);
+        if (real == nullptr) return false;
+        if (real == &vfs) return true;
+        vfs = {};
+        vfs.iVersion = 2;
+        vfs.szOsFile = static_cast<int>(sizeof(File)) + real->szOsFile;
+        vfs.mxPathname = real->mxPathname;
+        vfs.zName = NAME;
+        vfs.pAppData = real;
+        vfs.xOpen = open;
+        vfs.xDelete = [](sqlite3_vfs* v, const char* name, int syncDir) { return base(v)->xDelete(base(v), name, syncDir); };
+        vfs.xAccess = [](sqlite3_vfs* v, const char* name, int flags, int* out) {
+            return base(v)->xAccess(base(v), name, flags, out);
+        };
+        vfs.xFullPathname = [](sqlite3_vfs* v, const char* name, int n, char* out) {
+            return base(v)->xFullPathname(base(v), name, n, out);
+        };
+        vfs.xDlOpen = [](sqlite3_vfs* v, const char* name) { return base(v)->xDlOpen(base(v), name); };
+        vfs.xDlError = [](sqlite3_vfs* v, int n, char* out) { base(v)->xDlError(base(v), n, out); };
+        vfs.xDlSym = [](sqlite3_vfs* v, void* lib, const char* sym) { return base(v)->xDlSym(base(v), lib, sym); };
+        vfs.xDlClose = [](sqlite3_vfs* v, void* lib) { base(v)->xDlClose(base(v), lib); };
+        vfs.xRandomness = [](sqlite3_vfs* v, int n, char* out) { return base(v)->xRandomness(base(v), n, out); };
+        vfs.xSleep = [](sqlite3_vfs* v, int us) { return base(v)->xSleep(base(v), us); };
+        vfs.xCurrentTime = [](sqlite3_vfs* v, double* out) { return base(v)->xCurrentTime(base(v), out); };
+        vfs.xGetLastError = [](sqlite3_vfs* v, int n, char* out) { return base(v)->xGetLastError(base(v), n, out); };
+        vfs.xCurrentTimeInt64 = [](sqlite3_vfs* v, sqlite3_int64* out) {
+            return base(v)->xCurrentTimeInt64(base(v), out);
+        };
+        return sqlite3_vfs_register(&vfs, 1) == SQLITE_OK;
+    }
+
+private:
+    struct Extent {
+        int64_t offset;
+        size_t pos;                       // in the staging buffer
+        size_t length;
+    };
+
+    struct Page {
+        int64_t offset;
+        uint32_t pos;                     // in the staging buffer
+        uint32_t seq;                     // write order, the last write of a page wins
+    };
+
+    // A WAL or database handle; the default VFS's file follows it in the
+    // same allocation.
+    struct File {
+        sqlite3_file file;                // pMethods = walMethods or dbMethods
+        sqlite3_file* real = nullptr;
+        int fd = -1;                      // own descriptor for the batched writes
+        IoUring ring;
+        std::unique_ptr<char[]> stage;
+        size_t staged = 0;
+        bool synced = false;              // the first xSync() goes to the default VFS
+        // WAL
+        std::array<Extent, MAX_EXTENTS> extents;
+        size_t extentCount = 0;
+        bool commitFrame = false;         // flush after the next write, the commit frame's page
+        // database
+        std::unique_ptr<Page[]> pages;
+        size_t pageCount = 0;
+        uint32_t seq = 0;
+        size_t pageSize = 0;              // from the header, 0 until known
+        size_t eraseBlock = 0;
+        std::unique_ptr<char[]> out;      // assembled blocks, compressed pages, read scratch
+        size_t outBytes = 0;
+        bool compress = false;
+        z_stream deflater{};
+        z_stream inflater{};
+    };
+
+    // Issues one flush's writes: chained on the ring and run when the
+    // submission queue is full or drain() is called, else pwrite() each.
+    class Writer {
+    public:
+        explicit Writer(File* f) : f(f), chain(f->ring), enters(f->ring.enters) {}
+
+        void write(const char* data, size_t length, int64_t offset) {
+            if (error) return;
+            loggerVfsStats.extents.fetch_add(1, std::memory_order_relaxed);
+            loggerVfsStats.physicalBytes.fetch_add(length, std::memory_order_relaxed);
+            if (f->pages) loggerVfsStats.databasePhysical.fetch_add(length, std::memory_order_relaxed);
+            if (!f->ring.active()) {
+                if (!writeAll(f->fd, data, length, offset)) error = errno;
+                return;
+            }
+            if (chain.write(f->fd, data, length, offset)) return;
+            drain();
+            if (!error) chain.write(f->fd, data, length, offset);
+        }
+
+        // Waits for the queued writes, so the memory behind them can be reused.
+        void drain() {
+            const int failed = chain.run();
+            if (!error) error = failed;
+        }
+
+        int finish(bool sync, bool dataOnly) {
+            if (f->ring.active()) {
+                if (sync && !error && !chain.fsync(f->fd, dataOnly)) {
+                    drain();
+                    chain.fsync(f->fd, dataOnly);
+                }
+                drain();
+                loggerVfsStats.enters.fetch_add(f->ring.enters - enters, std::memory_order_relaxed);
+            } else if (sync && !error && (dataOnly ? fdatasync(f->fd) : fsync(f->fd)) < 0) {
+                error = errno;
+            }
+            return error;
+        }
+
+    private:
+        File* f;
+        LinkedWrites chain;
+        uint64_t enters;
+        int error = 0;
+    };
+
+    static inline LoggerVfsOptions options;
+
+    static sqlite3_vfs* base(sqlite3_vfs* vfs) { return static_cast<sqlite3_vfs*>(vfs->pAppData); }
+    static File* self(sqlite3_file* file) { return reinterpret_cast<File*>(file); }
+    static sqlite3_file* real(sqlite3_file* file) { return self(file)->real; }
+
+    static int open(sqlite3_vfs* vfs, const char* name, sqlite3_file* file, int flags, int* outFlags) {
+        sqlite3_vfs* inner = base(vfs);
+        const bool wal = (flags & SQLITE_OPEN_WAL) != 0;
+        const bool database = (flags & SQLITE_OPEN_MAIN_DB) && (flags & SQLITE_OPEN_READWRITE)
+            && (options.eraseBlock || options.compressPages);
+        if (!(wal || database) || name == nullptr) return inner->xOpen(inner, name, file, flags, outFlags);
+
+        File* f = new (file) File;
+        f->file.pMethods = nullptr;
+        f->real = reinterpret_cast<sqlite3_file*>(reinterpret_cast<char*>(file) + sizeof(File));
+        int rc = inner->xOpen(inner, name, f->real, flags, outFlags);
+        if (rc == SQLITE_OK) {
+            // a database descriptor is closed with the handle, so its close
+            // drops no POSIX lock another connection still needs: CanStorage
+            // opens each database once per process
+            f->fd = ::open(name, (wal ? O_WRONLY : O_RDWR) | O_CLOEXEC);
+            if (f->fd < 0) rc = SQLITE_CANTOPEN;
+        }
+        if (rc == SQLITE_OK && database) rc = openDatabase(f);
+        if (rc != SQLITE_OK) {
+            if (f->fd >= 0) ::close(f->fd);
+            if (f->real->pMethods != nullptr) f->real->pMethods->xClose(f->real);
+            f->~File();
+            file->pMethods = nullptr;
+            return rc;
+        }
+        if (wal) f->stage.reset(new char[STAGE_BYTES]);
+        if (options.ring && !f->ring.open(RING_ENTRIES)) {
+            perror("io_uring_setup, logger VFS writes with pwrite()");
+            options.ring = false;
+        }
+        f->file.pMethods = wal ? &walMethods : &dbMethods;
+        return SQLITE_OK;
+    }
+
+    static int openDatabase(File* f) {
+        sqlite3_int64 size = 0;
+        unsigned char header[100];
+        if (f->real->pMethods->xFileSize(f->real, &size) == SQLITE_OK && size >= 100
+            && f->real->pMethods->xRead(f->real, header, sizeof(header), 0) == SQLITE_OK) {
+            f->pageSize = headerPageSize(header);
+        }
+        // raw deflate with a 4 KiB window: 16 KiB of state, no allocation
+        // per page after this; pages read are inflated whether or not
+        // compressPages is still set
+        if (inflateInit2(&f->inflater, -12) != Z_OK) return SQLITE_NOMEM;
+        if (options.compressPages) {
+            if (deflateInit2(&f->deflater, 1, Z_DEFLATED, -12, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                inflateEnd(&f->inflater);
+                return SQLITE_NOMEM;
+            }
+            f->compress = true;
+        }
+        f->eraseBlock = options.eraseBlock;
+        f->stage.reset(new char[DB_STAGE_BYTES]);
+        f->pages.reset(new Page[DB_STAGE_BYTES / SECTOR]);
+        f->outBytes = DB_STAGE_BYTES + std::max<size_t>(f->eraseBlock, 2 * 65536);
+        f->out.reset(new char[f->outBytes]);
+        return SQLITE_OK;
+    }
+
+    static size_t headerPageSize(const unsigned char* header) {
+        if (memcmp(header, "SQLite format 3", 16) != 0) return 0;
+        const size_t size = header[16] << 8 | header[17];
+        return size == 1 ? 65536 : size;
+    }
+
+    static int flush(File* f, bool sync, bool dataOnly) {
+        return f->pages ? flushPages(f, sync, dataOnly) : flushExtents(f, sync, dataOnly);
+    }
+
+    static int result(int error, bool sync) {
+        if (!error) return SQLITE_OK;
+        errno = error;
+        return sync ? SQLITE_IOERR_FSYNC : SQLITE_IOERR_WRITE;
+    }
+
+    // Hands the staged WAL extents to the kernel, with an fsync linked
+    // behind them when sync is set.
+    static int flushExtents(File* f, bool sync, bool dataOnly) {
+        if (f->extentCount == 0 && !sync) return SQLITE_OK;
+        loggerVfsStats.flushes.fetch_add(1, std::memory_order_relaxed);
+        if (sync) loggerVfsStats.syncs.fetch_add(1, std::memory_order_relaxed);
+        Writer writer(f);
+        for (size_t i = 0; i < f->extentCount; i++) {
+            const Extent& extent = f->extents[i];
+            writer.write(f->stage.get() + extent.pos, extent.length, extent.offset);
+        }
+        f->staged = 0;
+        f->extentCount = 0;
+        return result(writer.finish(sync, dataOnly), sync);
+    }
+
+    // Writes the staged database pages in offset order, block by block.
+    static int flushPages(File* f, bool sync, bool dataOnly) {
+        if (f->pageCount == 0 && !sync) return SQLITE_OK;
+        loggerVfsStats.flushes.fetch_add(1, std::memory_order_relaxed);
+        if (sync) loggerVfsStats.syncs.fetch_add(1, std::memory_order_relaxed);
+        Page* pages = f->pages.get();
+        std::sort(pages, pages + f->pageCount, [](const Page& a, const Page& b) {
+            return a.offset != b.offset ? a.offset < b.offset : a.seq < b.seq;
+        });
+        size_t count = 0;
+        for (size_t i = 0; i < f->pageCount; i++) {
+            if (count > 0 && pages[count - 1].offset == pages[i].offset) pages[count - 1] = pages[i];
+            else pages[count++] = pages[i];
+        }
+
+        const int64_t pageSize = static_cast<int64_t>(f->pageSize);
+        const int64_t block = f->eraseBlock ? static_cast<int64_t>(f->eraseBlock) : pageSize;
+        const int64_t maxGap = f->compress ? 0 : static_cast<int64_t>(f->eraseBlock) / 8;
+        const char* stage = f->stage.get();
+        char* out = f->out.get();
+        size_t used = 0;
+        Writer writer(f);
+        for (size_t i = 0; i < count;) {
+            const int64_t blockEnd = (pages[i].offset / block + 1) * block;
+            size_t end = i;
+            while (end < count && pages[end].offset < blockEnd) end++;
+            if (f->eraseBlock) loggerVfsStats.blocks.fetch_add(1, std::memory_order_relaxed);
+            if (used + static_cast<size_t>(std::max(block, pageSize)) > f->outBytes) {
+                writer.drain();
+                used = 0;
+            }
+            if (f->compress) {
+                for (; i < end; i++) {
+                    const size_t length = compressPage(f, stage + pages[i].pos, out + used, pages[i].offset);
+                    writer.write(out + used, length, pages[i].offset);
+                    used += length;
+                }
+                continue;
+            }
+            while (i < end) {
+                const int64_t start = pages[i].offset;
+                char* extent = out + used;
+                int64_t next = start;
+                for (; i < end && pages[i].offset - next <= maxGap; i++) {
+                    const int64_t gap = pages[i].offset - next;
+                    if (gap > 0 && !readGap(f, extent + (next - start), static_cast<size_t>(gap), next)) break;
+                    memcpy(extent + (pages[i].offset - start), stage + pages[i].pos, f->pageSize);
+                    next = pages[i].offset + pageSize;
+                }
+                writer.write(extent, static_cast<size_t>(next - start), start);
+                used += static_cast<size_t>(next - start);
+            }
+        }
+        f->staged = 0;
+        f->pageCount = 0;
+        return result(writer.finish(sync, dataOnly), sync);
+    }
+
+    // Clean bytes between two dirty pages of a block, read back so the
+    // block goes out as one extent; zeros past the end of the file.
+    static bool readGap(File* f, char* data, size_t length, int64_t offset) {
+        size_t done = 0;
+        while (done < length) {
+            const ssize_t n = pread(f->fd, data + done, length - done, offset + static_cast<int64_t>(done));
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) return false;
+            if (n == 0) break;
+            done += static_cast<size_t>(n);
+        }
+        memset(data + done, 0, length - done);
+        loggerVfsStats.fillBytes.fetch_add(length, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Page image for its slot at offset: deflated behind the marker and
+    // length when that saves a sector, else the page as is. Returns the
+    // bytes to write.
+    static size_t compressPage(File* f, const char* page, char* slot, int64_t offset) {
+        const size_t pageSize = f->pageSize;
+        if (offset != 0 && pageSize >= 4 * SECTOR) {
+            z_stream& z = f->deflater;
+            deflateReset(&z);
+            z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(page));
+            z.avail_in = static_cast<uInt>(pageSize);
+            z.next_out = reinterpret_cast<Bytef*>(slot + 6);
+            z.avail_out = static_cast<uInt>(pageSize - 6 - SECTOR);
+            if (deflate(&z, Z_FINISH) == Z_STREAM_END) {
+                const size_t packed = 6 + z.total_out;
+                const size_t length = (packed + SECTOR - 1) / SECTOR * SECTOR;
+                memset(slot, 0xFF, 4);
+                slot[4] = static_cast<char>(z.total_out >> 8);
+                slot[5] = static_cast<char>(z.total_out);
+                memset(slot + packed, 0, length - packed);
+                loggerVfsStats.pagesCompressed.fetch_add(1, std::memory_order_relaxed);
+                return length;
+            }
+        }
+        memcpy(slot, page, pageSize);
+        return pageSize;
+    }
+
+    // Inflates a slot read from the file into page; false when it holds a
+    // page as is.
+    static bool expandPage(File* f, const unsigned char* slot, char* page) {
+        static const unsigned char marker[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+        if (memcmp(slot, marker, 4) != 0) return false;
+        const size_t packed = static_cast<size_t>(slot[4] << 8 | slot[5]);
+        if (packed + 6 > f->pageSize) return false;
+        z_stream& z = f->inflater;
+        inflateReset(&z);
+        z.next_in = const_cast<Bytef*>(slot + 6);
+        z.avail_in = static_cast<uInt>(packed);
+        z.next_out = reinterpret_cast<Bytef*>(page);
+        z.avail_out = static_cast<uInt>(f->pageSize);
+        return inflate(&z, Z_FINISH) == Z_STREAM_END && z.total_out == f->pageSize;
+    }
+
+    static bool writeAll(int fd, const char* data, size_t length, int64_t offset) {
+        while (length > 0) {
+            const ssize_t n = pwrite(fd, data, length, offset);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            data += n;
+            length -= static_cast<size_t>(n);
+            offset += n;
+        }
+        return true;
+    }
+
+    static int writeNow(File* f, const void* data, size_t length, int64_t offset) {
+        Writer writer(f);
+        writer.write(static_cast<const char*>(data), length, offset);
+        return result(writer.finish(false, false), false);
+    }
+
+    static int write(sqlite3_file* file, const void* data, int amount, sqlite3_int64 offset) {
+        File* f = self(file);
+        const size_t length = static_cast<size_t>(amount);
+        loggerVfsStats.writes.fetch_add(1, std::memory_order_relaxed);
+        loggerVfsStats.logicalBytes.fetch_add(length, std::memory_order_relaxed);
+        if (f->staged + length > STAGE_BYTES || f->extentCount == MAX_EXTENTS) {
+            const int rc = flush(f, false, false);
+            if (rc != SQLITE_OK) return rc;
+        }
+        if (length > STAGE_BYTES) return writeNow(f, data, length, offset);
+        memcpy(f->stage.get() + f->staged, data, length);
+        Extent* previous = f->extentCount ? &f->extents[f->extentCount - 1] : nullptr;
+        if (previous != nullptr && previous->offset + static_cast<int64_t>(previous->length) == offset) {
+            previous->length += length;
+        } else {
+            f->extents[f->extentCount++] = {offset, f->staged, length};
+        }
+        f->staged += length;
+
+        // a frame header has the database size in pages at bytes 4-7 on a
+        // commit frame only; its page is the next write
+        const bool flushNow = f->commitFrame;
+        const unsigned char* header = static_cast<const unsigned char*>(data);
+        f->commitFrame = amount == 24 && (header[4] | header[5] | header[6] | header[7]) != 0;
+        return flushNow ? flush(f, false, false) : SQLITE_OK;
+    }
+
+    // Stages a whole database page; anything else, or before the page size
+    // is known, is written through.
+    static int writePage(sqlite3_file* file, const void* data, int amount, sqlite3_int64 offset) {
+        File* f = self(file);
+        const size_t length = static_cast<size_t>(amount);
+        loggerVfsStats.writes.fetch_add(1, std::memory_order_relaxed);
+        loggerVfsStats.logicalBytes.fetch_add(length, std::memory_order_relaxed);
+        loggerVfsStats.databaseLogical.fetch_add(length, std::memory_order_relaxed);
+        if (offset == 0 && amount >= 100) {
+            const size_t pageSize = headerPageSize(static_cast<const unsigned char*>(data));
+            if (pageSize != f->pageSize) {
+                const int rc = flush(f, false, false);
+                if (rc != SQLITE_OK) return rc;
+                f->pageSize = pageSize;
+            }
+        }
+        const size_t pageSize = f->pageSize;
+        if (pageSize == 0 || length != pageSize || offset % static_cast<int64_t>(pageSize) != 0) {
+            const int rc = flush(f, false, false);
+            return rc != SQLITE_OK ? rc : writeNow(f, data, length, offset);
+        }
+        if (f->staged + pageSize > DB_STAGE_BYTES) {
+            const int rc = flush(f, false, false);
+            if (rc != SQLITE_OK) return rc;
+        }
+        memcpy(f->stage.get() + f->staged, data, pageSize);
+        f->pages[f->pageCount++] = {offset, static_cast<uint32_t>(f->staged), f->seq++};
+        f->staged += pageSize;
+        return SQLITE_OK;
+    }
+
+    static int close(sqlite3_file* file) {
+        File* f = self(file);
+        const int rc = flush(f, false, false);
+        if (f->pages) inflateEnd(&f->inflater);
+        if (f->compress) deflateEnd(&f->deflater);
+        ::close(f->fd);
+        const int closed = f->real->pMethods->xClose(f->real);
+        f->~File();
+        return rc != SQLITE_OK ? rc : closed;
+    }
+
+    static int read(sqlite3_file* file, void* data, int amount, sqlite3_int64 offset) {
+        const int rc = flush(self(file), false, false);
+        return rc != SQLITE_OK ? rc : real(file)->pMethods->xRead(real(file), data, amount, offset);
+    }
+
+    // Reads page by page through the slots, inflating compressed ones.
+    static int readPages(sqlite3_file* file, void* data, int amount, sqlite3_int64 offset) {
+        File* f = self(file);
+        sqlite3_file* inner = f->real;
+        int rc = flush(f, false, false);
+        if (rc != SQLITE_OK) return rc;
+        if (f->pageSize == 0) return inner->pMethods->xRead(inner, data, amount, offset);
+
+        const int64_t pageSize = static_cast<int64_t>(f->pageSize);
+        const int64_t end = offset + amount;
+        char* slot = f->out.get();
+        char* page = slot + 65536;
+        int status = SQLITE_OK;
+        for (int64_t first = offset / pageSize * pageSize; first < end; first += pageSize) {
+            const int64_t from = std::max<int64_t>(offset, first), to = std::min(end, first + pageSize);
+            char* dest = static_cast<char*>(data) + (from - offset);
+            if (first == 0) {
+                rc = inner->pMethods->xRead(inner, dest, static_cast<int>(to - from), from);
+            } else {
+                rc = inner->pMethods->xRead(inner, slot, static_cast<int>(pageSize), first);
+                if (rc != SQLITE_OK && rc != SQLITE_IOERR_SHORT_READ) return rc;
+                // a compressed last page leaves the file short of its slot
+                if (expandPage(f, reinterpret_cast<unsigned char*>(slot), page)) {
+                    memcpy(dest, page + (from - first), static_cast<size_t>(to - from));
+                    continue;
+                }
+                memcpy(dest, slot + (from - first), static_cast<size_t>(to - from));
+            }
+            if (rc == SQLITE_IOERR_SHORT_READ) status = rc;
+            else if (rc != SQLITE_OK) return rc;
+        }
+        return status;
+    }
+
+    static int truncate(sqlite3_file* file, sqlite3_int64 size) {
+        const int rc = flush(self(file), false, false);
+        return rc != SQLITE_OK ? rc : real(file)->pMethods->xTruncate(real(file), size);
+    }
+
+    static int sync(sqlite3_file* file, int flags) {
+        File* f = self(file);
+        if (!f->synced) {
+            // also syncs the directory of a new WAL
+            f->synced = true;
+            loggerVfsStats.syncs.fetch_add(1, std::memory_order_relaxed);
+            const int rc = flush(f, false, false);
+            return rc != SQLITE_OK ? rc : f->real->pMethods->xSync(f->real, flags);
+        }
+        return flush(f, true, (flags & SQLITE_SYNC_DATAONLY) != 0);
+    }
+
+    static int fileSize(sqlite3_file* file, sqlite3_int64* size) {
+        const int rc = flush(self(file), false, false);
+        return rc != SQLITE_OK ? rc : real(file)->pMethods->xFileSize(real(file), size);
+    }
+
+    // Staged pages go out before a lock is released: with synchronous=OFF
+    // no xSync() ends a checkpoint, and the WAL must not be reused over
+    // frames whose pages are not in the file yet.
+    static int unlock(sqlite3_file* file, int lock) {
+        const int rc = flush(self(file), false, false);
+        return rc != SQLITE_OK ? rc : real(file)->pMethods->xUnlock(real(file), lock);
+    }
+
+    static int shmLock(sqlite3_file* file, int offset, int n, int flags) {
+        if (flags & SQLITE_SHM_UNLOCK) {
+            const int rc = flush(self(file), false, false);
+            if (rc != SQLITE_OK) return rc;
+        }
+        return real(file)->pMethods->xShmLock(real(file), offset, n, flags);
+    }
+
+    static int fetch(sqlite3_file* file, sqlite3_int64 offset, int amount, void** out) {
+        const int rc = flush(self(file), false, false);
+        return rc != SQLITE_OK ? rc : real(file)->pMethods->xFetch(real(file), offset, amount, out);
+    }
+
+    static inline const sqlite3_io_methods walMethods = {
+        3,
+        close,
+        read,
+        write,
+        truncate,
+        sync,
+        fileSize,
+        [](sqlite3_file* f, int lock) { return real(f)->pMethods->xLock(real(f), lock); },
+        [](sqlite3_file* f, int lock) { return real(f)->pMethods->xUnlock(real(f), lock); },
+        [](sqlite3_file* f, int* out) { return real(f)->pMethods->xCheckReservedLock(real(f), out); },
+        [](sqlite3_file* f, int op, void* arg) { return real(f)->pMethods->xFileControl(real(f), op, arg); },
+        [](sqlite3_file* f) { return real(f)->pMethods->xSectorSize(real(f)); },
+        [](sqlite3_file* f) { return real(f)->pMethods->xDeviceCharacteristics(real(f)); },
+        [](sqlite3_file* f, int page, int size, int extend, void volatile** out) {
+            return real(f)->pMethods->xShmMap(real(f), page, size, extend, out);
+        },
+        [](sqlite3_file* f, int offset, int n, int flags) { return real(f)->pMethods->xShmLock(real(f), offset, n, flags); },
+        [](sqlite3_file* f) { real(f)->pMethods->xShmBarrier(real(f)); },
+        [](sqlite3_file* f, int deleteFlag) { return real(f)->pMethods->xShmUnmap(real(f), deleteFlag); },
+        fetch,
+        [](sqlite3_file* f, sqlite3_int64 offset, void* p) { return real(f)->pMethods->xUnfetch(real(f), offset, p); },
+    };
+
+    static inline const sqlite3_io_methods dbMethods = {
+        3,
+        close,
+        readPages,
+        writePage,
+        truncate,
+        sync,
+        fileSize,
+        [](sqlite3_file* f, int lock) { return real(f)->pMethods->xLock(real(f), lock); },
+        unlock,
+        [](sqlite3_file* f, int* out) { return real(f)->pMethods->xCheckReservedLock(real(f), out); },
+        [](sqlite3_file* f, int op, void* arg) { return real(f)->pMethods->xFileControl(real(f), op, arg); },
+        [](sqlite3_file* f) { return real(f)->pMethods->xSectorSize(real(f)); },
+        [](sqlite3_file* f) { return real(f)->pMethods->xDeviceCharacteristics(real(f)); },
+        [](sqlite3_file* f, int page, int size, int extend, void volatile** out) {
+            return real(f)->pMethods->xShmMap(real(f), page, size, extend, out);
+        },
+        shmLock,
+        [](sqlite3_file* f) { real(f)->pMethods->xShmBarrier(real(f)); },
+        [](sqlite3_file* f, int deleteFlag) { return real(f)->pMethods->xShmUnmap(real(f), deleteFlag); },
+        [](sqlite3_file*, sqlite3_int64, int, void** out) {
+            *out = nullptr;
+            return SQLITE_OK;
+        },
+        [](sqlite3_file* f, sqlite3_int64 offset, void* p) { return real(f)->pMethods->xUnfetch(real(f), offset, p); },
+    };
+};
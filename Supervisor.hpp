@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <iostream>
+#include <new>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <ctime>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include "Metrics.hpp"
+
+// Supervisor mode: the process forks a worker that does all the logging and
+// itself only waits, so a worker crash (a fault, an abort, a hang caught by
+// the watchdog) costs a fork and a reattach rather than the buffer. The
+// state that must survive lives outside the worker: the buffer in an SQLite
+// file (on tmpfs by default) and the last value cache in its shm segment.
+// Rows leave the buffer only once DDS accepted them, so the file's backlog
+// is the upload watermark and a new worker resumes from it; a crash between
+// write and delete repeats that chunk, never loses it.
+//
+// Every receive loop iteration stamps its shard's heartbeat, and can_logger's
+// heartbeatTask passes the oldest of them to beat(), in memory shared with
+// the supervisor, every HEARTBEAT_NS (100 ms) on the primary shard's loop.
+// A stuck receive loop stops its stamp and a stuck primary loop stops beat();
+// a worker silent for longer than the watchdog period is killed and restarted.
+class Supervisor {
+public:
+    static constexpr int64_t RESTART_DELAY_MIN_MS = 100;
+    static constexpr int64_t RESTART_DELAY_MAX_MS = 5000;
+    static constexpr int64_t STABLE_RUN_NS = 10000000000LL;   // a worker up this long resets the backoff
+
+    Supervisor() = default;
+    Supervisor(const Supervisor&) = delete;
+    Supervisor& operator=(const Supervisor&) = delete;
+
+    // Runs the supervisor loop. Returns only in a worker process, which then
+    // goes on as a normal can_logger; the supervisor exits with the status
+    // of the last worker once one ends cleanly or it is told to stop.
+    // Must run before any thread is started.
+    void run(int watchdogMs) {
+        void* mem = mmap(nullptr, sizeof(std::atomic<int64_t>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) {
+            perror("Supervisor heartbeat");
+            std::cerr << "Running without supervisor" << std::endl;
+            return;
+        }
+        heartbeat = new (mem) std::atomic<int64_t>(0);
+
+        sigset_t set;
+        sigemptyset(&set);
+        for (int sig : {SIGCHLD, SIGTERM, SIGINT, SIGHUP, SIGUSR2}) sigaddset(&set, sig);
+        sigset_t previous;
+        pthread_sigmask(SIG_BLOCK, &set, &previous);
+
+        const pid_t supervisor = getpid();
+        int64_t delayMs = 0;
+        while (true) {
+            heartbeat->store(0, std::memory_order_relaxed);
+            const int64_t started = monotonicNs();
+            const pid_t pid = fork();
+            if (pid < 0) {
+                perror("fork");
+                exit(1);
+            }
+            if (pid == 0) {
+                // worker: dies with the supervisor, takes SIGTERM/SIGINT normally
+                prctl(PR_SET_PDEATHSIG, SIGTERM);
+                if (getppid() != supervisor) exit(1);
+                pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+                return;
+            }
+            std::cerr << "Supervisor: worker " << pid << " started" << std::endl;
+
+            int status = 0;
+            const bool stopped = waitWorker(pid, set, watchdogMs, status);
+            if (stopped || (WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+                exit(WIFEXITED(status) ? WEXITSTATUS(status) : 0);
+            }
+            if (WIFSIGNALED(status)) {
+                std::cerr << "Supervisor: worker " << pid << " killed by signal " << WTERMSIG(status) << " ("
+                          << strsignal(WTERMSIG(status)) << ")";
+            } else {
+                std::cerr << "Supervisor: worker " << pid << " exited with status " << WEXITSTATUS(status);
+            }
+            // crash loops back off, a worker that ran a while restarts at once
+            delayMs = monotonicNs() - started >= STABLE_RUN_NS
+                          ? 0
+                          : std::min(delayMs ? delayMs * 2 : RESTART_DELAY_MIN_MS, RESTART_DELAY_MAX_MS);
+            std::cerr << ", restarting in " << delayMs << " ms" << std::endl;
+            if (delayMs > 0) {
+                const struct timespec delay{static_cast<time_t>(delayMs / 1000), static_cast<long>(delayMs % 1000) * 1000000};
+                nanosleep(&delay, nullptr);
+            }
+        }
+    }
+
+    // Worker side, once per loop iteration. No-op when not supervised.
+    void beat() { beat(monotonicNs()); }
+
+    // Beat dated atNs, for a worker whose liveness is that of its slowest thread.
+    void beat(int64_t atNs) {
+        if (heartbeat) heartbeat->store(atNs, std::memory_order_relaxed);
+    }
+
+private:
+    // Waits for the worker to end, forwarding SIGHUP, SIGUSR2, SIGTERM and SIGINT and
+    // killing it when its heartbeat stalls. Returns true if it was told to stop.
+    bool waitWorker(pid_t pid, const sigset_t& set, int watchdogMs, int& status) {
+        bool stopping = false;
+        const struct timespec tick{0, 100000000};
+        while (true) {
+            const int sig = sigtimedwait(&set, nullptr, &tick);
+            if (sig == SIGTERM || sig == SIGINT) {
+                stopping = true;
+                kill(pid, SIGTERM);
+            } else if (sig == SIGHUP || sig == SIGUSR2) {
+                kill(pid, sig);
+            }
+            if (waitpid(pid, &status, WNOHANG) == pid) return stopping;
+
+            const int64_t beat = heartbeat->load(std::memory_order_relaxed);
+            if (!stopping && watchdogMs > 0 && beat != 0
+                && monotonicNs() - beat > static_cast<int64_t>(watchdogMs) * 1000000) {
+                std::cerr << "Supervisor: worker " << pid << " unresponsive for " << watchdogMs << " ms, killing it"
+                          << std::endl;
+                kill(pid, SIGKILL);
+                heartbeat->store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::atomic<int64_t>* heartbeat = nullptr;
+};
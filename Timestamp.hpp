@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <sys/socket.h>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
+
+// Kernel receive timestamps for the CAN socket. SO_TIMESTAMPING reports the
+// driver's hardware stamp where the controller has one (the CAN drivers seed
+// their timecounter from CLOCK_REALTIME) next to the software stamp taken in
+// the rx softirq; SO_TIMESTAMPNS is the fallback on older kernels. Either way
+// the stamp is on the wall clock, RxClock moves it to the monotonic base.
+enum class RxTimestampMode { None, NanoSeconds, Timestamping };
+
+inline RxTimestampMode enableRxTimestamps(int s) {
+    const int flags = SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE
+                      | SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (setsockopt(s, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0) {
+        return RxTimestampMode::Timestamping;
+    }
+    const int on = 1;
+    if (setsockopt(s, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) == 0) {
+        return RxTimestampMode::NanoSeconds;
+    }
+    perror("SO_TIMESTAMPNS");
+    return RxTimestampMode::None;
+}
+
+// Room for either control message of one received frame
+constexpr size_t RX_CONTROL_SIZE = CMSG_SPACE(sizeof(struct scm_timestamping)) + CMSG_SPACE(sizeof(struct timespec));
+
+// Wall-clock receive time in ns from the control messages, 0 if none.
+inline int64_t rxTimestampNs(struct msghdr& msg) {
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) continue;
+        struct timespec ts{};
+        if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            struct scm_timestamping stamps;
+            memcpy(&stamps, CMSG_DATA(cmsg), sizeof(stamps));
+            // ts[2] raw hardware, ts[0] software
+            ts = stamps.ts[2].tv_sec || stamps.ts[2].tv_nsec ? stamps.ts[2] : stamps.ts[0];
+        } else if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        } else {
+            continue;
+        }
+        if (ts.tv_sec || ts.tv_nsec) return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    }
+    return 0;
+}
+
+inline int64_t clockUs(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+// Pairs a monotonic and a wall-clock reading taken together. The backend
+// rebuilds absolute time of a row as realtime_us + (timestamp - monotonic_us)
+// using the latest anchor at or before the row.
+struct ClockAnchor {
+    int64_t monotonicUs;
+    int64_t realtimeUs;
+};
+
+// Converts kernel wall-clock stamps to monotonic µs. sync() samples the
+// offset between the two clocks once per batch; when NTP or GPS steps the
+// wall clock the offset jumps and sync() reports it, so a fresh anchor can be
+// recorded. Frames stamped before a step but converted after it are off by
+// the step size, at most one batch.
+class RxClock {
+public:
+    static constexpr int64_t STEP_THRESHOLD_US = 1000;
+
+    // Returns true if the wall clock stepped since the previous call.
+    bool sync() {
+        const ClockAnchor now = anchor();
+        const int64_t offset = now.realtimeUs - now.monotonicUs;
+        const int64_t drift = offset - offsetUs;
+        const bool stepped = synced && (drift > STEP_THRESHOLD_US || drift < -STEP_THRESHOLD_US);
+        offsetUs = offset;
+        synced = true;
+        return stepped;
+    }
+
+    // Kernel stamp in ns to monotonic µs; frames without a stamp get now.
+    int64_t toMonotonicUs(int64_t realtimeNs) const {
+        if (realtimeNs == 0) return clockUs(CLOCK_MONOTONIC);
+        return realtimeNs / 1000 - offsetUs;
+    }
+
+    // The monotonic reading is the midpoint of two around the wall clock
+    // read, so the pair is as close as the syscalls allow.
+    static ClockAnchor anchor() {
+        const int64_t before = clockUs(CLOCK_MONOTONIC);
+        const int64_t real = clockUs(CLOCK_REALTIME);
+        const int64_t after = clockUs(CLOCK_MONOTONIC);
+        return {before + (after - before) / 2, real};
+    }
+
+private:
+    int64_t offsetUs = 0;
+    bool synced = false;
+};
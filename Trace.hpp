@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <cstdint>
+#include <cstdio>
+#include <csignal>
+#include <ctime>
+#include "Metrics.hpp"
+
+// Scoped tracing spans around the pipeline stages, compiled in with
+// CANLOGGER_TRACE (cmake -DCANLOGGER_TRACE=ON, or a Debug build). Without
+// it TRACE_SPAN() expands to nothing and TraceDumper does nothing.
+//
+// Every thread records into a ring of its own holding its last
+// TRACE_RING_EVENTS spans. The thread is the ring's only writer, so a span
+// costs two clock reads and four stores, no lock and no atomic
+// read-modify-write. On SIGUSR2 the dumper thread copies the rings and
+// writes them as Chrome trace-event JSON, which chrome://tracing and
+// ui.perfetto.dev open. Spans must not cross a co_await.
+
+#if defined(CANLOGGER_TRACE)
+
+#include <fstream>
+#include <vector>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+constexpr size_t TRACE_RING_EVENTS = 8192;   // power of two
+constexpr int TRACE_MAX_THREADS = 16;
+
+struct TraceEvent {
+    const char* name;      // string literal
+    int64_t startNs;       // CLOCK_MONOTONIC
+    int64_t durationNs;
+    int64_t items;         // frames, rows or samples handled, -1 if none
+};
+
+struct alignas(64) TraceRing {
+    std::atomic<uint64_t> head{0};    // events recorded so far
+    pid_t tid = 0;
+    TraceEvent events[TRACE_RING_EVENTS];
+
+    void record(const TraceEvent& event) {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        events[h & (TRACE_RING_EVENTS - 1)] = event;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // Appends the events still in the ring, oldest first. The owner keeps
+    // writing meanwhile: whatever it may have overwritten during the copy
+    // is dropped.
+    void copy(std::vector<TraceEvent>& out) const {
+        const uint64_t end = head.load(std::memory_order_acquire);
+        const uint64_t begin = end > TRACE_RING_EVENTS ? end - TRACE_RING_EVENTS : 0;
+        const size_t first = out.size();
+        for (uint64_t i = begin; i < end; i++) out.push_back(events[i & (TRACE_RING_EVENTS - 1)]);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // the owner may be writing event `now`, over event now - TRACE_RING_EVENTS
+        const uint64_t now = head.load(std::memory_order_relaxed);
+        const uint64_t lost = now + 1 > begin + TRACE_RING_EVENTS ? now + 1 - begin - TRACE_RING_EVENTS : 0;
+        out.erase(out.begin() + first, out.begin() + first + std::min<uint64_t>(lost, end - begin));
+    }
+};
+
+class TraceRings {
+public:
+    static TraceRings& instance() {
+        static TraceRings rings;
+        return rings;
+    }
+
+    // The calling thread's ring, claimed on its first span; nullptr once
+    // TRACE_MAX_THREADS threads have one, that thread's spans are dropped.
+    TraceRing* local() {
+        thread_local TraceRing* ring = claim();
+        return ring;
+    }
+
+    int count() const { return std::min(claimed.load(std::memory_order_acquire), TRACE_MAX_THREADS); }
+    const TraceRing& at(int i) const { return rings[i]; }
+
+private:
+    TraceRing* claim() {
+        const int slot = claimed.fetch_add(1, std::memory_order_acq_rel);
+        if (slot >= TRACE_MAX_THREADS) return nullptr;
+        rings[slot].tid = static_cast<pid_t>(syscall(SYS_gettid));
+        return &rings[slot];
+    }
+
+    std::atomic<int> claimed{0};
+    TraceRing rings[TRACE_MAX_THREADS];
+};
+
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, int64_t items = -1) : name(name), items(items), start(monotonicNs()) {}
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    ~TraceSpan() {
+        const int64_t end = monotonicNs();
+        if (TraceRing* ring = TraceRings::instance().local()) ring->record({name, start, end - start, items});
+    }
+
+private:
+    const char* name;
+    int64_t items;
+    int64_t start;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SPAN(...) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(__VA_ARGS__)
+
+// Writes every ring as trace-event JSON, one track per thread named after
+// it, times in µs since boot (CLOCK_MONOTONIC). Returns spans written.
+inline size_t writeTrace(const std::string& path) {
+    const TraceRings& rings = TraceRings::instance();
+    const pid_t pid = getpid();
+    const std::string tmp = path + ".tmp";
+    std::ofstream out(tmp, std::ios::trunc);
+    if (!out) return 0;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    std::vector<TraceEvent> events;
+    events.reserve(TRACE_RING_EVENTS);
+    size_t written = 0;
+    bool first = true;
+    char line[256];
+    for (int i = 0; i < rings.count(); i++) {
+        const TraceRing& ring = rings.at(i);
+        std::string thread = "thread " + std::to_string(ring.tid);
+        std::ifstream comm("/proc/self/task/" + std::to_string(ring.tid) + "/comm");
+        std::getline(comm, thread);
+        out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":"
+            << ring.tid << ",\"args\":{\"name\":\"" << thread << "\"}}";
+        first = false;
+        events.clear();
+        ring.copy(events);
+        for (const TraceEvent& event : events) {
+            int n = std::snprintf(line, sizeof(line),
+                                  ",\n{\"name\":\"%s\",\"cat\":\"canlogger\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+                                  "\"ts\":%.3f,\"dur\":%.3f",
+                                  event.name, pid, ring.tid, event.startNs / 1e3, event.durationNs / 1e3);
+            if (event.items >= 0) {
+                n += std::snprintf(line + n, sizeof(line) - n, ",\"args\":{\"items\":%lld}",
+                                   static_cast<long long>(event.items));
+            }
+            out << line << "}";
+        }
+        written += events.size();
+    }
+    out << "\n]}\n";
+    out.close();
+    if (!out || std::rename(tmp.c_str(), path.c_str()) != 0) return 0;
+    return written;
+}
+
+// Waits for SIGUSR2 on its own thread and writes the trace to the file
+// then. blockSignal() must run before any other thread is created.
+class TraceDumper {
+public:
+    static void blockSignal() {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGUSR2);
+        pthread_sigmask(SIG_BLOCK, &set, nullptr);
+    }
+
+    ~TraceDumper() { stop(); }
+
+    void start(const std::string& tracePath) {
+        if (tracePath.empty()) return;
+        path = tracePath;
+        running = true;
+        worker = std::thread([this] { run(); });
+    }
+
+    void stop() {
+        running = false;
+        if (worker.joinable()) worker.join();
+    }
+
+private:
+    void run() {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGUSR2);
+        const struct timespec timeout{0, 200000000};
+        while (running) {
+            if (sigtimedwait(&set, nullptr, &timeout) != SIGUSR2) continue;
+            const int64_t start = monotonicNs();
+            const size_t spans = writeTrace(path);
+            std::cerr << "Trace: " << spans << " spans written to " << path << " in "
+                      << (monotonicNs() - start) / 1000000 << " ms" << std::endl;
+        }
+    }
+
+    std::string path;
+    std::atomic<bool> running{false};
+    std::thread worker;
+};
+
+#else
+
+#define TRACE_SPAN(...) static_cast<void>(0)
+
+// Still blocks SIGUSR2, so a dump asked of a build without tracing is
+// ignored instead of ending the process.
+class TraceDumper {
+public:
+    static void blockSignal() {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGUSR2);
+        pthread_sigmask(SIG_BLOCK, &set, nullptr);
+    }
+    void start(const std::string&) {}
+    void stop() {}
+};
+
+#endif
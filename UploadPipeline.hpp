@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <cstdint>
+#include "AsyncIo.hpp"
+#include "CanBatch.hpp"
+#include "Metrics.hpp"
+
+template <typename Encoded, typename Cursor = int64_t>
+struct UploadChunk {
+    CanBatch rows;           // as fetched from storage
+    Encoded encoded;         // filled by the encode stage
+    size_t count = 0;        // samples in encoded, rows no reader wants are left out
+    Cursor lastId{};         // position of the last row, deleted up to there once published
+    bool held = false;       // set by the encoder: nobody to send to, ends the drain with the rows buffered
+    bool last = false;       // end of a drain, carries no rows
+    bool ok = true;          // on the last chunk: the read side succeeded
+    int64_t startNs = 0;     // on the last chunk: when the drain started
+};
+
+// Drains the storage backlog with three tasks: the reader fetches chunks,
+// the encoder turns rows into samples, the writer publishes them and has the
+// rows deleted. Up to DEPTH chunks wait between two stages. Each task runs on
+// the event loop it is started on and a stage call holds that loop while it
+// runs, so stages on different loops keep SQLite, the CPU and the network
+// busy at the same time and a drain runs at the speed of the slowest stage;
+// stages sharing a loop take turns. Chunks circulate through a fixed set; no
+// stage allocates.
+//
+// The reader fetches ahead of what is published, after the last position it
+// handed on: a seq, or whatever Cursor the fetch and commit stages agree on
+// (see ShardMerge). A failed publish or a held chunk stops the drain: the
+// reader stops fetching, in-flight chunks are dropped unpublished and their
+// rows stay buffered for the next drain, which starts again from the oldest
+// row.
+template <typename Encoded, typename Cursor = int64_t>
+class UploadPipeline {
+public:
+    using Chunk = UploadChunk<Encoded, Cursor>;
+    static constexpr size_t DEPTH = 2;               // chunks between two stages
+    static constexpr size_t CHUNKS = 2 * DEPTH + 3;  // both queues full, one in each stage
+
+    struct Stages {
+        std::function<bool()> begin;                          // reader, before the first chunk
+        std::function<bool(Chunk&, const Cursor& afterId)> fetch;   // reader, no rows = backlog drained
+        std::function<void(Chunk&)> encode;
+        std::function<bool(const Chunk&)> publish;
+        std::function<bool(const Cursor& lastId)> commit;           // writer, once a chunk is published
+        std::function<void(bool ok, int64_t startNs)> done;   // writer, end of a drain
+    };
+
+    // pool must have CHUNKS free batches
+    explicit UploadPipeline(CanBatchPool& pool) {
+        for (Chunk& chunk : chunks) {
+            chunk.rows = pool.acquire();
+            free.tryPush(&chunk);
+        }
+    }
+
+    UploadPipeline(const UploadPipeline&) = delete;
+    UploadPipeline& operator=(const UploadPipeline&) = delete;
+    ~UploadPipeline() { stop(); }
+
+    // The loops may be shared with other tasks, or be one loop for all three.
+    void start(Stages pipelineStages, IoLoop& readLoop, IoLoop& encodeLoop, IoLoop& writeLoop) {
+        stages = std::move(pipelineStages);
+        running = true;
+        active = 3;
+        readLoop.spawn(readTask());
+        encodeLoop.spawn(encodeTask());
+        writeLoop.spawn(writeTask());
+    }
+
+    // Waits for the tasks to return, so their loops must still be running.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!running) return;
+            running = false;
+        }
+        kicked.set();
+        std::unique_lock<std::mutex> guard(lock);
+        finished.wait(guard, [this] { return active == 0; });
+    }
+
+    // Starts a drain unless one is running; returns false if it was busy.
+    // Any thread.
+    bool kick() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (busy || !running) return false;
+            busy = true;
+        }
+        kicked.set();
+        return true;
+    }
+
+    bool idle() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return !busy;
+    }
+
+private:
+    Task<> readTask() {
+        while (true) {
+            co_await kicked.wait();
+            if (!running) break;
+            const int64_t start = monotonicNs();
+            bool ok = stages.begin();
+            Cursor afterId{};
+            while (ok && running && !aborted.load(std::memory_order_relaxed)) {
+                Chunk* chunk = co_await free.pop();
+                chunk->last = false;
+                ok = stages.fetch(*chunk, afterId);
+                if (!ok || chunk->rows.empty()) {
+                    co_await free.push(chunk);
+                    break;
+                }
+                afterId = chunk->lastId;
+                co_await toEncoder.push(chunk);
+            }
+            Chunk* end = co_await free.pop();
+            end->rows.clear();
+            end->last = true;
+            end->ok = ok;
+            end->startNs = start;
+            co_await toEncoder.push(end);
+        }
+        co_await toEncoder.push(nullptr);
+        taskDone();
+    }
+
+    Task<> encodeTask() {
+        while (Chunk* chunk = co_await toEncoder.pop()) {
+            if (!chunk->last) stages.encode(*chunk);
+            co_await toWriter.push(chunk);
+        }
+        co_await toWriter.push(nullptr);
+        taskDone();
+    }
+
+    Task<> writeTask() {
+        bool ok = true;
+        while (Chunk* chunk = co_await toWriter.pop()) {
+            if (chunk->last) {
+                stages.done(ok && chunk->ok, chunk->startNs);
+                ok = true;
+                aborted.store(false, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> guard(lock);
+                busy = false;
+            } else if (ok) {
+                ok = !chunk->held && stages.publish(*chunk) && stages.commit(chunk->lastId);
+                if (!ok) aborted.store(true, std::memory_order_relaxed);
+            }
+            co_await free.push(chunk);
+        }
+        taskDone();
+    }
+
+    void taskDone() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (--active == 0) finished.notify_all();
+    }
+
+    Stages stages;
+    std::array<Chunk, CHUNKS> chunks;
+    AsyncQueue<Chunk, CHUNKS> free;
+    AsyncQueue<Chunk, DEPTH> toEncoder;
+    AsyncQueue<Chunk, DEPTH> toWriter;
+    AsyncEvent kicked;
+    mutable std::mutex lock;
+    std::condition_variable finished;
+    std::atomic<bool> running{false};
+    bool busy = false;
+    int active = 0;                  // tasks not yet returned
+    std::atomic<bool> aborted{false};
+};
@@ -0,0 +1,176 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Alarm path latency probe: writes frames that toggle a threshold rule
+// (by default "alarm.bench = 0x7F0 > 100", see run_alarm_bench.sh) on the
+// CAN interface and subscribes to the alarm topic. For every alarm it
+// measures frame receive (the sample's timestamp, kernel receive time on
+// this host) to alarm arrival, and the frame write to arrival round trip.
+// Prints one JSON line.
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include "DDS/FastDDSSubscriber.hpp"
+
+using namespace eprosima::fastdds::dds;
+
+static int64_t nowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+static void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--interface vcan0] [--id 0x7F0] [--threshold 100]"
+              << " [--count n] [--period-ms ms] [--topic CanLoggerAlarmTopic]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string interface = "vcan0";
+    std::string topicName = "CanLoggerAlarmTopic";
+    uint32_t can_id = 0x7F0;
+    int threshold = 100;
+    int count = 1000;
+    int periodMs = 5;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--interface") && i + 1 < argc) interface = argv[++i];
+        else if (!strcmp(argv[i], "--id") && i + 1 < argc) can_id = std::strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--threshold") && i + 1 < argc) threshold = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--count") && i + 1 < argc) count = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--period-ms") && i + 1 < argc) periodMs = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--topic") && i + 1 < argc) topicName = argv[++i];
+        else { usage(argv[0]); return 1; }
+    }
+    if (count <= 0 || threshold < 1 || threshold > 0xFFFE) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    DomainParticipant* participant = DomainParticipantFactory::get_instance()->create_participant(0, PARTICIPANT_QOS_DEFAULT);
+    if (participant == nullptr) {
+        std::cerr << "Error creating participant." << std::endl;
+        return 1;
+    }
+    TypeSupport myType = TypeSupport(new CanAlarmPubSubType());
+    myType.register_type(participant);
+    Topic* topic = participant->create_topic(topicName, myType.get_type_name(), TOPIC_QOS_DEFAULT);
+    Subscriber* subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT, nullptr, StatusMask::none());
+    if (topic == nullptr || subscriber == nullptr) {
+        std::cerr << "Error creating topic or subscriber." << std::endl;
+        return 1;
+    }
+
+    std::mutex lock;
+    std::vector<int64_t> receiveToAlarm, writeToAlarm;
+    receiveToAlarm.reserve(count);
+    writeToAlarm.reserve(count);
+    int64_t lastWrite = 0;
+
+    SubListener<CanAlarm> listener;
+    listener.onSample = [&](const CanAlarm& alarm) {
+        const int64_t now = nowUs();
+        if (alarm.can_id() != can_id) return;
+        std::lock_guard<std::mutex> guard(lock);
+        receiveToAlarm.push_back(now - alarm.timestamp());
+        writeToAlarm.push_back(now - lastWrite);
+    };
+
+    // volatile reader: alarms published before the run don't count
+    DataReaderQos rqos;
+    subscriber->get_default_datareader_qos(rqos);
+    rqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    rqos.history().kind = KEEP_ALL_HISTORY_QOS;
+    DataReader* reader = subscriber->create_datareader(topic, rqos, &listener, StatusMask::all());
+    if (reader == nullptr) {
+        std::cerr << "Error creating reader." << std::endl;
+        return 1;
+    }
+
+    int s = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (s < 0) {
+        perror("Socket");
+        return 1;
+    }
+    struct ifreq ifr;
+    strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+    ifr.ifr_name[IFNAMSIZ - 1] = '\0';
+    ioctl(s, SIOCGIFINDEX, &ifr);
+    struct sockaddr_can addr{};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("Bind");
+        return 1;
+    }
+
+    for (int waited = 0; listener.matched == 0 && waited < 100; waited++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    if (listener.matched == 0) {
+        std::cerr << "No alarm publisher on " << topicName << std::endl;
+        return 1;
+    }
+
+    // every frame crosses the threshold, so every frame raises or clears
+    struct can_frame frame{};
+    frame.can_id = can_id;
+    frame.can_dlc = 2;
+    for (int i = 0; i < count; i++) {
+        const int value = i % 2 == 0 ? threshold + 1 : 0;
+        frame.data[0] = value >> 8;
+        frame.data[1] = value & 0xFF;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            lastWrite = nowUs();
+        }
+        if (write(s, &frame, sizeof(frame)) != sizeof(frame)) {
+            perror("Write");
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(periodMs));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    close(s);
+
+    std::lock_guard<std::mutex> guard(lock);
+    std::sort(receiveToAlarm.begin(), receiveToAlarm.end());
+    std::sort(writeToAlarm.begin(), writeToAlarm.end());
+    const size_t received = receiveToAlarm.size();
+    std::cout << "{\"sent\":" << count
+              << ",\"alarms\":" << received
+              << ",\"receive_to_alarm_us\":{\"p50\":" << percentile(receiveToAlarm, 0.50)
+              << ",\"p99\":" << percentile(receiveToAlarm, 0.99)
+              << ",\"max\":" << (received ? receiveToAlarm.back() : 0) << "}"
+              << ",\"write_to_alarm_us\":{\"p50\":" << percentile(writeToAlarm, 0.50)
+              << ",\"p99\":" << percentile(writeToAlarm, 0.99)
+              << ",\"max\":" << (received ? writeToAlarm.back() : 0) << "}"
+              << "}" << std::endl;
+
+    participant->delete_contained_entities();
+    DomainParticipantFactory::get_instance()->delete_participant(participant);
+    return received == static_cast<size_t>(count) ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Allocation check for the batch pipeline: runs decode -> store -> fetch ->
+// DDS sample build on synthetic frames and counts C++ and SQLite heap
+// allocations after warm-up. Exits non-zero if steady state allocates.
+
+#include <iostream>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "CanBatch.hpp"
+#include "CanDecode.hpp"
+#include "CanStorage.hpp"
+#include "SqliteMemPool.hpp"
+#include "Metrics.hpp"
+#include "DDS/LogEntry.hpp"
+
+static std::atomic<bool> counting{false};
+static std::atomic<uint64_t> cppAllocs{0};
+
+void* operator new(size_t size) {
+    if (counting) cppAllocs++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int warmup = 1000;
+
+    SqliteMemPool::install();
+
+    FrameBatchPool framePool(1, 64);
+    CanBatchPool dataPool(1, 256);
+    CanStorage storage;
+    if (!storage.open(":memory:")) return 1;
+
+    FrameBatch frames = framePool.acquire();
+    CanColumns decoded;
+    CanLogEntry sample;
+    int64_t checksum = 0;
+    uint64_t frameCount = 0;
+
+    uint64_t sqliteBaseline = 0;
+    int64_t start = 0;
+    for (int i = 0; i < warmup + iterations; i++) {
+        if (i == warmup) {
+            counting = true;
+            sqliteBaseline = SqliteMemPool::systemAllocs();
+            start = monotonicNs();
+            frameCount = 0;
+        }
+
+        frames.resize(1 + i % frames.capacity());
+        for (size_t f = 0; f < frames.size(); f++) {
+            frames[f] = {};
+            frames[f].frame.can_id = 0x100 + f % 6;
+            frames[f].frame.can_dlc = 2;
+            frames[f].frame.data[0] = i >> 8;
+            frames[f].frame.data[1] = i & 0xFF;
+            frames[f].timestamp = i;
+        }
+        frameCount += frames.size();
+        decoded.clear();
+        decodeColumns(frames, decoded);
+        storage.insert(decoded);
+
+        if (storage.backlog() >= 100) {
+            CanBatch upload = dataPool.acquire();
+            int64_t lastId;
+            while (storage.backlog() > 0 && storage.fetch(upload, 0, lastId) && !upload.empty()) {
+                for (const CanData& row : upload) {
+                    sample.can_id(row.can_id);
+                    sample.value(row.value);
+                    sample.timestamp(row.timestamp);
+                    checksum += sample.value();
+                }
+                storage.remove(lastId);
+            }
+        }
+    }
+    counting = false;
+    const double elapsed = (monotonicNs() - start) / 1e9;
+    const uint64_t sqliteAllocs = SqliteMemPool::systemAllocs() - sqliteBaseline;
+
+    std::cout << "{\"frames\":" << frameCount
+              << ",\"frames_per_s\":" << frameCount / elapsed
+              << ",\"cpp_allocs\":" << cppAllocs
+              << ",\"sqlite_allocs\":" << sqliteAllocs
+              << ",\"checksum\":" << checksum << "}" << std::endl;
+    return cppAllocs == 0 && sqliteAllocs == 0 ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// End-to-end benchmark probe: subscribes to CanLoggerTopic, measures
+// delivered rate and frame-timestamp-to-receive latency, samples CPU time
+// and peak RSS of the running can_logger and prints one JSON line.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#include "DDS/FastDDSSubscriber.hpp"
+
+using namespace eprosima::fastdds::dds;
+
+struct ProcSample {
+    double cpu_s;
+    long peak_rss_kb;
+};
+
+static bool readProc(pid_t pid, ProcSample& out) {
+    std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+    std::string line;
+    if (!std::getline(stat, line)) return false;
+    // skip "pid (comm) " - comm may contain spaces
+    std::istringstream fields(line.substr(line.rfind(')') + 2));
+    std::string field;
+    unsigned long utime = 0, stime = 0;
+    for (int i = 3; fields >> field; i++) {
+        if (i == 14) utime = std::stoul(field);
+        if (i == 15) { stime = std::stoul(field); break; }
+    }
+    out.cpu_s = static_cast<double>(utime + stime) / sysconf(_SC_CLK_TCK);
+
+    std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+    out.peak_rss_kb = 0;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            out.peak_rss_kb = std::stol(line.substr(6));
+            break;
+        }
+    }
+    return true;
+}
+
+// Row timestamps are CLOCK_MONOTONIC µs of the logger, comparable here
+// since the bench runs on the same host.
+static int64_t nowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+static void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " --pid <can_logger pid> [--duration s] [--warmup s] [--label text]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    pid_t pid = 0;
+    int duration = 30;
+    int warmup = 5;
+    std::string label;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--pid") && i + 1 < argc) pid = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--duration") && i + 1 < argc) duration = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--warmup") && i + 1 < argc) warmup = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--label") && i + 1 < argc) label = argv[++i];
+        else { usage(argv[0]); return 1; }
+    }
+    if (pid <= 0 || duration <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    DomainParticipant* participant = DomainParticipantFactory::get_instance()->create_participant(0, PARTICIPANT_QOS_DEFAULT);
+    if (participant == nullptr) {
+        std::cerr << "Error creating participant." << std::endl;
+        return 1;
+    }
+    TypeSupport myType = TypeSupport(new CanLogEntryPubSubType());
+    myType.register_type(participant);
+    Topic* topic = participant->create_topic("CanLoggerTopic", myType.get_type_name(), TOPIC_QOS_DEFAULT);
+    Subscriber* subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT, nullptr, StatusMask::none());
+    if (topic == nullptr || subscriber == nullptr) {
+        std::cerr << "Error creating topic or subscriber." << std::endl;
+        return 1;
+    }
+
+    std::mutex lock;
+    bool measuring = false;
+    std::vector<int64_t> latencies;
+    latencies.reserve(1 << 20);
+
+    SubListener<> listener;
+    listener.onSample = [&](const CanLogEntry& sample) {
+        const int64_t latency = nowUs() - sample.timestamp();
+        std::lock_guard<std::mutex> guard(lock);
+        if (measuring) latencies.push_back(latency);
+    };
+
+    DataReaderQos rqos;
+    subscriber->get_default_datareader_qos(rqos);
+    rqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    rqos.history().kind = KEEP_ALL_HISTORY_QOS;
+    rqos.resource_limits().max_instances = 0;              // one per can_id, the key
+    rqos.resource_limits().max_samples_per_instance = 0;
+    DataReader* reader = subscriber->create_datareader(topic, rqos, &listener, StatusMask::all());
+    if (reader == nullptr) {
+        std::cerr << "Error creating reader." << std::endl;
+        return 1;
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(warmup));
+
+    ProcSample before, after;
+    if (!readProc(pid, before)) {
+        std::cerr << "can_logger pid " << pid << " not found" << std::endl;
+        return 1;
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        measuring = true;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(duration));
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        measuring = false;
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const bool alive = readProc(pid, after);
+
+    std::sort(latencies.begin(), latencies.end());
+    const size_t frames = latencies.size();
+    const double cpu = alive ? after.cpu_s - before.cpu_s : 0.0;
+
+    std::cout << "{\"label\":\"" << label << "\""
+              << ",\"duration_s\":" << elapsed
+              << ",\"frames\":" << frames
+              << ",\"frames_per_s\":" << frames / elapsed
+              << ",\"latency_ms\":{\"p50\":" << percentile(latencies, 0.50) / 1000.0
+              << ",\"p99\":" << percentile(latencies, 0.99) / 1000.0
+              << ",\"p999\":" << percentile(latencies, 0.999) / 1000.0
+              << ",\"max\":" << (frames ? latencies.back() : 0) / 1000.0 << "}"
+              << ",\"cpu_ms_per_1k_frames\":" << (frames ? cpu * 1000.0 * 1000.0 / frames : 0.0)
+              << ",\"peak_rss_kb\":" << (alive ? after.peak_rss_kb : 0)
+              << ",\"logger_alive\":" << (alive ? "true" : "false")
+              << "}" << std::endl;
+
+    participant->delete_contained_entities();
+    DomainParticipantFactory::get_instance()->delete_participant(participant);
+    return alive ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Decode microbenchmark: runs the scalar and the SIMD batch decode and range
+// check kernels over the same synthetic frame batches, checks that both
+// produce identical columns and prints frames/ns for each as one JSON line.
+// A decode written out by hand as a switch over the mock's ids is the
+// baseline the table-generated unpacking in Signals.hpp has to match.
+// "chosen" is the kernel decodeColumns() picked by its own timing at startup.
+
+#include <iostream>
+#include <cstdlib>
+#include "CanBatch.hpp"
+#include "CanDecode.hpp"
+#include "Metrics.hpp"
+
+constexpr size_t BATCH = CanColumns::CAPACITY;
+constexpr size_t BATCHES = 64;   // distinct batches cycled through, stays in L1/L2
+
+struct Result {
+    double decodeFramesPerNs;
+    double checkFramesPerNs;
+    uint64_t checksum;
+};
+
+// What decodeFrame() was before the signal table, per id by hand.
+static size_t decodeColumnsSwitch(const FrameBatch& frames, CanColumns& out) {
+    size_t rejected = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        const struct can_frame& f = frames[i].frame;
+        int32_t value = 0;
+        bool valid;
+        switch (f.can_id) {
+        case 0x100: case 0x103: case 0x105: case 0x200:
+            valid = f.can_dlc >= 2;
+            value = (f.data[0] << 8) | f.data[1];
+            break;
+        case 0x101: case 0x102: case 0x104:
+            valid = f.can_dlc >= 1;
+            value = f.data[0] - 40;
+            break;
+        default:
+            valid = f.can_dlc > 0 && f.can_dlc < sizeof(int) && !(f.can_id & CAN_RTR_FLAG);
+            for (int b = 0; valid && b < f.can_dlc; b++) value = (value << 8) | f.data[b];
+        }
+        if (!valid) {
+            rejected++;
+            continue;
+        }
+        out.ids[out.count] = f.can_id;
+        out.values[out.count] = value;
+        out.timestamps[out.count] = frames[i].timestamp;
+        out.count++;
+    }
+    return rejected;
+}
+
+static bool sameColumns(const CanColumns& a, size_t rejectedA, const CanColumns& b, size_t rejectedB) {
+    bool same = rejectedA == rejectedB && a.count == b.count;
+    for (size_t i = 0; same && i < a.count; i++) {
+        same = a.ids[i] == b.ids[i] && a.values[i] == b.values[i] && a.timestamps[i] == b.timestamps[i];
+    }
+    return same;
+}
+
+// Each kernel is timed over the whole run, a clock read per batch would
+// cost as much as decoding it.
+template <typename Decode, typename Check>
+static Result run(const FrameBatch* batches, const LimitTable& limits, int rounds, Decode decode, Check check) {
+    static CanColumns cols[BATCHES];
+    uint64_t checksum = 0;
+    uint64_t frames = 0;
+
+    int64_t start = monotonicNs();
+    for (int r = 0; r < rounds; r++) {
+        CanColumns& out = cols[r % BATCHES];
+        out.clear();
+        checksum += decode(batches[r % BATCHES], out);
+        checksum += out.values[r % out.size()];
+        frames += batches[r % BATCHES].size();
+    }
+    const int64_t decodeNs = monotonicNs() - start;
+
+    start = monotonicNs();
+    for (int r = 0; r < rounds; r++) {
+        checksum += __builtin_popcountll(check(cols[r % BATCHES], limits));
+    }
+    const int64_t checkNs = monotonicNs() - start;
+
+    return {static_cast<double>(frames) / decodeNs, static_cast<double>(frames) / checkNs, checksum};
+}
+
+int main(int argc, char* argv[]) {
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    FrameBatchPool pool(BATCHES, BATCH);
+    FrameBatch batches[BATCHES];
+    std::srand(1);
+    for (size_t b = 0; b < BATCHES; b++) {
+        batches[b] = pool.acquire();
+        batches[b].resize(BATCH);
+        for (size_t f = 0; f < BATCH; f++) {
+            CanRxFrame& rx = batches[b][f];
+            rx = {};
+            // the mocks' signals at their own length, an unknown id of any
+            // short length, an occasional truncated or oversized frame
+            const size_t pick = std::rand() % (SIGNALS.size() + 1);
+            rx.frame.can_id = pick < SIGNALS.size() ? SIGNALS[pick].can_id : 0x106;
+            rx.frame.can_dlc = pick < SIGNALS.size() ? SIGNALS[pick].dlc : std::rand() % 4;
+            if (std::rand() % 500 == 0) rx.frame.can_dlc = std::rand() % 2 ? 0 : 5;
+            for (int i = 0; i < 8; i++) rx.frame.data[i] = std::rand() & 0xFF;
+            rx.timestamp = static_cast<int64_t>(b * BATCH + f);
+        }
+    }
+    LimitTable limits;
+    for (const SignalDef& signal : SIGNALS) limits.set(signal.can_id, signal.mockMin, signal.mockMax);
+    limits.set(0x106, 1000, 60000);
+
+    // all paths must agree before their timings mean anything
+    for (size_t b = 0; b < BATCHES; b++) {
+        CanColumns byHand, scalar, simd;
+        const size_t rejectedByHand = decodeColumnsSwitch(batches[b], byHand);
+        const size_t rejectedScalar = decodeColumnsScalar(batches[b], scalar);
+        const size_t rejectedSimd = decodeColumnsSimd(batches[b], simd);
+        if (!sameColumns(byHand, rejectedByHand, scalar, rejectedScalar)) {
+            std::cerr << "Table decode differs from the hand-written switch in batch " << b << std::endl;
+            return 1;
+        }
+        if (!sameColumns(scalar, rejectedScalar, simd, rejectedSimd)
+            || outsideLimitsScalar(scalar, limits) != outsideLimitsSimd(simd, limits)) {
+            std::cerr << "SIMD decode differs from scalar in batch " << b << std::endl;
+            return 1;
+        }
+    }
+
+    const Result byHand = run(batches, limits, rounds, decodeColumnsSwitch, outsideLimitsScalar);
+    const Result scalar = run(batches, limits, rounds, decodeColumnsScalar, outsideLimitsScalar);
+    const Result simd = run(batches, limits, rounds, decodeColumnsSimd, outsideLimitsSimd);
+
+    std::cout << "{\"isa\":\"" << canDecodeIsa() << "\""
+              << ",\"frames\":" << static_cast<uint64_t>(rounds) * BATCH
+              << ",\"switch\":{\"decode_frames_per_ns\":" << byHand.decodeFramesPerNs << "}"
+              << ",\"scalar\":{\"decode_frames_per_ns\":" << scalar.decodeFramesPerNs
+              << ",\"check_frames_per_ns\":" << scalar.checkFramesPerNs << "}"
+              << ",\"simd\":{\"decode_frames_per_ns\":" << simd.decodeFramesPerNs
+              << ",\"check_frames_per_ns\":" << simd.checkFramesPerNs << "}"
+              << ",\"chosen\":\"" << decodeKernel().name << "\""
+              << ",\"checksum\":" << (scalar.checksum == simd.checksum && byHand.checksum == scalar.checksum ? "\"match\"" : "\"differ\"")
+              << "}" << std::endl;
+    return scalar.checksum == simd.checksum && byHand.checksum == scalar.checksum ? 0 : 1;
+}
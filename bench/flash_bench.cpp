@@ -0,0 +1,164 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Flash write pattern benchmark: CanStorage on disk under the logger's load,
+// 64-sample insert transactions with an upload draining 256 rows every 8 of
+// them, so checkpoints rewrite pages scattered over the table and its
+// indexes. Runs with the default VFS and with the logger VFS passing the
+// database through, coalescing it per erase block, compressing it, and
+// both. Bytes are the VFS's own counts (the default VFS run has none), the
+// database's apart from the WAL's; extents are the writes it issued, blocks
+// the erase blocks those touched, write syscalls the process's from
+// /proc/self/io. The insert latency percentiles include the checkpoints
+// SQLite runs inside insert transactions. Every run ends with the file
+// reopened, checked with PRAGMA integrity_check and its backlog compared.
+// Prints one JSON line per run.
+//
+// usage: flash_bench [--samples n] [--erase-kb n] [--db file]
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sqlite3.h>
+#include "CanBatch.hpp"
+#include "CanStorage.hpp"
+#include "Metrics.hpp"
+#include "SqliteMemPool.hpp"
+#include "SqliteVfs.hpp"
+
+constexpr size_t DRAIN_BATCH = 256;
+constexpr int DRAIN_EVERY = 8;
+
+static void removeDatabase(const std::string& path) {
+    unlink(path.c_str());
+    unlink((path + "-wal").c_str());
+    unlink((path + "-shm").c_str());
+}
+
+// write family system calls of the process, from /proc/self/io
+static uint64_t ioWrites() {
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    uint64_t value = 0;
+    while (io >> key >> value) {
+        if (key == "syscw:") return value;
+    }
+    return 0;
+}
+
+static std::string integrity(sqlite3* db) {
+    sqlite3_stmt* stmt = nullptr;
+    std::string result = "error";
+    if (sqlite3_prepare_v2(db, "PRAGMA integrity_check", -1, &stmt, nullptr) == SQLITE_OK
+        && sqlite3_step(stmt) == SQLITE_ROW) {
+        result = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    }
+    sqlite3_finalize(stmt);
+    return result;
+}
+
+static bool runFlash(const char* name, const std::string& path, uint64_t samples) {
+    removeDatabase(path);
+    CanStorage storage;
+    if (!storage.open(path.c_str())) return false;
+    const uint64_t logical = loggerVfsStats.databaseLogical, physical = loggerVfsStats.databasePhysical;
+    const uint64_t wal = loggerVfsStats.logicalBytes - logical;
+    const uint64_t extents = loggerVfsStats.extents, blocks = loggerVfsStats.blocks;
+    const uint64_t fill = loggerVfsStats.fillBytes, compressed = loggerVfsStats.pagesCompressed;
+
+    CanColumns cols;
+    CanBatchPool pool(1, DRAIN_BATCH);
+    CanBatch batch = pool.acquire();
+    std::vector<int64_t> latencies;
+    latencies.reserve(samples / CanColumns::CAPACITY + 1);
+    uint64_t n = 0;
+    const uint64_t writeStart = ioWrites();
+    const int64_t start = monotonicNs();
+    for (int round = 1; n < samples; round++) {
+        cols.clear();
+        for (size_t i = 0; i < CanColumns::CAPACITY; i++, n++) {
+            cols.ids[i] = static_cast<uint32_t>(0x100 + n % 6);
+            cols.values[i] = static_cast<int32_t>(1000 + (n / 6) % 500 + (n % 6) * 100);
+            cols.timestamps[i] = static_cast<int64_t>(n * 125);
+            cols.count++;
+        }
+        const int64_t insertStart = monotonicNs();
+        if (storage.insert(cols) != cols.size()) return false;
+        latencies.push_back(monotonicNs() - insertStart);
+        int64_t lastId = 0;
+        if (round % DRAIN_EVERY == 0 && (!storage.fetch(batch, 0, lastId) || !storage.remove(lastId))) return false;
+    }
+    const int64_t wallNs = monotonicNs() - start;
+    const size_t backlog = storage.backlog();
+    storage.close();
+
+    const uint64_t logicalBytes = loggerVfsStats.databaseLogical - logical;
+    const uint64_t physicalBytes = loggerVfsStats.databasePhysical - physical;
+    const uint64_t walBytes = loggerVfsStats.logicalBytes - loggerVfsStats.databaseLogical - wal;
+    const uint64_t writeCalls = ioWrites() - writeStart;
+    struct stat st{};
+    stat(path.c_str(), &st);
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+
+    CanStorage reopened;
+    if (!reopened.open(path.c_str())) return false;
+    const std::string check = integrity(reopened.handle());
+    const size_t restored = reopened.backlog();
+    reopened.close();
+
+    std::cout << "{\"vfs\":\"" << name << "\",\"samples\":" << n << ",\"write_syscalls\":" << writeCalls
+              << ",\"wal_bytes\":" << walBytes
+              << ",\"db_logical_bytes\":" << logicalBytes
+              << ",\"db_physical_bytes\":" << physicalBytes << ",\"write_amplification\":"
+              << (logicalBytes ? static_cast<double>(physicalBytes) / logicalBytes : 0.0)
+              << ",\"extents\":" << loggerVfsStats.extents - extents << ",\"erase_blocks\":"
+              << loggerVfsStats.blocks - blocks << ",\"fill_bytes\":" << loggerVfsStats.fillBytes - fill
+              << ",\"pages_compressed\":" << loggerVfsStats.pagesCompressed - compressed << ",\"db_bytes\":" << st.st_size
+              << ",\"insert_p50_ns\":" << percentile(0.5) << ",\"insert_p99_ns\":" << percentile(0.99)
+              << ",\"insert_max_ns\":" << latencies.back() << ",\"inserts_per_s\":"
+              << static_cast<uint64_t>(n * 1e9 / wallNs) << ",\"integrity\":\"" << check << "\",\"backlog_ok\":"
+              << (restored == backlog ? "true" : "false") << "}" << std::endl;
+    return check == "ok" && restored == backlog;
+}
+
+static void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--samples n] [--erase-kb n] [--db file]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t samples = 500000;
+    size_t eraseKb = 128;
+    std::string db = "/tmp/flash_bench.db";
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--samples") && i + 1 < argc) samples = std::strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--erase-kb") && i + 1 < argc) eraseKb = std::strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--db") && i + 1 < argc) db = argv[++i];
+        else { usage(argv[0]); return 1; }
+    }
+
+    SqliteMemPool::install();
+    bool ok = runFlash("default", db, samples);
+    LoggerVfsOptions options;
+    ok = LoggerVfs::install(options) && runFlash("logger_wal_only", db, samples) && ok;
+    options.eraseBlock = eraseKb * 1024;
+    ok = LoggerVfs::install(options) && runFlash("erase_block", db, samples) && ok;
+    options.eraseBlock = 0;
+    options.compressPages = true;
+    ok = LoggerVfs::install(options) && runFlash("compressed", db, samples) && ok;
+    options.eraseBlock = eraseKb * 1024;
+    ok = LoggerVfs::install(options) && runFlash("erase_block_compressed", db, samples) && ok;
+    removeDatabase(db);
+    return ok ? 0 : 1;
+}
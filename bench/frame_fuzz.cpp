@@ -0,0 +1,618 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Decode and upload round-trip property harness, deterministic from --seed.
+// Batches of random frames (the table's signals at their length, truncated
+// and oversized, unknown, extended and remote ids, DLC 0, random bytes past
+// the DLC) are decoded by the scalar and the SIMD kernel and compared with a
+// byte-at-a-time reading of Signals.hpp. The samples are stored in
+// CanStorage one row per sample and packed, fetched back, encoded to
+// CanLogEntry as the upload does and serialized and deserialized with
+// CanLogEntryPubSubType in XCDR and XCDR2; every stage has to give back what
+// the decode produced. The same samples feed a RollupBuilder, which must
+// emit each bucket once and account for every sample. Before that every value of every signal is encoded
+// with encodeSignal() and decoded back, and config lines with malformed
+// values have to be rejected by parseConfig() without an exception, at the
+// shed level the default config and the --config file have to keep the
+// scales signals, querySamples() has to find every sample of an id in a
+// random range, slice by slice, and fetching up to a watermark then
+// removing, over stamps that step back, has to upload every sample once, and
+// SignalInterest has to keep sending an id for the hold time after the last
+// reader asked for it. The first failure is printed with its seed and batch, exit
+// code 1.
+//
+// --throughput drops the reference checks and times the in-process pipeline
+// per stage (decode, insert, fetch, encode and serialize, remove), one JSON
+// line, a regression benchmark for all of it but the socket and DDS.
+//
+// Built with -DFRAME_FUZZ_LIBFUZZER -fsanitize=fuzzer the same checks run on
+// libFuzzer input, 16 bytes per frame, the input also parsed as config text.
+//
+// usage: frame_fuzz [--seed n] [--batches n] [--config file] [--throughput] [--frames n]
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <random>
+#include <tuple>
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include "Backpressure.hpp"
+#include "CanBatch.hpp"
+#include "CanDecode.hpp"
+#include "CanStorage.hpp"
+#include "Config.hpp"
+#include "Metrics.hpp"
+#include "Rollup.hpp"
+#include "SignalInterest.hpp"
+#include "Signals.hpp"
+#include "DDS/LogEntryPubSubTypes.hpp"
+
+using eprosima::fastdds::dds::DataRepresentationId_t;
+using eprosima::fastdds::rtps::SerializedPayload_t;
+
+constexpr size_t BATCH = CanColumns::CAPACITY;
+constexpr size_t PACK = 16;
+constexpr size_t UPLOAD_BATCH = 256;
+
+static std::string failure;
+
+static bool fail(const std::string& what) {
+    if (failure.empty()) failure = what;
+    return false;
+}
+
+// Signals.hpp read the plain way, one byte at a time, what decodeFrame()
+// and the SIMD kernels must agree with.
+static bool referenceDecode(const struct can_frame& frame, int32_t& value) {
+    for (const SignalDef& s : SIGNALS) {
+        if (frame.can_id != s.can_id) continue;
+        if (frame.can_dlc < s.offset + s.bytes) return false;
+        int64_t raw = 0;
+        for (int b = 0; b < s.bytes; b++) raw = raw * 256 + frame.data[s.offset + b];
+        const int64_t span = int64_t{1} << (8 * s.bytes);
+        if (s.isSigned && raw >= span / 2) raw -= span;
+        value = static_cast<int32_t>(raw + s.bias);
+        return true;
+    }
+    if (frame.can_dlc == 0 || frame.can_dlc > 3 || (frame.can_id & CAN_RTR_FLAG)) return false;
+    value = 0;
+    for (int b = 0; b < frame.can_dlc; b++) value = value * 256 + frame.data[b];
+    return true;
+}
+
+class FrameSource {
+public:
+    explicit FrameSource(uint64_t seed) : rng(seed) {}
+
+    void fill(FrameBatch& batch) {
+        batch.resize(batch.capacity());
+        for (CanRxFrame& rx : batch) {
+            rx = {};
+            struct can_frame& frame = rx.frame;
+            const uint32_t kind = rng() % 16;
+            const SignalDef& signal = SIGNALS[rng() % SIGNALS.size()];
+            if (kind < 9) {
+                frame.can_id = signal.can_id;
+                frame.can_dlc = kind < 7 ? signal.dlc : rng() % (CAN_MAX_DLEN + 1);
+            } else if (kind < 12) {
+                frame.can_id = rng() & CAN_SFF_MASK;
+                frame.can_dlc = rng() % (CAN_MAX_DLEN + 1);
+            } else if (kind < 13) {
+                frame.can_id = CAN_EFF_FLAG | (rng() & CAN_EFF_MASK);
+                frame.can_dlc = rng() % (CAN_MAX_DLEN + 1);
+            } else if (kind < 14) {
+                frame.can_id = CAN_RTR_FLAG | (rng() % 2 ? signal.can_id : rng() & CAN_SFF_MASK);
+                frame.can_dlc = rng() % (CAN_MAX_DLEN + 1);
+            } else {
+                frame.can_id = rng() % 2 ? signal.can_id : rng() & CAN_SFF_MASK;
+                frame.can_dlc = 0;
+            }
+            // bytes past the DLC are random too, decode must not read them
+            const uint64_t bytes = rng();
+            memcpy(frame.data, &bytes, sizeof(frame.data));
+            // mostly small steps, some equal stamps, now and then a jump or a step back
+            const uint32_t step = rng() % 64;
+            clock += step == 0 ? -static_cast<int64_t>(rng() % 1000000) : step == 1 ? int64_t{1} << 32 : rng() % 4000;
+            rx.timestamp = clock;
+        }
+    }
+
+    uint64_t next() { return rng(); }
+
+private:
+    std::mt19937_64 rng;
+    int64_t clock = 1000000;
+};
+
+// encodeSignal() then unpacking gives every value of the signal's field back.
+static bool checkEncode() {
+    bool ok = true;
+    forEachSignal([&ok](auto i) {
+        constexpr SignalDef s = SIGNALS[i];
+        const int64_t span = int64_t{1} << (8 * s.bytes);
+        const int64_t low = (s.isSigned ? -span / 2 : 0) + s.bias;
+        const int64_t high = (s.isSigned ? span / 2 - 1 : span - 1) + s.bias;
+        const int64_t step = span > (1 << 20) ? span >> 20 : 1;
+        for (int64_t v = low; ok && v <= high; v += step) {
+            struct can_frame frame;
+            encodeSignal<i>(frame, static_cast<int32_t>(v));
+            CanData out;
+            int32_t expected = 0;
+            if (!decodeFrame(frame, 0, out) || !referenceDecode(frame, expected) || out.value != v || expected != v) {
+                ok = fail(std::string(s.name) + ": value " + std::to_string(v) + " does not survive encode and decode");
+            }
+        }
+    });
+    return ok;
+}
+
+// Malformed values must fail the line, not throw out of parseConfig().
+static bool checkConfigText(const std::string& text) {
+    LoggerConfig cfg;
+    std::string error;
+    std::istringstream in(text);
+    try {
+        parseConfig(in, cfg, error);
+    } catch (const std::exception& e) {
+        return fail("config '" + text + "' throws " + e.what());
+    }
+    return true;
+}
+
+// A fetched sample is the stored one with its seq.
+static bool sameSample(const CanData& stored, const CanData& fetched) {
+    return stored.can_id == fetched.can_id && stored.value == fetched.value && stored.timestamp == fetched.timestamp;
+}
+
+// Encodes a row as encodeChunk() in can_logger does, round-trips it through
+// CDR in both representations and compares every field.
+static bool checkCdr(CanLogEntryPubSubType& type, const CanData& row) {
+    CanLogEntry sample;
+    sample.index(static_cast<uint32_t>(row.seq));
+    sample.can_id(row.can_id);
+    sample.value(row.value);
+    sample.timestamp(row.timestamp);
+    for (DataRepresentationId_t representation : {DataRepresentationId_t::XCDR_DATA_REPRESENTATION,
+                                                  DataRepresentationId_t::XCDR2_DATA_REPRESENTATION}) {
+        SerializedPayload_t payload(type.calculate_serialized_size(&sample, representation));
+        CanLogEntry back;
+        if (!type.serialize(&sample, payload, representation) || !type.deserialize(payload, &back)) {
+            return fail("CDR round trip fails for seq " + std::to_string(row.seq));
+        }
+        if (back.index() != static_cast<uint32_t>(row.seq) || back.can_id() != static_cast<uint32_t>(row.can_id)
+            || back.value() != row.value || back.timestamp() != row.timestamp) {
+            return fail("CDR round trip changes seq " + std::to_string(row.seq));
+        }
+    }
+    return true;
+}
+
+// Stores the columns, fetches everything back and empties the buffer again.
+static bool checkStorage(const char* name, CanStorage& storage, const CanColumns& cols, CanBatch& fetched,
+                         int64_t& afterId, CanLogEntryPubSubType& type) {
+    if (storage.insert(cols) != cols.size()) return fail(std::string(name) + ": insert failed");
+    size_t n = 0;
+    int64_t lastId = afterId;
+    while (storage.fetch(fetched, lastId, lastId) && !fetched.empty()) {
+        for (const CanData& row : fetched) {
+            if (n >= cols.size() || !sameSample(cols.row(n), row) || row.seq <= afterId) {
+                return fail(std::string(name) + ": fetched sample " + std::to_string(n) + " differs from the stored one");
+            }
+            if (!checkCdr(type, row)) return false;
+            afterId = row.seq;
+            n++;
+        }
+    }
+    if (n != cols.size()) return fail(std::string(name) + ": fetched " + std::to_string(n) + " of " + std::to_string(cols.size()));
+    if (n > 0 && !storage.remove(lastId)) return fail(std::string(name) + ": remove failed");
+    if (storage.backlog() != 0) return fail(std::string(name) + ": backlog left after remove");
+    return true;
+}
+
+struct Harness {
+    CanStorage raw;
+    CanStorage packed;
+    CanBatchPool fetchPool{1, UPLOAD_BATCH};
+    CanBatch fetched = fetchPool.acquire();
+    CanLogEntryPubSubType type;
+    int64_t rawAfter = 0;
+    int64_t packedAfter = 0;
+    RollupBuilder rollups;
+    std::set<std::tuple<int, uint32_t, int64_t>> buckets;
+    uint64_t rolledUp = 0;     // samples in the closed 1 s buckets
+    uint64_t samples = 0;
+
+    bool open() { return raw.open(":memory:") && packed.open(":memory:", PACK); }
+
+    // Every (level, can_id, bucket) is emitted once, however the stamps jump.
+    bool checkRollups(const CanColumns& cols) {
+        bool unique = true;
+        const auto emit = [this, &unique](int level, const RollupRow& row) {
+            unique = buckets.emplace(level, row.can_id, row.bucket).second && unique;
+            if (level == 0) rolledUp += row.count;
+        };
+        for (size_t i = 0; i < cols.size(); i++) {
+            if (cols.ids[i] >= RollupBuilder::SLOTS) continue;
+            rollups.add(cols.ids[i], cols.values[i], cols.timestamps[i], emit);
+            samples++;
+        }
+        return unique || fail("rollup bucket emitted twice");
+    }
+
+    // Closes every bucket: each sample is in one 1 s bucket, or was late and
+    // dropped.
+    bool finish() {
+        bool unique = true;
+        rollups.flushIdle(INT64_MAX / 2, [this, &unique](int level, const RollupRow& row) {
+            unique = buckets.emplace(level, row.can_id, row.bucket).second && unique;
+            if (level == 0) rolledUp += row.count;
+        });
+        if (!unique) return fail("rollup bucket emitted twice");
+        const uint64_t late = rollups.takeLate();
+        if (rolledUp > samples || rolledUp + late < samples) {
+            return fail("rollups hold " + std::to_string(rolledUp) + " samples and " + std::to_string(late)
+                        + " late of " + std::to_string(samples));
+        }
+        return true;
+    }
+
+    bool check(const FrameBatch& frames) {
+        CanColumns expected, scalar, simd;
+        size_t rejected = 0;
+        for (const CanRxFrame& rx : frames) {
+            int32_t value;
+            if (!referenceDecode(rx.frame, value)) {
+                rejected++;
+                continue;
+            }
+            expected.ids[expected.count] = rx.frame.can_id;
+            expected.values[expected.count] = value;
+            expected.timestamps[expected.count] = rx.timestamp;
+            expected.count++;
+        }
+        const size_t rejectedScalar = decodeColumnsScalar(frames, scalar);
+        const size_t rejectedSimd = decodeColumnsSimd(frames, simd);
+        for (const auto& [name, cols, count] : {std::tuple{"scalar", &scalar, rejectedScalar}, {"simd", &simd, rejectedSimd}}) {
+            bool same = count == rejected && cols->count == expected.count;
+            for (size_t i = 0; same && i < expected.count; i++) {
+                same = cols->ids[i] == expected.ids[i] && cols->values[i] == expected.values[i]
+                       && cols->timestamps[i] == expected.timestamps[i];
+            }
+            if (!same) return fail(std::string(name) + " decode differs from the reference");
+        }
+        return checkStorage("one row per sample", raw, expected, fetched, rawAfter, type)
+               && checkStorage("packed", packed, expected, fetched, packedAfter, type) && checkRollups(expected);
+    }
+};
+
+#if defined(FRAME_FUZZ_LIBFUZZER)
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static Harness harness;
+    static FrameBatchPool pool(1, BATCH);
+    static bool ready = checkEncode() && harness.open();
+    if (!ready) abort();
+    FrameBatch frames = pool.acquire();
+    constexpr size_t FRAME_BYTES = 16;
+    for (size_t pos = 0; pos + FRAME_BYTES <= size && !frames.full(); pos += FRAME_BYTES) {
+        CanRxFrame rx = {};
+        memcpy(&rx.frame.can_id, data + pos, sizeof(rx.frame.can_id));
+        rx.frame.can_dlc = data[pos + 4] % (CAN_MAX_DLEN + 1);
+        memcpy(rx.frame.data, data + pos + 8, sizeof(rx.frame.data));
+        rx.timestamp = static_cast<int64_t>(pos);
+        frames.push(rx);
+    }
+    if (!harness.check(frames) || !checkConfigText(std::string(reinterpret_cast<const char*>(data), size))) {
+        std::cerr << failure << std::endl;
+        abort();
+    }
+    return 0;
+}
+#else
+// At the shed level, with the default config and with the shipped one,
+// every scales signal (a production event) is still stored and rolled up.
+static bool checkShed(const std::string& configPath) {
+    LoggerConfig defaults, shipped;
+    if (!configPath.empty()) {
+        std::ifstream in(configPath);
+        std::string error;
+        if (!in || !parseConfig(in, shipped, error)) return fail("cannot read config " + configPath + " " + error);
+    }
+    for (LoggerConfig* cfg : {&defaults, &shipped}) {
+        cfg->degradeRows = {1, 2, 3};
+        cfg->degradeMemoryMb = {0, 0, 0};
+        Backpressure backpressure;
+        backpressure.load(*cfg);
+        backpressure.update(3, 0);
+        if (backpressure.level() != DegradeLevel::Shed) return fail("backpressure does not reach the shed level");
+        CanColumns cols;
+        for (const SignalDef& s : SIGNALS) {
+            cols.ids[cols.count] = s.can_id;
+            cols.values[cols.count] = s.mockMin;
+            cols.timestamps[cols.count] = 0;
+            cols.count++;
+        }
+        const DegradeMasks masks = backpressure.select(cols);
+        for (size_t i = 0; i < SIGNALS.size(); i++) {
+            const uint64_t bit = uint64_t{1} << i;
+            if (SIGNALS[i].source == SignalSource::Scales && !(masks.raw & masks.rollup & bit)) {
+                return fail(std::string(SIGNALS[i].name) + " is shed with the " + (cfg == &defaults ? "default" : "shipped")
+                            + " config");
+            }
+        }
+    }
+    return true;
+}
+
+// querySamples() over rising stamps, one row per sample and packed, with
+// random ranges and slice sizes (below PACK_MAX too), returns exactly the
+// samples of the id in the range, in order, whatever the slice boundaries.
+static bool checkQuery(FrameSource& source) {
+    CanStorage raw, packed;
+    if (!raw.open(":memory:") || !packed.open(":memory:", PACK)) return fail("query: open failed");
+    std::vector<CanData> stored;
+    int64_t clock = 0;
+    for (int b = 0; b < 40; b++) {
+        CanColumns cols;
+        for (size_t i = 0; i < BATCH; i++) {
+            cols.ids[i] = SIGNALS[source.next() % SIGNALS.size()].can_id;
+            cols.values[i] = static_cast<int32_t>(source.next());
+            clock += source.next() % 4 == 0 ? 0 : source.next() % 4000;
+            cols.timestamps[i] = clock;
+            stored.push_back({static_cast<int32_t>(cols.ids[i]), cols.values[i], clock, 0});
+        }
+        cols.count = BATCH;
+        if (raw.insert(cols) != BATCH || packed.insert(cols) != BATCH) return fail("query: insert failed");
+    }
+    std::vector<CanData> slice(300);
+    for (int q = 0; q < 400; q++) {
+        const uint32_t can_id = SIGNALS[source.next() % SIGNALS.size()].can_id;
+        const int64_t fromUs = static_cast<int64_t>(source.next() % (clock + 2000)) - 1000;
+        const int64_t toUs = fromUs + static_cast<int64_t>(source.next() % (clock / 4 + 1));
+        const size_t max = 1 + source.next() % slice.size();
+        std::vector<CanData> expected;
+        for (const CanData& sample : stored) {
+            if (static_cast<uint32_t>(sample.can_id) == can_id && sample.timestamp >= fromUs && sample.timestamp < toUs) {
+                expected.push_back(sample);
+            }
+        }
+        for (const auto& [name, storage] : {std::pair{"one row per sample", &raw}, {"packed", &packed}}) {
+            CanStorage::QueryCursor cursor;
+            size_t n = 0;
+            for (int calls = 0; !cursor.done; calls++) {
+                if (calls > 100000) return fail(std::string(name) + ": query does not end");
+                const size_t count = storage->querySamples(can_id, fromUs, toUs, cursor, slice.data(), max);
+                for (size_t i = 0; i < count; i++, n++) {
+                    if (n >= expected.size() || slice[i].value != expected[n].value
+                        || slice[i].timestamp != expected[n].timestamp) {
+                        return fail(std::string(name) + ": query " + std::to_string(q) + " differs at sample " + std::to_string(n));
+                    }
+                }
+            }
+            if (n != expected.size()) {
+                return fail(std::string(name) + ": query " + std::to_string(q) + " returns " + std::to_string(n) + " of "
+                            + std::to_string(expected.size()));
+            }
+        }
+    }
+    return true;
+}
+
+// Uploads as ShardMerge does, fetching up to a watermark and removing what
+// was fetched, over stamps that step back: every sample comes out once, in
+// seq order, none stamped at or after the watermark it was fetched under.
+static bool checkFetchStop(FrameSource& source) {
+    for (const size_t pack : {size_t{0}, PACK}) {
+        const std::string name = pack ? "packed" : "one row per sample";
+        CanStorage storage;
+        if (!storage.open(":memory:", pack)) return fail(name + ": open failed");
+        CanBatchPool pool(1, UPLOAD_BATCH);
+        CanBatch batch = pool.acquire();
+        std::vector<CanData> stored;
+        int64_t clock = 100000;
+        int64_t after = 0;
+        size_t sent = 0;
+        const auto upload = [&](int64_t beforeUs) {
+            int64_t lastId;
+            while (storage.fetch(batch, after, lastId, beforeUs) && !batch.empty()) {
+                for (const CanData& row : batch) {
+                    if (row.timestamp >= beforeUs) return fail(name + ": fetched a sample past the watermark");
+                    if (sent >= stored.size() || row.seq != static_cast<int64_t>(sent) + 1
+                        || row.value != stored[sent].value || row.timestamp != stored[sent].timestamp) {
+                        return fail(name + ": fetched seq " + std::to_string(row.seq) + ", expected "
+                                    + std::to_string(sent + 1));
+                    }
+                    sent++;
+                }
+                if (!storage.remove(lastId)) return fail(name + ": remove failed");
+                after = lastId;
+            }
+            return true;
+        };
+        for (int round = 0; round < 200; round++) {
+            CanColumns cols;
+            for (size_t i = 0; i < BATCH; i++) {
+                cols.ids[i] = SIGNALS[source.next() % SIGNALS.size()].can_id;
+                cols.values[i] = static_cast<int32_t>(source.next());
+                clock += static_cast<int64_t>(source.next() % 3000) - 1000;
+                cols.timestamps[i] = clock;
+                stored.push_back({static_cast<int32_t>(cols.ids[i]), cols.values[i], clock, 0});
+            }
+            cols.count = BATCH;
+            if (storage.insert(cols) != BATCH) return fail(name + ": insert failed");
+            if (!upload(clock - static_cast<int64_t>(source.next() % 20000))) return false;
+        }
+        if (!upload(INT64_MAX)) return false;
+        if (sent != stored.size() || storage.backlog() != 0) {
+            return fail(name + ": " + std::to_string(sent) + " of " + std::to_string(stored.size()) + " samples uploaded");
+        }
+    }
+    return true;
+}
+
+// Random reader sets over time against a model of the hold: an id is sent
+// while some reader asked for it within the hold, and with no reader
+// matched every id counts as asked for.
+static bool checkInterest(FrameSource& source) {
+    constexpr int64_t HOLD = 10000;
+    const uint32_t ids[] = {0x100, 0x101, 0x103, 0x200, 0x7FF, 0x12345678};
+    SignalInterest interest;
+    std::map<size_t, int64_t> asked;
+    int64_t now = 0;
+    for (int step = 0; step < 2000; step++) {
+        now += static_cast<int64_t>(source.next() % 4000);
+        std::vector<SignalInterest::Reader> readers(source.next() % 3);
+        for (SignalInterest::Reader& reader : readers) {
+            if (source.next() % 4 == 0) continue;
+            std::vector<uint32_t> some;
+            for (uint32_t can_id : ids) {
+                if (source.next() % 3 == 0) some.push_back(can_id);
+            }
+            reader.narrow(some);
+        }
+        interest.set(readers, now, HOLD);
+        for (uint32_t can_id : ids) {
+            bool wanted = readers.empty();
+            for (const SignalInterest::Reader& reader : readers) {
+                wanted = wanted || reader.all || std::count(reader.ids.begin(), reader.ids.end(), can_id);
+            }
+            const size_t slot = LimitTable::slot(can_id);
+            if (wanted || !asked.count(slot)) asked[slot] = now;
+            if (interest.wants(can_id) != (now - asked[slot] < HOLD)) {
+                return fail("id " + std::to_string(can_id) + " sent " + std::to_string(interest.wants(can_id))
+                            + " at " + std::to_string(now) + ", last asked for at " + std::to_string(asked[slot]));
+            }
+        }
+    }
+    return true;
+}
+
+// Config lines of a random key and a random mix of bad numbers and words.
+static bool checkConfig(FrameSource& source, int lines) {
+    static const char* keys[] = {"pack_samples", "dds_domain", "max_samples", "rt_cpu", "rcvbuf_bytes", "io_threads",
+                                 "flash_erase_block_kb", "min_entries_to_send", "max_buffered_rows", "bus_bitrate",
+                                 "degrade_rows", "critical_ids", "filter", "signal.0x100", "signal.x", "shard.a",
+                                 "alarm.a", "interest_hold_s"};
+    static const char* words[] = {"", "0", "-1", "0x", "0x1FFFFFFFF", "99999999999999999999", "-99999999999999999999",
+                                  "abc", "1e9", ",", "-", "1-", "0x100-", "cpu", "ids", "and", ">", "rate", "hyst",
+                                  "Name", "kg", "7", "0x100"};
+    for (int n = 0; n < lines; n++) {
+        std::string value;
+        for (uint64_t w = source.next() % 6; w > 0; w--) {
+            value += words[source.next() % std::size(words)];
+            value += " ,"[source.next() % 2];
+        }
+        if (!checkConfigText(std::string(keys[source.next() % std::size(keys)]) + " = " + value)) return false;
+    }
+    return true;
+}
+
+// Frames through decode, insert, fetch, encode and serialize and remove, as
+// the logger moves them, each stage timed over the whole run.
+static int throughput(uint64_t seed, uint64_t frames) {
+    constexpr size_t BATCHES = 64;
+    FrameBatchPool pool(BATCHES, BATCH);
+    FrameBatch batches[BATCHES];
+    FrameSource source(seed);
+    for (FrameBatch& batch : batches) {
+        batch = pool.acquire();
+        source.fill(batch);
+    }
+    CanStorage storage;
+    if (!storage.open(":memory:")) return 1;
+    CanBatchPool fetchPool(1, UPLOAD_BATCH);
+    CanBatch fetched = fetchPool.acquire();
+    CanLogEntryPubSubType type;
+    CanLogEntry sample;
+    SerializedPayload_t payload(type.calculate_serialized_size(&sample, DataRepresentationId_t::XCDR_DATA_REPRESENTATION));
+    CanColumns cols;
+    int64_t decodeNs = 0, insertNs = 0, fetchNs = 0, serializeNs = 0, removeNs = 0;
+    uint64_t n = 0, samples = 0, bytes = 0;
+    int64_t lastId = 0;
+    const int64_t start = monotonicNs();
+    for (size_t b = 0; n < frames; b++, n += BATCH) {
+        int64_t t = monotonicNs();
+        cols.clear();
+        decodeColumns(batches[b % BATCHES], cols);
+        decodeNs += monotonicNs() - t;
+        t = monotonicNs();
+        if (storage.insert(cols) != cols.size()) return 1;
+        insertNs += monotonicNs() - t;
+        if (storage.backlog() < UPLOAD_BATCH) continue;
+        t = monotonicNs();
+        if (!storage.fetch(fetched, lastId, lastId)) return 1;
+        fetchNs += monotonicNs() - t;
+        t = monotonicNs();
+        for (const CanData& row : fetched) {
+            sample.index(static_cast<uint32_t>(row.seq));
+            sample.can_id(row.can_id);
+            sample.value(row.value);
+            sample.timestamp(row.timestamp);
+            if (!type.serialize(&sample, payload, DataRepresentationId_t::XCDR_DATA_REPRESENTATION)) return 1;
+            bytes += payload.length;
+        }
+        samples += fetched.size();
+        serializeNs += monotonicNs() - t;
+        t = monotonicNs();
+        if (!storage.remove(lastId)) return 1;
+        removeNs += monotonicNs() - t;
+    }
+    const int64_t wallNs = monotonicNs() - start;
+    const auto perFrame = [n](int64_t ns) { return static_cast<double>(ns) / n; };
+    std::cout << "{\"isa\":\"" << canDecodeIsa() << "\",\"frames\":" << n << ",\"samples_uploaded\":" << samples
+              << ",\"frames_per_s\":" << static_cast<uint64_t>(n * 1e9 / wallNs)
+              << ",\"decode_ns_per_frame\":" << perFrame(decodeNs) << ",\"insert_ns_per_frame\":" << perFrame(insertNs)
+              << ",\"fetch_ns_per_frame\":" << perFrame(fetchNs) << ",\"serialize_ns_per_frame\":" << perFrame(serializeNs)
+              << ",\"remove_ns_per_frame\":" << perFrame(removeNs) << ",\"cdr_bytes\":" << bytes << "}" << std::endl;
+    return 0;
+}
+
+static void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--seed n] [--batches n] [--config file] [--throughput] [--frames n]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t seed = 1;
+    uint64_t batches = 20000;
+    uint64_t frames = 5000000;
+    std::string configPath;
+    bool bench = false;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--batches") && i + 1 < argc) batches = std::strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--frames") && i + 1 < argc) frames = std::strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--config") && i + 1 < argc) configPath = argv[++i];
+        else if (!strcmp(argv[i], "--throughput")) bench = true;
+        else { usage(argv[0]); return 1; }
+    }
+    if (bench) return throughput(seed, frames);
+
+    FrameSource source(seed);
+    Harness harness;
+    if (!harness.open()) return 1;
+    FrameBatchPool pool(1, BATCH);
+    FrameBatch batch = pool.acquire();
+    uint64_t b = 0;
+    bool ok = checkEncode() && checkConfig(source, 20000) && checkShed(configPath) && checkQuery(source)
+              && checkFetchStop(source) && checkInterest(source);
+    for (; ok && b < batches; b++) {
+        source.fill(batch);
+        ok = harness.check(batch);
+    }
+    ok = ok && harness.finish();
+    std::cout << "{\"seed\":" << seed << ",\"batches\":" << b << ",\"frames\":" << b * BATCH << ",\"result\":\""
+              << (ok ? "ok" : "fail") << "\"}" << std::endl;
+    if (!ok) std::cerr << "seed " << seed << " batch " << (b ? b - 1 : 0) << ": " << failure << std::endl;
+    return ok ? 0 : 1;
+}
+#endif
@@ -0,0 +1,29 @@
+#!/bin/sh
+# Runs can_logger on vcan0 with a bench alarm rule added to its config and
+# measures frame to alarm latency with alarm_bench, prints one JSON line.
+#
+# usage: run_alarm_bench.sh <build dir> [frames]
+
+BIN=${1:-.}
+COUNT=${2:-1000}
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+CONF="$BIN/alarm_bench.conf"
+
+if ! ip link show vcan0 >/dev/null 2>&1; then
+    echo "vcan0 is not configured, see README.md" >&2
+    exit 1
+fi
+
+cp "$SRC/can_logger.conf" "$CONF"
+echo "print_frames = false" >> "$CONF"
+echo "alarm.bench = 0x7F0 > 100" >> "$CONF"
+
+"$BIN/can_logger" "$CONF" >/dev/null 2>&1 &
+LOGGER=$!
+sleep 1
+"$BIN/alarm_bench" --id 0x7F0 --threshold 100 --count $COUNT
+RC=$?
+kill $LOGGER 2>/dev/null
+wait 2>/dev/null
+rm -f "$CONF"
+exit $RC
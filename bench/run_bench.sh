@@ -0,0 +1,36 @@
+#!/bin/sh
+# Runs can_logger with both mocks on vcan0 and a local DDS subscriber probe,
+# prints one JSON result line (also appended to bench_results.jsonl).
+#
+# usage: run_bench.sh <build dir> [duration s] [ecu_mock period us]
+
+BIN=${1:-.}
+DURATION=${2:-30}
+PERIOD=${3:-1000}
+WARMUP=5
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+
+if ! ip link show vcan0 >/dev/null 2>&1; then
+    echo "vcan0 is not configured, see README.md" >&2
+    exit 1
+fi
+
+LABEL=$(git -C "$SRC" rev-parse --short HEAD 2>/dev/null || echo unknown)
+
+"$BIN/can_logger" >/dev/null &
+LOGGER=$!
+"$BIN/can_bench" --pid $LOGGER --duration $DURATION --warmup $WARMUP --label "$LABEL" > "$BIN/bench_last.json" &
+PROBE=$!
+"$BIN/ecu_mock" $PERIOD >/dev/null &
+ECU=$!
+"$BIN/scales_mock" >/dev/null &
+SCALES=$!
+
+wait $PROBE
+RC=$?
+kill $ECU $SCALES $LOGGER 2>/dev/null
+wait 2>/dev/null
+
+cat "$BIN/bench_last.json"
+cat "$BIN/bench_last.json" >> "$BIN/bench_results.jsonl"
+exit $RC
@@ -0,0 +1,149 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Sharded ingestion benchmark: 1 to 4 threads insert mock-like batches into
+// in-memory buffers, either all into one buffer under one lock (the layout
+// before shards) or each into a buffer of its own, as can_logger's shard
+// threads do. Then the sharded buffers are drained through ShardMerge as
+// the upload does, checking that the stream comes out in timestamp order
+// with every sample once and each shard's indexes consecutive. Prints one JSON line per run; inserts_per_s is
+// over all threads, so near-linear scaling needs as many free cores. SQLite
+// allocates through SqliteMemPool, an arena per thread, as in can_logger.
+//
+// usage: shard_bench [samples per thread] [pack samples]
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include "CanBatch.hpp"
+#include "CanStorage.hpp"
+#include "Metrics.hpp"
+#include "ShardMerge.hpp"
+#include "SqliteMemPool.hpp"
+
+constexpr size_t DRAIN_BATCH = 256;
+
+// Shard k of n: its own ids, a frame every 125 µs per shard, phases offset
+// so the shards interleave.
+static void fillBatch(CanColumns& cols, uint64_t& n, size_t shard) {
+    cols.clear();
+    for (size_t i = 0; i < CanColumns::CAPACITY; i++, n++) {
+        cols.ids[i] = static_cast<uint32_t>(0x100 + shard * 0x10 + n % 4);
+        cols.values[i] = static_cast<int32_t>(1000 + (n / 4) % 500);
+        cols.timestamps[i] = static_cast<int64_t>(n * 125 + shard * 31);
+        cols.count++;
+    }
+}
+
+static void report(const char* layout, size_t threads, uint64_t samples, int64_t insertNs, int64_t mergeNs) {
+    std::cout << "{\"layout\":\"" << layout << "\",\"threads\":" << threads << ",\"samples\":" << samples
+              << ",\"inserts_per_s\":" << static_cast<uint64_t>(samples * 1e9 / insertNs);
+    if (mergeNs > 0) std::cout << ",\"merged_per_s\":" << static_cast<uint64_t>(samples * 1e9 / mergeNs);
+    std::cout << "}" << std::endl;
+}
+
+// Times threads inserting perThread samples each; insert(shard, cols) is
+// called from thread shard.
+template <typename Insert>
+static int64_t timeInserts(size_t threads, uint64_t perThread, Insert insert) {
+    std::vector<std::thread> workers;
+    const int64_t start = monotonicNs();
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([t, perThread, &insert] {
+            SqliteMemPool::useArena(t + 1);   // as can_logger's receive threads
+            CanColumns cols;
+            uint64_t n = 0;
+            while (n < perThread) {
+                fillBatch(cols, n, t);
+                insert(t, cols);
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    return monotonicNs() - start;
+}
+
+static bool runShared(size_t threads, uint64_t perThread, size_t pack) {
+    CanStorage storage;
+    std::mutex lock;
+    if (!storage.open(":memory:", pack)) return false;
+    const int64_t insertNs = timeInserts(threads, perThread, [&](size_t, const CanColumns& cols) {
+        std::lock_guard<std::mutex> guard(lock);
+        storage.insert(cols);
+    });
+    const uint64_t stored = storage.backlog();
+    report("shared", threads, stored, insertNs, 0);
+    return stored == threads * perThread;
+}
+
+static bool runSharded(size_t threads, uint64_t perThread, size_t pack) {
+    std::unique_ptr<CanStorage[]> storages(new CanStorage[threads]);
+    std::unique_ptr<std::mutex[]> locks(new std::mutex[threads]);
+    std::unique_ptr<std::atomic<int64_t>[]> watermarks(new std::atomic<int64_t>[threads]);
+    for (size_t t = 0; t < threads; t++) {
+        if (!storages[t].open(":memory:", pack)) return false;
+        watermarks[t] = INT64_MAX;
+    }
+    const int64_t insertNs = timeInserts(threads, perThread, [&](size_t shard, const CanColumns& cols) {
+        std::lock_guard<std::mutex> guard(locks[shard]);
+        storages[shard].insert(cols);
+    });
+
+    CanBatchPool pool(threads + 1, DRAIN_BATCH);
+    ShardMerge merge;
+    for (size_t t = 0; t < threads; t++) merge.add(storages[t], locks[t], watermarks[t], pool.acquire());
+    CanBatch chunk = pool.acquire();
+    ShardCursor cursor;
+    uint64_t merged = 0;
+    int64_t previous = INT64_MIN;
+    std::vector<int64_t> nextSeq(threads, 1);
+    bool ordered = true;
+    bool indexed = true;
+    const int64_t start = monotonicNs();
+    merge.begin();
+    while (true) {
+        ShardCursor last;
+        if (!merge.fetch(chunk, cursor, last)) return false;
+        if (chunk.empty()) break;
+        for (const CanData& sample : chunk) {
+            if (sample.timestamp < previous) ordered = false;
+            previous = sample.timestamp;
+            const uint32_t index = static_cast<uint32_t>(sample.seq);
+            const size_t shard = indexShard(index);
+            if (shard >= threads || index != sampleIndex(shard, nextSeq[shard]++)) indexed = false;
+        }
+        merged += chunk.size();
+        if (!merge.commit(last)) return false;
+        cursor = last;
+    }
+    const int64_t mergeNs = monotonicNs() - start;
+    report("sharded", threads, merged, insertNs, mergeNs);
+    if (!ordered) std::cerr << "Merged stream out of timestamp order" << std::endl;
+    if (!indexed) std::cerr << "Merged stream skips or repeats a shard's index" << std::endl;
+    return ordered && indexed && merged == threads * perThread;
+}
+
+int main(int argc, char* argv[]) {
+    // whole batches only
+    const uint64_t requested = argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 500000;
+    const uint64_t perThread = (requested + CanColumns::CAPACITY - 1) / CanColumns::CAPACITY * CanColumns::CAPACITY;
+    const size_t pack = argc > 2 ? std::strtoul(argv[2], nullptr, 0) : 64;
+
+    // SQLite allocates through the pool, as in can_logger
+    if (!SqliteMemPool::install()) return 1;
+
+    bool ok = true;
+    for (size_t threads = 1; threads <= MAX_SHARDS; threads++) {
+        ok = runShared(threads, perThread, pack) && ok;
+        ok = runSharded(threads, perThread, pack) && ok;
+    }
+    return ok ? 0 : 1;
+}
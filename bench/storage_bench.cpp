@@ -0,0 +1,182 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Storage schema benchmark: inserts the same synthetic samples in 64-row
+// transactions into the previous schema (AUTOINCREMENT id, default pragmas)
+// and into CanStorage with one row per sample and with packed rows, in
+// memory and on disk, then drains them as the upload does. Prints one JSON
+// line per run: inserted and drained samples/s and bytes per sample of the
+// raw sample table (from dbstat, whole file if that isn't compiled in).
+//
+// usage: storage_bench [samples] [disk file]
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <sqlite3.h>
+#include "CanBatch.hpp"
+#include "CanStorage.hpp"
+#include "Metrics.hpp"
+
+constexpr size_t DRAIN_BATCH = 256;
+
+// Mock-like traffic: the six ecu_mock/scales_mock ids, slowly moving values,
+// a frame every 100-150 µs.
+static void fillBatch(CanColumns& cols, uint64_t& n) {
+    static const uint32_t ids[] = {0x100, 0x101, 0x102, 0x103, 0x104, 0x105};
+    cols.clear();
+    for (size_t i = 0; i < CanColumns::CAPACITY; i++, n++) {
+        cols.ids[i] = ids[n % 6];
+        cols.values[i] = static_cast<int32_t>(1000 + (n / 6) % 500 + (n % 6) * 100);
+        cols.timestamps[i] = static_cast<int64_t>(n * 125 + (n * 7919) % 50);
+        cols.count++;
+    }
+}
+
+static int64_t scalar(sqlite3* db, const char* sql) {
+    sqlite3_stmt* stmt = nullptr;
+    int64_t v = -1;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        v = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return v;
+}
+
+static double bytesPerSample(sqlite3* db, uint64_t samples) {
+    int64_t bytes = scalar(db, "SELECT SUM(pgsize) FROM dbstat WHERE name LIKE 'can_data%';");
+    if (bytes < 0) {
+        bytes = (scalar(db, "PRAGMA page_count;") - scalar(db, "PRAGMA freelist_count;")) * scalar(db, "PRAGMA page_size;");
+    }
+    return static_cast<double>(bytes) / samples;
+}
+
+static void report(const char* schema, const char* where, uint64_t samples, int64_t insertNs, int64_t drainNs,
+                   double bytes) {
+    std::cout << "{\"schema\":\"" << schema << "\",\"db\":\"" << where << "\",\"samples\":" << samples
+              << ",\"inserts_per_s\":" << static_cast<uint64_t>(samples * 1e9 / insertNs)
+              << ",\"drained_per_s\":" << static_cast<uint64_t>(samples * 1e9 / drainNs)
+              << ",\"bytes_per_sample\":" << bytes << "}" << std::endl;
+}
+
+// The schema and statements CanStorage used before seq keys and packing.
+static bool runLegacy(const char* path, const char* where, uint64_t samples) {
+    sqlite3* db = nullptr;
+    if (sqlite3_open(path, &db) != SQLITE_OK
+        || sqlite3_exec(db, "CREATE TABLE can_data (id INTEGER PRIMARY KEY AUTOINCREMENT, can_id INT NOT NULL,"
+                            "value INT NOT NULL, timestamp INT64 NOT NULL);", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        std::cerr << "SQL error: " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_close(db);
+        return false;
+    }
+    sqlite3_stmt *insert, *select, *del;
+    sqlite3_prepare_v2(db, "INSERT INTO can_data (can_id, value, timestamp) VALUES (?, ?, ?);", -1, &insert, nullptr);
+    sqlite3_prepare_v2(db, "SELECT id, can_id, value, timestamp FROM can_data ORDER BY id LIMIT ?;", -1, &select, nullptr);
+    sqlite3_prepare_v2(db, "DELETE FROM can_data WHERE id <= ?;", -1, &del, nullptr);
+
+    CanColumns cols;
+    uint64_t n = 0;
+    int64_t start = monotonicNs();
+    while (n < samples) {
+        fillBatch(cols, n);
+        sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+        for (size_t i = 0; i < cols.size(); i++) {
+            sqlite3_bind_int(insert, 1, static_cast<int>(cols.ids[i]));
+            sqlite3_bind_int(insert, 2, cols.values[i]);
+            sqlite3_bind_int64(insert, 3, cols.timestamps[i]);
+            sqlite3_step(insert);
+            sqlite3_reset(insert);
+        }
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    }
+    const int64_t insertNs = monotonicNs() - start;
+    const double bytes = bytesPerSample(db, n);
+
+    uint64_t checksum = 0;
+    start = monotonicNs();
+    while (true) {
+        int64_t lastId = 0;
+        sqlite3_bind_int64(select, 1, DRAIN_BATCH);
+        while (sqlite3_step(select) == SQLITE_ROW) {
+            lastId = sqlite3_column_int64(select, 0);
+            checksum += sqlite3_column_int(select, 2);
+        }
+        sqlite3_reset(select);
+        if (lastId == 0) break;
+        sqlite3_bind_int64(del, 1, lastId);
+        sqlite3_step(del);
+        sqlite3_reset(del);
+    }
+    const int64_t drainNs = monotonicNs() - start;
+
+    sqlite3_finalize(insert);
+    sqlite3_finalize(select);
+    sqlite3_finalize(del);
+    sqlite3_close(db);
+    report("legacy", where, n, insertNs, drainNs, bytes);
+    return checksum != 0;
+}
+
+static bool runStorage(const char* path, const char* where, size_t pack, uint64_t samples) {
+    CanStorage storage;
+    if (!storage.open(path, pack)) return false;
+
+    CanColumns cols;
+    uint64_t n = 0;
+    int64_t start = monotonicNs();
+    while (n < samples) {
+        fillBatch(cols, n);
+        if (storage.insert(cols) != cols.size()) return false;
+    }
+    const int64_t insertNs = monotonicNs() - start;
+    const double bytes = bytesPerSample(storage.handle(), n);
+
+    CanBatchPool pool(1, DRAIN_BATCH);
+    CanBatch batch = pool.acquire();
+    uint64_t drained = 0;
+    start = monotonicNs();
+    while (storage.backlog() > 0) {
+        int64_t lastId = 0;
+        if (!storage.fetch(batch, 0, lastId) || batch.empty() || !storage.remove(lastId)) return false;
+        drained += batch.size();
+    }
+    const int64_t drainNs = monotonicNs() - start;
+    if (drained != n) {
+        std::cerr << "Drained " << drained << " of " << n << " samples" << std::endl;
+        return false;
+    }
+
+    const std::string schema = pack ? "packed" + std::to_string(storage.packSamples()) : "rows";
+    report(schema.c_str(), where, n, insertNs, drainNs, bytes);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    const uint64_t samples = argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 1000000;
+    const std::string disk = argc > 2 ? argv[2] : "storage_bench.db";
+
+    bool ok = true;
+    for (const bool onDisk : {false, true}) {
+        const char* path = onDisk ? disk.c_str() : ":memory:";
+        const char* where = onDisk ? "disk" : "memory";
+        for (int run = 0; run < 4; run++) {
+            if (onDisk) {
+                std::remove(disk.c_str());
+                std::remove((disk + "-wal").c_str());
+                std::remove((disk + "-shm").c_str());
+            }
+            ok = (run == 0 ? runLegacy(path, where, samples) : runStorage(path, where, run == 1 ? 0 : run == 2 ? 16 : 64, samples))
+                 && ok;
+        }
+    }
+    std::remove(disk.c_str());
+    std::remove((disk + "-wal").c_str());
+    std::remove((disk + "-shm").c_str());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Tracing overhead benchmark, built twice: trace_bench with CANLOGGER_TRACE
+// and trace_bench_off without. Times an empty span and the receive path's
+// decode and insert stages with their spans, as can_logger traces them, and
+// prints one JSON line; the off build is the baseline. The traced build
+// also writes the rings out as the SIGUSR2 dump does and times that.
+//
+// usage: trace_bench [batches] [trace file]
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "CanBatch.hpp"
+#include "CanDecode.hpp"
+#include "CanStorage.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+
+constexpr size_t BATCH = CanColumns::CAPACITY;
+constexpr size_t BATCHES = 64;   // distinct batches cycled through
+
+#if defined(CANLOGGER_TRACE)
+constexpr bool TRACED = true;
+#else
+constexpr bool TRACED = false;
+#endif
+
+// ns per span that covers no work at all.
+static double spanNs(uint64_t spans) {
+    volatile uint64_t sink = 0;
+    const int64_t start = monotonicNs();
+    for (uint64_t i = 0; i < spans; i++) {
+        TRACE_SPAN("empty");
+        sink = sink + i;
+    }
+    return static_cast<double>(monotonicNs() - start) / spans;
+}
+
+int main(int argc, char* argv[]) {
+    const uint64_t rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    const std::string tracePath = argc > 2 ? argv[2] : "/tmp/trace_bench.json";
+
+    FrameBatchPool pool(BATCHES, BATCH);
+    FrameBatch batches[BATCHES];
+    std::srand(1);
+    for (size_t b = 0; b < BATCHES; b++) {
+        batches[b] = pool.acquire();
+        batches[b].resize(BATCH);
+        for (size_t f = 0; f < BATCH; f++) {
+            CanRxFrame& rx = batches[b][f];
+            rx = {};
+            const SignalDef& signal = SIGNALS[std::rand() % SIGNALS.size()];
+            rx.frame.can_id = signal.can_id;
+            rx.frame.can_dlc = signal.dlc;
+            for (int i = 0; i < 8; i++) rx.frame.data[i] = std::rand() & 0xFF;
+            rx.timestamp = static_cast<int64_t>(b * BATCH + f);
+        }
+    }
+    CanStorage storage;
+    if (!storage.open(":memory:")) return 1;
+
+    const double emptySpanNs = spanNs(rounds * 64);
+
+    CanColumns cols;
+    int64_t decodeNs = 0, insertNs = 0;
+    for (uint64_t r = 0; r < rounds; r++) {
+        int64_t t = monotonicNs();
+        {
+            TRACE_SPAN("decode", static_cast<int64_t>(BATCH));
+            cols.clear();
+            decodeColumns(batches[r % BATCHES], cols);
+        }
+        decodeNs += monotonicNs() - t;
+        t = monotonicNs();
+        {
+            TRACE_SPAN("insert", static_cast<int64_t>(cols.size()));
+            if (storage.insert(cols) != cols.size()) return 1;
+        }
+        insertNs += monotonicNs() - t;
+        // keep the table small, the upload would
+        if (storage.backlog() >= 4096 && !storage.remove(static_cast<int64_t>((r + 1) * BATCH))) return 1;
+    }
+
+    std::cout << "{\"trace\":" << (TRACED ? "true" : "false") << ",\"span_ns\":" << emptySpanNs
+              << ",\"decode_ns_per_batch\":" << static_cast<double>(decodeNs) / rounds
+              << ",\"insert_ns_per_batch\":" << static_cast<double>(insertNs) / rounds;
+#if defined(CANLOGGER_TRACE)
+    const int64_t start = monotonicNs();
+    const size_t spans = writeTrace(tracePath);
+    std::cout << ",\"dump_spans\":" << spans << ",\"dump_ms\":" << static_cast<double>(monotonicNs() - start) / 1e6;
+#endif
+    std::cout << "}" << std::endl;
+    return 0;
+}
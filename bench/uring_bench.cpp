@@ -0,0 +1,313 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// io_uring ingest benchmark, system calls and CPU time of the receiving or
+// inserting thread per frame or sample:
+//  - receive: a sender thread writes frames in bursts, the receiver waits
+//    and reads them the way can_logger's receive task does, epoll_ctl +
+//    epoll_wait per wait, then either recvmmsg() or the multishot ring.
+//    Frames go over a CAN interface with --can (vcan works), otherwise over
+//    a UDP socket on loopback carrying the 16-byte can_frame, with the same
+//    timestamp and drop count control messages.
+//  - storage: CanStorage inserts in 64-sample transactions into a WAL
+//    database on disk, with the default VFS, with the logger VFS issuing
+//    merged writes with pwrite() and with it on io_uring. read/write family
+//    calls come from /proc/self/io, fsyncs aren't in there and are the same
+//    number on every run.
+// Prints one JSON line per run.
+//
+// usage: uring_bench [--frames n] [--samples n] [--can ifname] [--db file]
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include "CanBatch.hpp"
+#include "CanStorage.hpp"
+#include "IoUring.hpp"
+#include "Metrics.hpp"
+#include "Realtime.hpp"
+#include "SqliteMemPool.hpp"
+#include "SqliteVfs.hpp"
+#include "Timestamp.hpp"
+
+constexpr size_t FRAME_BATCH = 64;        // as can_logger
+constexpr size_t BURST = 32;              // frames per sendmmsg()
+constexpr int64_t BURST_INTERVAL_NS = 250000;
+constexpr int64_t QUIET_NS = 200000000;   // receiver gives up this long after the sender finished
+constexpr size_t RX_CONTROL = RX_CONTROL_SIZE + RX_DROPS_CONTROL_SIZE;
+
+static int64_t threadCpuNs() {
+    struct rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000LL
+        + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000LL;
+}
+
+// read and write family system calls of the process so far
+static uint64_t ioSyscalls() {
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    uint64_t value, total = 0;
+    while (io >> key >> value) {
+        if (key == "syscr:" || key == "syscw:") total += value;
+    }
+    return total;
+}
+
+static int openCan(const char* interface) {
+    const int s = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (s < 0) {
+        perror("Socket");
+        return -1;
+    }
+    struct ifreq ifr{};
+    strncpy(ifr.ifr_name, interface, IFNAMSIZ - 1);
+    struct sockaddr_can addr{};
+    addr.can_family = AF_CAN;
+    if (ioctl(s, SIOCGIFINDEX, &ifr) < 0 || (addr.can_ifindex = ifr.ifr_ifindex,
+                                             bind(s, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0)) {
+        perror(interface);
+        close(s);
+        return -1;
+    }
+    return s;
+}
+
+// Receiver and sender sockets, connected to each other.
+static bool openPair(const char* canInterface, int& rx, int& tx) {
+    if (canInterface != nullptr) {
+        rx = openCan(canInterface);
+        tx = rx < 0 ? -1 : openCan(canInterface);
+    } else {
+        struct sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        rx = socket(AF_INET, SOCK_DGRAM, 0);
+        tx = socket(AF_INET, SOCK_DGRAM, 0);
+        if (rx < 0 || tx < 0 || bind(rx, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0
+            || getsockname(rx, reinterpret_cast<struct sockaddr*>(&addr), &len) < 0
+            || connect(tx, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+            perror("UDP loopback");
+            return false;
+        }
+    }
+    if (rx < 0 || tx < 0) return false;
+    setReceiveBuffer(rx, 1 << 20);
+    enableRxDropCount(rx);
+    enableRxTimestamps(rx);
+    return true;
+}
+
+static void sendFrames(int tx, uint64_t frames) {
+    struct can_frame burst[BURST]{};
+    struct iovec iov[BURST];
+    struct mmsghdr msgs[BURST]{};
+    for (size_t i = 0; i < BURST; i++) {
+        iov[i] = {&burst[i], sizeof(struct can_frame)};
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int64_t next = monotonicNs();
+    for (uint64_t sent = 0; sent < frames;) {
+        const size_t n = frames - sent < BURST ? frames - sent : BURST;
+        for (size_t i = 0; i < n; i++) {
+            burst[i].can_id = 0x100 + (sent + i) % 6;
+            burst[i].can_dlc = 4;
+            memcpy(burst[i].data, &sent, 4);
+        }
+        const int done = sendmmsg(tx, msgs, n, 0);
+        if (done < 0) {
+            if (errno == ENOBUFS || errno == EAGAIN) continue;   // CAN tx queue full
+            perror("sendmmsg");
+            return;
+        }
+        sent += done;
+        next += BURST_INTERVAL_NS;
+        const struct timespec until = {next / 1000000000, next % 1000000000};
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, nullptr);
+    }
+}
+
+static ssize_t readBatch(int s, struct can_frame* frames, uint32_t& drops) {
+    struct mmsghdr msgs[FRAME_BATCH];
+    struct iovec iov[FRAME_BATCH];
+    alignas(struct cmsghdr) char control[FRAME_BATCH][RX_CONTROL];
+    for (size_t i = 0; i < FRAME_BATCH; i++) {
+        iov[i] = {&frames[i], sizeof(struct can_frame)};
+        msgs[i] = {};
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = control[i];
+        msgs[i].msg_hdr.msg_controllen = RX_CONTROL;
+    }
+    int n = recvmmsg(s, msgs, FRAME_BATCH, MSG_DONTWAIT, nullptr);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) n = 0;
+    for (int i = 0; i < n; i++) rxTimestampNs(msgs[i].msg_hdr);
+    if (n > 0) rxDropCount(msgs[n - 1].msg_hdr, drops);
+    return n;
+}
+
+static bool runReceive(const char* canInterface, bool useRing, uint64_t frames) {
+    int rx, tx;
+    if (!openPair(canInterface, rx, tx)) return false;
+    RingReceiver ring;
+    if (useRing && !ring.open(rx, RX_CONTROL, sizeof(struct can_frame))) {
+        perror("io_uring receive");
+        close(rx);
+        close(tx);
+        return false;
+    }
+    const int waitFd = useRing ? ring.fd() : rx;
+    const int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event{};
+    event.events = EPOLLIN | EPOLLONESHOT;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, waitFd, &event);
+
+    std::atomic<int64_t> sentNs{0};
+    std::thread sender([tx, frames, &sentNs] {
+        sendFrames(tx, frames);
+        sentNs = monotonicNs();
+    });
+    struct can_frame batch[FRAME_BATCH];
+    uint64_t received = 0;
+    uint64_t syscalls = 0;
+    uint32_t drops = 0;
+    bool full = false;
+    const int64_t cpuStart = threadCpuNs();
+    const int64_t start = monotonicNs();
+    while (received < frames) {
+        const int64_t finished = sentNs.load();
+        if (finished && monotonicNs() - finished > QUIET_NS) break;
+        if (!full) {
+            // as IoLoop::readable(): rearm the one-shot registration, wait
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, waitFd, &event);
+            struct epoll_event ready;
+            epoll_wait(epollFd, &ready, 1, 100);
+            syscalls += 2;
+        }
+        ssize_t n;
+        if (useRing) {
+            size_t count = 0;
+            n = ring.receive(FRAME_BATCH, [&](struct msghdr& control, const char* payload, size_t length) {
+                if (length != sizeof(struct can_frame)) return;
+                memcpy(&batch[count++], payload, sizeof(struct can_frame));
+                rxTimestampNs(control);
+                rxDropCount(control, drops);
+            });
+        } else {
+            n = readBatch(rx, batch, drops);
+            syscalls++;
+        }
+        if (n < 0) {
+            perror("Read");
+            break;
+        }
+        received += n;
+        full = n == static_cast<ssize_t>(FRAME_BATCH);
+    }
+    const int64_t cpuNs = threadCpuNs() - cpuStart;
+    const int64_t wallNs = monotonicNs() - start;
+    sender.join();
+    if (useRing) syscalls += ring.enters();
+    ring.close();
+    close(epollFd);
+    close(rx);
+    close(tx);
+
+    std::cout << "{\"stage\":\"receive\",\"path\":\"" << (useRing ? "io_uring" : "recvmmsg") << "\",\"transport\":\""
+              << (canInterface ? canInterface : "udp") << "\",\"frames\":" << received << ",\"lost\":"
+              << frames - received << ",\"syscalls\":" << syscalls << ",\"syscalls_per_1k_frames\":"
+              << (received ? syscalls * 1000.0 / received : 0.0) << ",\"cpu_ns_per_frame\":"
+              << (received ? cpuNs / static_cast<double>(received) : 0.0) << ",\"wall_ms\":" << wallNs / 1000000
+              << "}" << std::endl;
+    return received > 0;
+}
+
+static bool runStorage(const char* name, const std::string& path, uint64_t samples) {
+    unlink(path.c_str());
+    unlink((path + "-wal").c_str());
+    unlink((path + "-shm").c_str());
+    CanStorage storage;
+    if (!storage.open(path.c_str())) return false;
+    const uint64_t writes = loggerVfsStats.writes, extents = loggerVfsStats.extents, enters = loggerVfsStats.enters;
+    CanColumns cols;
+    uint64_t n = 0;
+    const uint64_t ioStart = ioSyscalls();
+    const int64_t cpuStart = threadCpuNs();
+    const int64_t start = monotonicNs();
+    while (n < samples) {
+        cols.clear();
+        for (size_t i = 0; i < CanColumns::CAPACITY; i++, n++) {
+            cols.ids[i] = static_cast<uint32_t>(0x100 + n % 6);
+            cols.values[i] = static_cast<int32_t>(1000 + (n / 6) % 500);
+            cols.timestamps[i] = static_cast<int64_t>(n * 125);
+            cols.count++;
+        }
+        storage.insert(cols);
+    }
+    const int64_t wallNs = monotonicNs() - start;
+    const int64_t cpuNs = threadCpuNs() - cpuStart;
+    const uint64_t io = ioSyscalls() - ioStart;
+    const uint64_t ringEnters = loggerVfsStats.enters - enters;
+    const uint64_t stored = storage.backlog();
+    storage.close();
+
+    std::cout << "{\"stage\":\"storage\",\"path\":\"" << name << "\",\"samples\":" << stored
+              << ",\"rw_syscalls\":" << io << ",\"uring_enters\":" << ringEnters << ",\"syscalls_per_1k_samples\":"
+              << (io + ringEnters) * 1000.0 / stored << ",\"vfs_writes\":" << loggerVfsStats.writes - writes
+              << ",\"vfs_extents\":" << loggerVfsStats.extents - extents << ",\"cpu_ns_per_sample\":"
+              << cpuNs / static_cast<double>(stored) << ",\"inserts_per_s\":"
+              << static_cast<uint64_t>(stored * 1e9 / wallNs) << "}" << std::endl;
+    return stored == n;
+}
+
+static void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--frames n] [--samples n] [--can ifname] [--db file]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t frames = 200000;
+    uint64_t samples = 200000;
+    const char* canInterface = nullptr;
+    std::string db = "/tmp/uring_bench.db";
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) frames = std::strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--samples") && i + 1 < argc) samples = std::strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--can") && i + 1 < argc) canInterface = argv[++i];
+        else if (!strcmp(argv[i], "--db") && i + 1 < argc) db = argv[++i];
+        else { usage(argv[0]); return 1; }
+    }
+
+    bool ok = runReceive(canInterface, false, frames);
+    ok = runReceive(canInterface, true, frames) && ok;
+
+    SqliteMemPool::install();
+    ok = runStorage("default_vfs", db, samples) && ok;
+    ok = LoggerVfs::install({false, 0, false}) && runStorage("logger_vfs_pwrite", db, samples) && ok;
+    ok = LoggerVfs::install({true, 0, false}) && runStorage("logger_vfs_io_uring", db, samples) && ok;
+    unlink(db.c_str());
+    unlink((db + "-wal").c_str());
+    unlink((db + "-shm").c_str());
+    return ok ? 0 : 1;
+}
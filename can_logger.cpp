@@ -8,19 +8,101 @@
 
 #include <iostream>
 #include <cstring>
+#include <cerrno>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unistd.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
 #include <net/if.h>
-#include <sqlite3.h>
 #include <ctime>
-#include <vector>
-#include <cassert>
 #include "DDS/FastDDSPublisher.hpp"
+#include "DDS/FastDDSSubscriber.hpp"
+#include "Metrics.hpp"
+#include "CanBatch.hpp"
+#include "CanDecode.hpp"
+#include "CanStorage.hpp"
+#include "SqliteMemPool.hpp"
+#include "Config.hpp"
+#include "Timestamp.hpp"
+#include "Alarms.hpp"
+#include "LastValueCache.hpp"
+#include "AsyncIo.hpp"
+#include "IoUring.hpp"
+#include "SqliteVfs.hpp"
+#include "UploadPipeline.hpp"
+#include "Backpressure.hpp"
+#include "Realtime.hpp"
+#include "BusHealth.hpp"
+#include "Supervisor.hpp"
+#include "QueryServer.hpp"
+#include "ShardMerge.hpp"
+#include "Trace.hpp"
+#include "SignalInterest.hpp"
 
-constexpr int MIN_ENTRIES_TO_SEND = 100;
+constexpr size_t FRAME_BATCH = 64;   // max frames per recvmmsg()
+constexpr size_t DATA_BATCH = 256;   // rows per decode/upload batch
+constexpr size_t ANCHOR_BATCH = 16;  // clock anchors per upload chunk
+constexpr size_t ROLLUP_BATCH = 64;  // rollup rows per upload chunk
+static_assert(FRAME_BATCH <= CanColumns::CAPACITY, "a frame batch must fit the decode columns");
+constexpr const char* DEFAULT_CONFIG = "can_logger.conf";
+constexpr const char* SUPERVISED_DATABASE = "/dev/shm/can_logger.db";   // buffer that outlives a worker
+constexpr int64_t WATERMARK_SLACK_US = 1000;  // hardware stamps may be older than the frame's arrival in the queue
+constexpr int64_t RECEIVE_WAIT_NS = 100000000;  // longest wait for frames, so a quiet bus still moves the watermark
+constexpr int64_t HEARTBEAT_NS = 100000000;     // supervisor heartbeat and gauge period
+constexpr int64_t INTEREST_REFRESH_NS = 1000000000;  // rereads readers' filters and partitions, they change while matched
+
+MetricCounter framesRead{"canlogger_frames_read_total", "CAN frames read from socket"};
+MetricCounter readErrors{"canlogger_read_errors_total", "Failed CAN socket reads"};
+MetricCounter rxQueueDrops{"canlogger_rx_queue_drops_total", "Frames dropped by the kernel, CAN socket receive queue full"};
+MetricCounter rxUnstamped{"canlogger_rx_unstamped_total", "Frames without kernel receive timestamp"};
+MetricCounter canReconnects{"canlogger_can_reconnects_total", "CAN socket reopened after a read failure or bus-off"};
+MetricCounter canErrorFrames{"canlogger_can_error_frames_total", "CAN error frames received"};
+MetricCounter busOffs{"canlogger_bus_off_total", "CAN controller bus-off events"};
+MetricGauge busState{"canlogger_bus_state", "CAN controller state: 0 error active, 1 warning, 2 passive, 3 bus off"};
+MetricGauge busLoad{"canlogger_bus_load_permille", "CAN bus load over the last health period, 1/1000"};
+MetricGauge busTxErrors{"canlogger_bus_tx_errors", "CAN controller transmit error counter"};
+MetricGauge busRxErrors{"canlogger_bus_rx_errors", "CAN controller receive error counter"};
+MetricCounter clockSteps{"canlogger_clock_steps_total", "Wall clock steps detected"};
+MetricCounter decodeErrors{"canlogger_decode_errors_total", "CAN frames rejected by decoder: DLC 0, remote, short or unknown id with 4+ bytes"};
+MetricCounter outOfRange{"canlogger_out_of_range_total", "Values outside their signal's configured range"};
+MetricCounter alarmsRaised{"canlogger_alarms_raised_total", "Alarm rules raised"};
+MetricCounter alarmsCleared{"canlogger_alarms_cleared_total", "Alarm rules cleared"};
+MetricHistogram alarmLatency{"canlogger_alarm_latency_ns", "Frame receive to alarm publish, ns"};
+MetricCounter insertErrors{"canlogger_sqlite_insert_errors_total", "Failed SQLite inserts"};
+MetricHistogram insertLatency{"canlogger_sqlite_insert_ns", "SQLite insert latency, ns"};
+MetricGauge backlogDepth{"canlogger_backlog_rows", "Rows buffered in SQLite awaiting upload"};
+MetricGauge rollupDepth{"canlogger_rollup_rows", "Rollup rows buffered in SQLite awaiting upload"};
+MetricCounter rawEvicted{"canlogger_raw_rows_evicted_total", "Raw rows dropped by retention"};
+MetricCounter rollupsEvicted{"canlogger_rollup_rows_evicted_total", "Rollup rows dropped by retention"};
+MetricCounter rollupLate{"canlogger_rollup_late_samples_total", "Samples older than their id's open rollup bucket"};
+MetricGauge degradeLevel{"canlogger_degrade_level", "Backpressure level: 0 normal, 1 downsample, 2 aggregate, 3 shed"};
+MetricGauge sqliteMemory{"canlogger_sqlite_memory_bytes", "SQLite heap in use"};
+MetricCounter vfsLogicalBytes{"canlogger_vfs_logical_bytes_total", "Bytes SQLite wrote through the logger VFS"};
+MetricCounter vfsPhysicalBytes{"canlogger_vfs_physical_bytes_total", "Bytes the logger VFS wrote to its files"};
+MetricCounter vfsEraseBlocks{"canlogger_vfs_erase_blocks_total", "Erase blocks written into by database flushes"};
+MetricGauge vfsAmplification{"canlogger_vfs_write_amplification_permille", "Physical over logical VFS bytes, 1/1000"};
+MetricCounter rowsRollupOnly{"canlogger_rows_rollup_only_total", "Rows kept only in rollups by backpressure"};
+MetricCounter rowsShed{"canlogger_rows_shed_total", "Rows dropped by backpressure"};
+MetricCounter uploadsDone{"canlogger_uploads_total", "Completed uploads"};
+MetricCounter uploadFailures{"canlogger_upload_failures_total", "Uploads that failed"};
+MetricHistogram uploadDuration{"canlogger_upload_ns", "Upload duration (select + publish), ns"};
+MetricHistogram uploadFetchDuration{"canlogger_upload_fetch_ns", "Upload reader stage, SQLite select per chunk, ns"};
+MetricHistogram uploadEncodeDuration{"canlogger_upload_encode_ns", "Upload encoder stage per chunk, ns"};
+MetricHistogram uploadPublishDuration{"canlogger_upload_publish_ns", "Upload writer stage, DDS write + delete per chunk, ns"};
+MetricCounter queriesServed{"canlogger_queries_total", "Buffer queries answered"};
+MetricCounter queriesRejected{"canlogger_queries_rejected_total", "Buffer queries rejected, invalid or queue full"};
+MetricHistogram queryDuration{"canlogger_query_ns", "Buffer query, request to last reply, ns"};
+MetricCounter ddsWritten{"canlogger_dds_samples_written_total", "Samples written to DDS"};
+MetricCounter ddsWriteFailures{"canlogger_dds_write_failures_total", "DataWriter::write failures"};
+MetricCounter ddsUnsubscribed{"canlogger_dds_samples_unsubscribed_total", "Samples deleted unsent, no matched reader asked for their id within interest_hold_s"};
 
 using namespace eprosima::fastdds::dds;
 
@@ -28,11 +110,76 @@ DomainParticipant* participant = nullptr;
 Publisher* publisher = nullptr;
 Topic* topic = nullptr;
 DataWriter* writer = nullptr;
+Topic* clockTopic = nullptr;
+DataWriter* clockWriter = nullptr;
+Topic* alarmTopic = nullptr;
+DataWriter* alarmWriter = nullptr;
+Topic* rollupTopic = nullptr;
+DataWriter* rollupWriter = nullptr;
+Topic* healthTopic = nullptr;
+DataWriter* healthWriter = nullptr;
+Topic* queryTopic = nullptr;
+Topic* queryReplyTopic = nullptr;
+Subscriber* subscriber = nullptr;
+DataReader* queryReader = nullptr;
+DataWriter* queryReplyWriter = nullptr;
 PubListener listener;
+SignalInterest interest;              // upload encoder only
+uint32_t interestChanges = 0;         // listener.changes it was built for
+int64_t interestNs = 0;               // when it was built
+bool interestReaders = false;         // some reader was matched then
+size_t interestWanted = 0;            // ids they asked for, as last reported
+SubListener<CanQueryRequest> queryListener;
+std::atomic<int64_t> lastUploadNs{0};
+
+// One receive lane: a CAN socket read by an event loop of its own into a
+// buffer of its own, so lanes on different buses or id ranges never wait for
+// each other's inserts. Without shard keys there is one, on interface with
+// the filter key, its loop run by the main thread. The upload merges the
+// buffers (see ShardMerge); the receive loop, the upload reader and writer
+// and the query thread share a buffer, and each storage call is short, so
+// one lock per shard is enough.
+struct Shard {
+    ShardConfig cfg;
+    bool monitor = true;                    // first on its interface: error frames, health, bus-off restart
+    CanStorage storage;
+    std::mutex storageLock;
+    std::atomic<int> socket{-1};            // the reloader only reads it to update the filter
+    int ifindex = 0;
+    std::atomic<int64_t> watermarkUs{0};    // every frame stamped before this is stored
+    std::atomic<int64_t> heartbeatNs{0};    // last receive loop iteration
+    std::atomic<size_t> backlog{0};         // samples awaiting upload
+    std::atomic<size_t> buffered{0};        // samples and rollup rows
+    std::atomic<int> level{0};              // backpressure level
+    IoLoop loop;                            // receive task and the shard's timers
+    RingReceiver rx;                        // io_uring receive on socket, loop thread only
+    std::thread thread;
+    BusMonitor bus;                         // loop thread only, like linkBitrate
+    uint32_t linkBitrate = 0;
+};
+
+struct ShardSet {
+    std::array<Shard, MAX_SHARDS> lanes;
+    size_t count = 0;
+
+    Shard* begin() { return lanes.data(); }
+    Shard* end() { return lanes.data() + count; }
+    Shard& primary() { return lanes[0]; }
+};
 
-bool initDDS()
+// Receive threads share the alarm state; each takes the lock only for
+// batches with an id some rule watches (AlarmWatch)
+std::mutex alarmLock;
+AlarmEngine alarms;
+const LoggerConfig* alarmsApplied = nullptr;
+
+using EncodedChunk = std::array<CanLogEntry, DATA_BATCH>;
+using UploadChunkT = UploadChunk<EncodedChunk, ShardCursor>;
+using Upload = UploadPipeline<EncodedChunk, ShardCursor>;
+
+bool initDDS(const LoggerConfig& cfg)
 {
-    participant = DomainParticipantFactory::get_instance()->create_participant(0, PARTICIPANT_QOS_DEFAULT);
+    participant = DomainParticipantFactory::get_instance()->create_participant(cfg.ddsDomain, PARTICIPANT_QOS_DEFAULT);
     if (participant == nullptr) {
         std::cerr << "Error creating participant." << std::endl;
         return false;
@@ -41,13 +188,68 @@ bool initDDS()
     TypeSupport myType = TypeSupport(new CanLogEntryPubSubType());
     myType.register_type(participant);
 
-    topic = participant->create_topic("CanLoggerTopic", myType.get_type_name(), TOPIC_QOS_DEFAULT);
+    topic = participant->create_topic(cfg.topicName, myType.get_type_name(), TOPIC_QOS_DEFAULT);
     if (topic == nullptr) {
         std::cerr << "Error creating topic." << std::endl;
         return false;
     }
 
-    publisher = participant->create_publisher(PUBLISHER_QOS_DEFAULT, nullptr, StatusMask::none());
+    TypeSupport anchorType = TypeSupport(new CanClockAnchorPubSubType());
+    anchorType.register_type(participant);
+
+    clockTopic = participant->create_topic(cfg.clockTopicName, anchorType.get_type_name(), TOPIC_QOS_DEFAULT);
+    if (clockTopic == nullptr) {
+        std::cerr << "Error creating clock topic." << std::endl;
+        return false;
+    }
+
+    TypeSupport alarmType = TypeSupport(new CanAlarmPubSubType());
+    alarmType.register_type(participant);
+
+    alarmTopic = participant->create_topic(cfg.alarmTopicName, alarmType.get_type_name(), TOPIC_QOS_DEFAULT);
+    if (alarmTopic == nullptr) {
+        std::cerr << "Error creating alarm topic." << std::endl;
+        return false;
+    }
+
+    TypeSupport rollupType = TypeSupport(new CanRollupPubSubType());
+    rollupType.register_type(participant);
+
+    rollupTopic = participant->create_topic(cfg.rollupTopicName, rollupType.get_type_name(), TOPIC_QOS_DEFAULT);
+    if (rollupTopic == nullptr) {
+        std::cerr << "Error creating rollup topic." << std::endl;
+        return false;
+    }
+
+    TypeSupport healthType = TypeSupport(new CanBusHealthPubSubType());
+    healthType.register_type(participant);
+
+    healthTopic = participant->create_topic(cfg.healthTopicName, healthType.get_type_name(), TOPIC_QOS_DEFAULT);
+    if (healthTopic == nullptr) {
+        std::cerr << "Error creating health topic." << std::endl;
+        return false;
+    }
+
+    TypeSupport queryType = TypeSupport(new CanQueryRequestPubSubType());
+    queryType.register_type(participant);
+    TypeSupport queryReplyType = TypeSupport(new CanQueryReplyPubSubType());
+    queryReplyType.register_type(participant);
+
+    queryTopic = participant->create_topic(cfg.queryTopicName, queryType.get_type_name(), TOPIC_QOS_DEFAULT);
+    queryReplyTopic = participant->create_topic(cfg.queryReplyTopicName, queryReplyType.get_type_name(), TOPIC_QOS_DEFAULT);
+    if (queryTopic == nullptr || queryReplyTopic == nullptr) {
+        std::cerr << "Error creating query topics." << std::endl;
+        return false;
+    }
+
+    // In the default partition and in every signal partition, so readers
+    // either get everything or say which ids they want (see SignalInterest)
+    PublisherQos pqos = PUBLISHER_QOS_DEFAULT;
+    if (!cfg.signalPartitionPrefix.empty()) {
+        pqos.partition().push_back("");
+        pqos.partition().push_back((cfg.signalPartitionPrefix + "*").c_str());
+    }
+    publisher = participant->create_publisher(pqos, nullptr, StatusMask::none());
     if (publisher == nullptr) {
         std::cerr << "Error creating publisher." << std::endl;
         return false;
@@ -57,13 +259,76 @@ bool initDDS()
     publisher->get_default_datawriter_qos(wqos);
     wqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
     wqos.history().kind = KEEP_ALL_HISTORY_QOS;
-    wqos.resource_limits().max_samples = 1000;  // Adjust based on expected load
-    wqos.resource_limits().allocated_samples = 200;
+    wqos.resource_limits().max_samples = cfg.maxSamples;  // Adjust based on expected load
+    wqos.resource_limits().allocated_samples = cfg.allocatedSamples;
+    // data samples are keyed by can_id: one instance per id, any number of them
+    wqos.resource_limits().max_instances = 0;
+    wqos.resource_limits().max_samples_per_instance = cfg.maxSamples;
     writer = publisher->create_datawriter(topic, wqos, &listener, StatusMask::all());
     if (writer == nullptr) {
         std::cerr << "Error creating writer." << std::endl;
         return false;
     }
+    clockWriter = publisher->create_datawriter(clockTopic, wqos, nullptr, StatusMask::none());
+    if (clockWriter == nullptr) {
+        std::cerr << "Error creating clock writer." << std::endl;
+        return false;
+    }
+    rollupWriter = publisher->create_datawriter(rollupTopic, wqos, nullptr, StatusMask::none());
+    if (rollupWriter == nullptr) {
+        std::cerr << "Error creating rollup writer." << std::endl;
+        return false;
+    }
+
+    // Alarms skip the SQLite buffer; late joiners get the recent ones
+    DataWriterQos aqos;
+    publisher->get_default_datawriter_qos(aqos);
+    aqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    aqos.durability().kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+    aqos.history().kind = KEEP_LAST_HISTORY_QOS;
+    aqos.history().depth = 100;
+    alarmWriter = publisher->create_datawriter(alarmTopic, aqos, nullptr, StatusMask::none());
+    if (alarmWriter == nullptr) {
+        std::cerr << "Error creating alarm writer." << std::endl;
+        return false;
+    }
+
+    // Only the latest health records matter (one per bus), late joiners get them at once
+    DataWriterQos hqos;
+    publisher->get_default_datawriter_qos(hqos);
+    hqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    hqos.durability().kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+    hqos.history().kind = KEEP_LAST_HISTORY_QOS;
+    hqos.history().depth = MAX_SHARDS;
+    healthWriter = publisher->create_datawriter(healthTopic, hqos, nullptr, StatusMask::none());
+    if (healthWriter == nullptr) {
+        std::cerr << "Error creating health writer." << std::endl;
+        return false;
+    }
+
+    // Reliable like the data, a query answer with holes would be wrong
+    queryReplyWriter = publisher->create_datawriter(queryReplyTopic, wqos, nullptr, StatusMask::none());
+    if (queryReplyWriter == nullptr) {
+        std::cerr << "Error creating query reply writer." << std::endl;
+        return false;
+    }
+
+    // Created last: requests are answered with the writer above
+    subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT, nullptr, StatusMask::none());
+    if (subscriber == nullptr) {
+        std::cerr << "Error creating subscriber." << std::endl;
+        return false;
+    }
+    DataReaderQos rqos;
+    subscriber->get_default_datareader_qos(rqos);
+    rqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    rqos.history().kind = KEEP_LAST_HISTORY_QOS;
+    rqos.history().depth = QueryServer::QUEUE;
+    queryReader = subscriber->create_datareader(queryTopic, rqos, &queryListener, StatusMask::all());
+    if (queryReader == nullptr) {
+        std::cerr << "Error creating query reader." << std::endl;
+        return false;
+    }
     return true;
 }
 
@@ -72,224 +337,1027 @@ void deleteDDS() {
     DomainParticipantFactory::get_instance()->delete_participant(participant);
 }
 
-struct CanData {
-    int can_id;
-    int value;
-    int64_t timestamp;
-};
+// What one matched reader of the data topic wants: the ids of its content
+// filter and of its partitions, everything if it has neither.
+SignalInterest::Reader readerInterest(const SubscriptionBuiltinTopicData& data, const LoggerConfig& cfg) {
+    SignalInterest::Reader reader;
+    std::vector<uint32_t> ids;
+    const auto& filter = data.content_filter;
+    if (!filter.filter_expression.empty() && filter.filter_class_name.to_string() == "DDSSQL") {
+        std::vector<std::string> params;
+        for (const auto& param : filter.expression_parameters) params.push_back(param.to_string());
+        if (filterIds(filter.filter_expression, params, ids)) reader.narrow(ids);
+    }
+    ids.clear();
+    if (partitionIds(data.partition.names(), cfg.signalPartitionPrefix, ids)) reader.narrow(ids);
+    return reader;
+}
 
-bool topicSend(const std::vector<CanData>& messages) {
-    for (const auto& msg : messages) {
-        std::cout << "Sending data: can_id=" << msg.can_id 
-                  << ", value=" << msg.value 
-                  << ", timestamp=" << msg.timestamp << std::endl;
-        CanLogEntry ddsmsg;
+// Rebuilds which ids the data topic's readers want. Called by the encoder
+// after the writer's matches changed and every INTEREST_REFRESH_NS, since a
+// matched reader can change its filter parameters or partitions without a
+// match event; not from the listener: discovery is busy in there. Reports
+// what the readers want when it changed.
+void refreshInterest(const LoggerConfig& cfg) {
+    std::vector<InstanceHandle_t> handles;
+    std::vector<SignalInterest::Reader> readers;
+    if (writer->get_matched_subscriptions(handles) != RETCODE_OK) {
+        handles.clear();
+        readers.emplace_back();    // can't tell who is there, send everything
+    }
+    for (const InstanceHandle_t& handle : handles) {
+        SubscriptionBuiltinTopicData data;
+        readers.push_back(writer->get_matched_subscription_data(data, handle) == RETCODE_OK ? readerInterest(data, cfg)
+                                                                                            : SignalInterest::Reader{});
+    }
+    const size_t wanted = interest.set(readers, monotonicNs(), static_cast<int64_t>(cfg.interestHoldS) * 1000000000);
+    const bool matched = !readers.empty();
+    if (matched == interestReaders && wanted == interestWanted) return;
+    interestReaders = matched;
+    interestWanted = wanted;
+    if (!matched) {
+        std::cout << "No DDS reader matched, keeping the backlog buffered" << std::endl;
+    } else if (wanted == LimitTable::SLOTS) {
+        std::cout << "DDS readers want every signal" << std::endl;
+    } else {
+        std::cout << "DDS readers want " << wanted << " signal" << (wanted == 1 ? "" : "s") << std::endl;
+    }
+}
+
+// Upload encoder stage: the rows some matched reader wants to DDS samples,
+// the others are skipped and deleted with the chunk. With no reader matched
+// the chunk is held, which ends the drain and keeps its rows.
+void encodeChunk(UploadChunkT& chunk, const LoggerConfig& cfg) {
+    TRACE_SPAN("upload_encode", static_cast<int64_t>(chunk.rows.size()));
+    const int64_t start = monotonicNs();
+    const uint32_t changes = listener.changes.load(std::memory_order_acquire);
+    if (changes != interestChanges || start - interestNs >= INTEREST_REFRESH_NS) {
+        interestChanges = changes;
+        interestNs = start;
+        refreshInterest(cfg);
+    }
+    chunk.count = 0;
+    chunk.held = !interestReaders;
+    if (chunk.held) return;
+    for (size_t i = 0; i < chunk.rows.size(); i++) {
+        const CanData& msg = chunk.rows[i];
+        if (!interest.wants(static_cast<uint32_t>(msg.can_id))) continue;
+        if (cfg.printFrames) {
+            std::cout << "Sending data: can_id=" << msg.can_id
+                      << ", value=" << msg.value
+                      << ", timestamp=" << msg.timestamp << '\n';
+        }
+        CanLogEntry& ddsmsg = chunk.encoded[chunk.count++];
+        ddsmsg.index(static_cast<uint32_t>(msg.seq));
         ddsmsg.can_id(msg.can_id);
         ddsmsg.value(msg.value);
         ddsmsg.timestamp(msg.timestamp);
-        writer->write(&ddsmsg);
     }
-    return true;
+    ddsUnsubscribed.inc(chunk.rows.size() - chunk.count);
+    uploadEncodeDuration.observeSince(start);
 }
 
-static int fetchCallback(void* data, int argc, char** argv, char**) {
-    assert(argc==4);
-    std::vector<CanData>* messages = static_cast<std::vector<CanData>*>(data);
-
-    CanData msg;
-    msg.can_id = std::stoi(argv[1]);
-    msg.value = std::stoi(argv[2]);
-    msg.timestamp = std::stoll(argv[3]);
-
-    messages->push_back(msg);
-    return 0;
+// Upload writer stage. Stops at the first failure, the chunk stays buffered.
+bool topicSend(const UploadChunkT& chunk) {
+    TRACE_SPAN("upload_publish", static_cast<int64_t>(chunk.count));
+    const int64_t start = monotonicNs();
+    for (size_t i = 0; i < chunk.count; i++) {
+        bool written;
+        {
+            TRACE_SPAN("dds_write");
+            written = writer->write(&chunk.encoded[i]) == RETCODE_OK;
+        }
+        if (!written) {
+            ddsWriteFailures.inc();
+            std::cerr << "DDS write failed, keeping buffered entries" << std::endl;
+            return false;
+        }
+        ddsWritten.inc();
+    }
+    uploadPublishDuration.observeSince(start);
+    return true;
 }
 
-bool wlanAvailable() {
-    return true;
+void publishAlarm(const AlarmEvent& event) {
+    CanAlarm ddsmsg;
+    ddsmsg.name(*event.name);
+    ddsmsg.active(event.active);
+    ddsmsg.can_id(event.can_id);
+    ddsmsg.value(event.value);
+    ddsmsg.timestamp(event.timestamp);
+    if (alarmWriter->write(&ddsmsg) == RETCODE_OK) {
+        ddsWritten.inc();
+    } else {
+        ddsWriteFailures.inc();
+        std::cerr << "DDS write failed for alarm " << *event.name << std::endl;
+    }
+    alarmLatency.observe(monotonicNs() - event.timestamp * 1000);
+    event.active ? alarmsRaised.inc() : alarmsCleared.inc();
+    std::cerr << "Alarm " << *event.name << (event.active ? " raised" : " cleared")
+              << ": can_id=0x" << std::hex << event.can_id << std::dec << ", value=" << event.value << std::endl;
 }
 
-bool uploadData(sqlite3* db) {
-    if (listener.matched == 0) return false;
+// Periodic bus health record, mirrored into the metrics for the primary
+// shard's bus. Load covers the time since the previous record.
+void publishHealth(BusMonitor& bus, uint32_t bitrate, int64_t nowNs, const std::string& interface, bool gauges) {
+    const uint32_t load = bus.takeLoadPermille(nowNs, bitrate);
+    if (gauges) {
+        busState.set(static_cast<int64_t>(bus.state));
+        busLoad.set(load);
+        busTxErrors.set(bus.txErrors);
+        busRxErrors.set(bus.rxErrors);
+    }
 
-    std::vector<CanData> messages;
-    char* errorMessage = nullptr;
-    int rc = sqlite3_exec(db, "SELECT * FROM can_data", fetchCallback, &messages, &errorMessage);
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << errorMessage << std::endl;
-        sqlite3_free(errorMessage);
-        return false;
+    CanBusHealth ddsmsg;
+    ddsmsg.timestamp(nowNs / 1000);
+    ddsmsg.state(static_cast<uint8_t>(bus.state));
+    ddsmsg.tx_errors(bus.txErrors);
+    ddsmsg.rx_errors(bus.rxErrors);
+    ddsmsg.load_permille(static_cast<uint16_t>(load));
+    ddsmsg.frames(bus.frameCount);
+    ddsmsg.error_frames(bus.errorFrameCount);
+    ddsmsg.bus_off_count(bus.busOffCount);
+    ddsmsg.reconnects(static_cast<uint32_t>(canReconnects.value()));
+    ddsmsg.bus(interface);
+    if (healthWriter->write(&ddsmsg) == RETCODE_OK) {
+        ddsWritten.inc();
+    } else {
+        ddsWriteFailures.inc();
     }
-    return topicSend(messages);
 }
 
-void printData(CanData entry) {
-    std::string name;
-    std::string unit;
-    switch (entry.can_id) {
-        case 0x100: {
-            name = "Engine RPM: ";
-            unit = "RPM";
-            break;
-        }
-        case 0x101: {
-            name = "Coolant Temperature: ";
-            unit = "°C";
-            break;
+// DDS request to a QueryServer request. Wall-clock requests are converted
+// with the clock offset of now, so a wall clock step since the samples were
+// taken shifts them by the step, as for the clock anchors.
+QueryRequest queryRequest(const CanQueryRequest& sample) {
+    int64_t offset = 0;
+    if (sample.wall_clock()) {
+        const ClockAnchor now = RxClock::anchor();
+        offset = now.realtimeUs - now.monotonicUs;
+    }
+    return {sample.request_id(), sample.can_id(), sample.from_us() - offset, sample.to_us() - offset,
+            sample.bucket_us(), sample.max_results(), offset, monotonicNs()};
+}
+
+// QueryServer reply: one CanQueryReply per result, the last one flagged; a
+// final call without results sends a flagged empty reply.
+bool publishQueryReply(const QueryRequest& request, const QueryResult* results, size_t count, uint32_t first, bool last,
+                       QueryStatus status) {
+    CanQueryReply ddsmsg;
+    ddsmsg.request_id(request.id);
+    ddsmsg.status(static_cast<uint8_t>(status));
+    ddsmsg.can_id(request.can_id);
+    for (size_t i = 0; i < count || (i == 0 && last); i++) {
+        ddsmsg.seq(first + static_cast<uint32_t>(i));
+        ddsmsg.last(last && i + 1 >= count);
+        if (i < count) {
+            ddsmsg.timestamp(results[i].timestamp);
+            ddsmsg.min(results[i].min);
+            ddsmsg.max(results[i].max);
+            ddsmsg.mean(results[i].mean);
+            ddsmsg.count(results[i].count);
+        } else {
+            ddsmsg.count(0);
         }
-        case 0x102: {
-            name = "Engine Oil Temperature: ";
-            unit = "°C";
-            break;
+        if (queryReplyWriter->write(&ddsmsg) != RETCODE_OK) {
+            ddsWriteFailures.inc();
+            std::cerr << "DDS write failed, abandoning query " << request.id << std::endl;
+            return false;
         }
-        case 0x103: {
-            name = "Engine Oil Pressure: ";
-            unit = "kPa";
-            break;
+        ddsWritten.inc();
+    }
+    if (last) {
+        if (status == QueryStatus::Rejected) {
+            queriesRejected.inc();
+        } else {
+            queriesServed.inc();
+            queryDuration.observeSince(request.receivedNs);
         }
-        case 0x104: {
-            name = "Hydraulic Oil Temperature: ";
-            unit = "°C";
-            break;
+    }
+    return true;
+}
+
+// Sends buffered clock anchors ahead of the rows they date. They are kept
+// in the primary shard's buffer.
+bool uploadAnchors(Shard& shard) {
+    CanStorage& storage = shard.storage;
+    ClockAnchor anchors[ANCHOR_BATCH];
+    CanClockAnchor ddsmsg;
+    while (true) {
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> guard(shard.storageLock);
+            if (storage.anchorBacklog() > 0) count = storage.fetchAnchors(anchors, ANCHOR_BATCH);
         }
-        case 0x105: {
-            name = "Hydraulic Oil Pressure: ";
-            unit = "bar";
-            break;
+        if (count == 0) break;
+        for (size_t i = 0; i < count; i++) {
+            ddsmsg.monotonic_us(anchors[i].monotonicUs);
+            ddsmsg.realtime_us(anchors[i].realtimeUs);
+            if (clockWriter->write(&ddsmsg) != RETCODE_OK) {
+                ddsWriteFailures.inc();
+                std::cerr << "DDS write failed, keeping buffered clock anchors" << std::endl;
+                return false;
+            }
+            ddsWritten.inc();
         }
-        case 0x200: {
-            name = "Scoop Bucket Load Weight: ";
-            unit = "kg";
-            break;
+        std::lock_guard<std::mutex> guard(shard.storageLock);
+        if (!storage.removeAnchors(anchors[count - 1].monotonicUs)) return false;
+    }
+    return true;
+}
+
+// Sends one rollup level of one shard, oldest buckets first.
+bool uploadRollups(Shard& shard, int level) {
+    CanStorage& storage = shard.storage;
+    RollupRow rows[ROLLUP_BATCH];
+    CanRollup ddsmsg;
+    ddsmsg.resolution_s(static_cast<uint32_t>(ROLLUP_WIDTH_US[level] / 1000000));
+    while (true) {
+        int64_t lastId = 0;
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> guard(shard.storageLock);
+            if (storage.rollupBacklog(level) > 0) count = storage.fetchRollups(level, rows, ROLLUP_BATCH, lastId);
         }
-        default: {
-            name = "Unknown value: ";
-            break;
+        if (count == 0) break;
+        for (size_t i = 0; i < count; i++) {
+            ddsmsg.can_id(rows[i].can_id);
+            ddsmsg.bucket_start(rows[i].bucket);
+            ddsmsg.min(rows[i].min);
+            ddsmsg.max(rows[i].max);
+            ddsmsg.mean(static_cast<double>(rows[i].sum) / rows[i].count);
+            ddsmsg.count(rows[i].count);
+            if (rollupWriter->write(&ddsmsg) != RETCODE_OK) {
+                ddsWriteFailures.inc();
+                std::cerr << "DDS write failed, keeping buffered rollups" << std::endl;
+                return false;
+            }
+            ddsWritten.inc();
         }
+        std::lock_guard<std::mutex> guard(shard.storageLock);
+        if (!storage.removeRollups(level, lastId)) return false;
     }
-    std::cout << entry.timestamp << ": "<< name << entry.value << unit << std::endl;
-};
+    return true;
+}
 
-void insertData(sqlite3* db, int can_id, int value) {
-    struct timespec ts;
-    clock_gettime(CLOCK_REALTIME, &ts);
-    const int64_t timestamp_ms = ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
-    printData({can_id, value, timestamp_ms});
-
-    const char * sql = "INSERT INTO can_data (can_id, value, timestamp) VALUES (?, ?, ?);";
-    char* errMsg = nullptr;
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << sqlite3_errmsg(db) << std::endl;
-        sqlite3_close(db);
-        exit(1);
-    }
-    sqlite3_bind_int(stmt, 1, can_id);
-    sqlite3_bind_int(stmt, 2, value);
-    sqlite3_bind_int64(stmt, 3, timestamp_ms);
-
-    rc = sqlite3_step(stmt);
-    if (rc != SQLITE_DONE) {
-        std::cerr << "SQL error: " << sqlite3_errmsg(db) << std::endl;
-        sqlite3_free(errMsg);
-    } else {
-        sqlite3_finalize(stmt);
+bool wlanAvailable() {
+    return true;
+}
+
+// Buffer gauges, summed over the shards.
+void updateDepthGauges(ShardSet& shards) {
+    size_t backlog = 0, buffered = 0;
+    for (Shard& shard : shards) {
+        backlog += shard.backlog.load(std::memory_order_relaxed);
+        buffered += shard.buffered.load(std::memory_order_relaxed);
     }
+    backlogDepth.set(backlog);
+    rollupDepth.set(buffered - backlog);
 }
 
-void deleteAllEntries(sqlite3* db) {
-    const char* sql = "DELETE FROM can_data;";
-    char* errMsg = nullptr;
+void refreshDepth(Shard& shard) {
+    std::lock_guard<std::mutex> guard(shard.storageLock);
+    shard.backlog.store(shard.storage.backlog(), std::memory_order_relaxed);
+    shard.buffered.store(shard.storage.totalRows(), std::memory_order_relaxed);
+}
+
+// Upload stages, see UploadPipeline. Coarsest data goes first, so a short
+// link window after a long outage still covers the whole outage: anchors,
+// 1 h, 1 min and 1 s rollups from the reader thread, then raw rows of all
+// shards merged in time order through the pipeline.
+Upload::Stages uploadStages(ShardSet& shards, ShardMerge& merge, const ConfigStore& config) {
+    Upload::Stages stages;
+    stages.begin = [&shards, &merge] {
+        bool sent = uploadAnchors(shards.primary());
+        for (int level = ROLLUP_LEVELS - 1; sent && level >= 0; level--) {
+            for (Shard& shard : shards) sent = sent && uploadRollups(shard, level);
+        }
+        merge.begin();
+        return sent;
+    };
+    stages.fetch = [&merge](UploadChunkT& chunk, const ShardCursor& after) {
+        TRACE_SPAN("upload_fetch");
+        const int64_t start = monotonicNs();
+        const bool ok = merge.fetch(chunk.rows, after, chunk.lastId);
+        uploadFetchDuration.observeSince(start);
+        return ok;
+    };
+    stages.encode = [&config](UploadChunkT& chunk) { encodeChunk(chunk, config.get()); };
+    stages.publish = topicSend;
+    stages.commit = [&shards, &merge](const ShardCursor& last) {
+        const bool ok = merge.commit(last);
+        for (Shard& shard : shards) refreshDepth(shard);
+        updateDepthGauges(shards);
+        return ok;
+    };
+    stages.done = [&shards](bool sent, int64_t start) {
+        for (Shard& shard : shards) refreshDepth(shard);
+        updateDepthGauges(shards);
+        uploadDuration.observeSince(start);
+        sent ? uploadsDone.inc() : uploadFailures.inc();
+        if (sent) std::cout << "Buffered entries deleted." << std::endl;
+    };
+    return stages;
+}
 
-    int rc = sqlite3_exec(db, sql, nullptr, nullptr, &errMsg);
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << errMsg << std::endl;
-        sqlite3_free(errMsg);
+void printData(const CanData& entry, bool outside, const LoggerConfig& cfg) {
+    const SignalInfo* signal = cfg.signal(entry.can_id);
+    if (signal) {
+        std::cout << entry.timestamp << ": " << signal->name << ": " << entry.value << signal->unit;
     } else {
-        std::cout << "Buffered entries deleted." << std::endl;
+        std::cout << entry.timestamp << ": Unknown value: " << entry.value;
+    }
+    std::cout << (outside ? " (out of range)\n" : "\n");
+};
+
+// Loads the signal table's value ranges into the check kernel's id table.
+void loadLimits(LimitTable& limits, const LoggerConfig& cfg) {
+    limits.clear();
+    for (const auto& [can_id, signal] : cfg.signals) {
+        limits.set(can_id, signal.min, signal.max);
     }
 }
 
-int main() {
-    // CAN socket setup
-    int s;
-    struct sockaddr_can addr;
-    struct ifreq ifr;
+void insertData(Shard& shard, const CanColumns& cols, uint64_t outside, const DegradeMasks& keep,
+                const LoggerConfig& cfg) {
+    if (cfg.printFrames) {
+        TRACE_SPAN("print", static_cast<int64_t>(cols.size()));
+        for (size_t i = 0; i < cols.size(); i++) {
+            printData(cols.row(i), outside >> i & 1, cfg);
+        }
+        std::cout.flush();
+    }
+
+    TRACE_SPAN("insert", static_cast<int64_t>(cols.size()));
+    std::lock_guard<std::mutex> guard(shard.storageLock);
+    const int64_t start = monotonicNs();
+    const size_t stored = shard.storage.insert(cols, keep.raw, keep.rollup);
+    insertLatency.observeSince(start);
+    const size_t wanted = __builtin_popcountll(keep.raw);
+    if (stored < wanted) insertErrors.inc(wanted - stored);
+    shard.backlog.store(shard.storage.backlog(), std::memory_order_relaxed);
+    shard.buffered.store(shard.storage.totalRows(), std::memory_order_relaxed);
+}
+
+// Moves a shard's backpressure level with its buffer's row count and the
+// SQLite heap, which all shards share.
+void updateBackpressure(Shard& shard, Backpressure& backpressure, size_t bufferedRows) {
+    const size_t memory = static_cast<size_t>(sqlite3_memory_used());
+    sqliteMemory.set(static_cast<int64_t>(memory));
+    if (backpressure.update(bufferedRows, memory)) {
+        std::cerr << "Backpressure" << (shard.cfg.name.empty() ? "" : " on " + shard.cfg.name) << ": "
+                  << degradeLevelName(backpressure.level()) << " (" << bufferedRows << " rows buffered, SQLite heap "
+                  << memory / (1024 * 1024) << " MB)" << std::endl;
+    }
+    shard.level.store(static_cast<int>(backpressure.level()), std::memory_order_relaxed);
+}
 
-    const char *ifname = "vcan0";
+// Closes idle rollup buckets and applies the buffer limit, once a second.
+// Each of the shards keeps an equal part of max_buffered_rows.
+void maintainStorage(Shard& shard, const LoggerConfig& cfg, int64_t nowUs, size_t shardCount) {
+    TRACE_SPAN("maintenance");
+    std::lock_guard<std::mutex> guard(shard.storageLock);
+    CanStorage& storage = shard.storage;
+    storage.flushRollups(nowUs);
+    rollupLate.inc(storage.takeLateRollupSamples());
+    const size_t raw = storage.backlog();
+    const size_t limit = cfg.maxBufferedRows ? std::max<size_t>(cfg.maxBufferedRows / shardCount, 1) : 0;
+    const size_t evicted = storage.enforceRetention(limit);
+    if (evicted) {
+        const size_t rawDropped = raw - storage.backlog();
+        rawEvicted.inc(rawDropped);
+        rollupsEvicted.inc(evicted - rawDropped);
+    }
+    shard.backlog.store(storage.backlog(), std::memory_order_relaxed);
+    shard.buffered.store(storage.totalRows(), std::memory_order_relaxed);
+}
 
-    sqlite3* db;
-    int rc;
+// A shard's own id list, or the filter key.
+const std::vector<uint32_t>& shardFilter(const Shard& shard, const LoggerConfig& cfg) {
+    return shard.cfg.ids.empty() ? cfg.filter : shard.cfg.ids;
+}
 
-    //Use in-memory database as buffer
-    rc = sqlite3_open(":memory:", &db);
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << sqlite3_errmsg(db) << std::endl;
-        sqlite3_close(db);
-        exit(1);
+// Installs the accepted id list as kernel-side CAN_RAW_FILTER, so rejected
+// frames never reach userspace. Called at startup and on config reload.
+void applyFilter(int s, const std::vector<uint32_t>& ids) {
+    std::vector<struct can_filter> filters;
+    for (uint32_t can_id : ids) {
+        filters.push_back({can_id, CAN_SFF_MASK | CAN_EFF_FLAG | CAN_RTR_FLAG});
+    }
+    if (filters.size() > CAN_RAW_FILTER_MAX) {
+        std::cerr << "Too many CAN ids in filter, accepting all" << std::endl;
+        filters.clear();
     }
-    const char* createTableSQL = "CREATE TABLE can_data ("
-                                 "id INTEGER PRIMARY KEY AUTOINCREMENT,"
-                                 "can_id INT NOT NULL,"
-                                 "value INT NOT NULL,"
-                                 "timestamp INT64 NOT NULL);";
-    rc = sqlite3_exec(db, createTableSQL, nullptr, nullptr, nullptr);
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << sqlite3_errmsg(db) << std::endl;
-        sqlite3_close(db);
-        exit(1);
+    if (filters.empty()) filters.push_back({0, 0});
+    if (setsockopt(s, SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(), filters.size() * sizeof(struct can_filter)) < 0) {
+        perror("CAN_RAW_FILTER");
     }
+}
 
-    if ((s = socket(PF_CAN, SOCK_RAW, CAN_RAW)) < 0) {
+// Opens the shard's CAN socket with filters, timestamps and drop counts
+// enabled, and error frames on the shard monitoring the bus. Returns -1 on
+// failure; ifindex is set once the interface is found.
+int openCanSocket(const Shard& shard, const LoggerConfig& cfg, int& ifindex) {
+    const std::string& interface = shard.cfg.interface;
+    const int s = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (s < 0) {
         perror("Socket");
-        return 1;
+        return -1;
     }
 
-    strcpy(ifr.ifr_name, ifname);
-    ioctl(s, SIOCGIFINDEX, &ifr);
+    struct ifreq ifr{};
+    strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+    if (ioctl(s, SIOCGIFINDEX, &ifr) < 0) {
+        perror(interface.c_str());
+        close(s);
+        return -1;
+    }
+    ifindex = ifr.ifr_ifindex;
 
+    struct sockaddr_can addr{};
     addr.can_family = AF_CAN;
-    addr.can_ifindex = ifr.ifr_ifindex;
-
+    addr.can_ifindex = ifindex;
     if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
         perror("Bind");
-        return 1;
+        close(s);
+        return -1;
     }
-    if (!initDDS()) {
-        std::cerr << "DDS init error" << std::endl;
-        return 1;
+    applyFilter(s, shardFilter(shard, cfg));
+    const can_err_mask_t errors = shard.monitor ? BUS_ERROR_CLASSES : 0;
+    if (setsockopt(s, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &errors, sizeof(errors)) < 0) {
+        perror("CAN_RAW_ERR_FILTER");
+    }
+    if (cfg.rcvbufBytes > 0) {
+        std::cerr << "CAN socket receive buffer " << setReceiveBuffer(s, cfg.rcvbufBytes) << " bytes" << std::endl;
+    }
+    enableRxDropCount(s);
+    if (enableRxTimestamps(s) == RxTimestampMode::None) {
+        std::cerr << "No kernel receive timestamps, using read time" << std::endl;
+    }
+    return s;
+}
+
+constexpr size_t RX_CONTROL = RX_CONTROL_SIZE + RX_DROPS_CONTROL_SIZE;
+
+// Reads every frame already queued on the socket, without waiting for one,
+// with a single recvmmsg() call. Timestamps are the kernel's wall-clock
+// receive times in ns, see stampFrames(). drops receives the socket's
+// running SO_RXQ_OVFL count when the kernel reports it.
+ssize_t readFrames(int s, FrameBatch& frames, uint32_t& drops) {
+    TRACE_SPAN("read");
+    struct mmsghdr msgs[FRAME_BATCH];
+    struct iovec iov[FRAME_BATCH];
+    alignas(struct cmsghdr) char control[FRAME_BATCH][RX_CONTROL];
+    const size_t count = frames.capacity() < FRAME_BATCH ? frames.capacity() : FRAME_BATCH;
+    for (size_t i = 0; i < count; i++) {
+        iov[i] = {&frames[i].frame, sizeof(struct can_frame)};
+        msgs[i] = {};
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = control[i];
+        msgs[i].msg_hdr.msg_controllen = RX_CONTROL;
+    }
+    int n = recvmmsg(s, msgs, count, MSG_DONTWAIT, nullptr);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) n = 0;  // nothing queued
+    frames.resize(n > 0 ? n : 0);
+    for (int i = 0; i < n; i++) {
+        frames[i].timestamp = rxTimestampNs(msgs[i].msg_hdr);
+    }
+    if (n > 0) rxDropCount(msgs[n - 1].msg_hdr, drops);
+    return n;
+}
+
+// readFrames() with io_uring: the frames the kernel already received into
+// the shard's provided buffers, taken off the completion queue without a
+// system call. Returns the messages taken, -1 when the socket failed.
+ssize_t readFramesRing(RingReceiver& rx, FrameBatch& frames, uint32_t& drops) {
+    TRACE_SPAN("read");
+    const size_t count = frames.capacity() < FRAME_BATCH ? frames.capacity() : FRAME_BATCH;
+    size_t n = 0;
+    frames.resize(count);
+    const ssize_t read = rx.receive(count, [&](struct msghdr& control, const char* payload, size_t length) {
+        if (length != sizeof(struct can_frame)) return;
+        CanRxFrame& received = frames[n++];
+        memcpy(&received.frame, payload, sizeof(struct can_frame));
+        received.timestamp = rxTimestampNs(control);
+        rxDropCount(control, drops);
+    });
+    frames.resize(n);
+    return read;
+}
+
+// Moves the batch's kernel stamps to the monotonic µs base. Returns true if
+// the wall clock stepped since the previous batch.
+bool stampFrames(FrameBatch& frames, RxClock& clock) {
+    const bool stepped = clock.sync();
+    for (CanRxFrame& rx : frames) {
+        if (rx.timestamp == 0) rxUnstamped.inc();
+        rx.timestamp = clock.toMonotonicUs(rx.timestamp);
+    }
+    return stepped;
+}
+
+// Anchors are recorded by the primary shard and kept in its buffer.
+void recordAnchor(Shard& primary, LastValueCache& lvc) {
+    const ClockAnchor anchor = RxClock::anchor();
+    {
+        std::lock_guard<std::mutex> guard(primary.storageLock);
+        if (!primary.storage.insertAnchor(anchor)) insertErrors.inc();
     }
+    lvc.setAnchor(anchor);
+}
+
+// Buffer file of a shard: "buffer.db" -> "buffer.<name>.db".
+std::string shardDatabase(const std::string& database, const std::string& name) {
+    if (name.empty() || database == ":memory:") return database;
+    const size_t slash = database.rfind('/');
+    const size_t dot = database.rfind('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return database + "." + name;
+    return database.substr(0, dot) + "." + name + database.substr(dot);
+}
+
+
+// Real-time setup of a receive thread, once every other thread is started:
+// its core, its SCHED_FIFO priority and a prefaulted stack.
+void claimReceiveCore(int cpu, const LoggerConfig& startup, bool memoryLocked) {
+    if (cpu >= 0) pinToCpu(cpu);
+    if (startup.rtPriority > 0) setFifoPriority(startup.rtPriority);
+    if (memoryLocked) prefaultStack();
+}
+
+// Starts an upload once min_entries_to_send samples are buffered over all
+// shards, or once any are when flush is set. Any receive loop; a kick while
+// a drain runs is ignored.
+void triggerUpload(Upload& upload, ShardSet& shards, const LoggerConfig& cfg, bool flush) {
+    size_t backlog = 0;
+    for (Shard& shard : shards) backlog += shard.backlog.load(std::memory_order_relaxed);
+    if ((backlog >= cfg.minEntriesToSend || (flush && backlog > 0)) && listener.matched > 0 && upload.kick()) {
+        lastUploadNs.store(monotonicNs(), std::memory_order_relaxed);
+    }
+}
+
+// Receive task of one shard: read, stamp, decode, alarms, last value cache,
+// range check, backpressure and insert. After a full batch it reads again at
+// once, otherwise it waits for the socket at most RECEIVE_WAIT_NS, so the
+// watermark and the heartbeat move on a quiet bus and a lost socket is
+// retried. The shard's timers are tasks of their own on the same loop.
+// With io_uring the task arms a multishot receive on each socket it reads,
+// so the kernel runs it in this thread's context, and waits for the ring
+// instead of the socket.
+Task<> receiveTask(Shard& shard, bool primary, ConfigStore& config, LastValueCache& lvc, FrameBatch frames,
+                   ShardSet& shards, Upload& upload, int64_t& lastAnchorNs) {
+    IoLoop& loop = shard.loop;
+    BusMonitor& bus = shard.bus;
+    const std::string& interface = shard.cfg.interface;
+    int s = shard.socket.load();
+    shard.linkBitrate = canBitrate(shard.ifindex);
+    CanColumns decoded;
+    LimitTable limits;
+    Backpressure backpressure;
+    AlarmWatch alarmIds;
+    const LoggerConfig* appliedCfg = nullptr;
+    RxClock rxClock;
+    rxClock.sync();
+    uint32_t rxDrops = 0;
+    uint32_t rxDropsSeen = 0;
+    BusState reportedState = BusState::Active;
+    int64_t busOffSince = 0;
+    int64_t busOffRetryMs = 0;
+    int64_t reconnectAt = 0;
+    int64_t reconnectBackoffMs = 0;
+    bool full = false;
+    bool useRing = config.get().ioUring;
+    RingReceiver& ring = shard.rx;
 
-    // CAN frame buffer
-    struct can_frame frame;
-    int packetCount = 0;
     while (true) {
-        // Read a CAN frame from the socket
-        ssize_t nbytes = read(s, &frame, sizeof(struct can_frame));
-        if (nbytes < 0) {
+        if (s >= 0 && useRing && !ring.active() && !ring.open(s, RX_CONTROL, sizeof(struct can_frame))) {
+            perror("io_uring receive, using recvmmsg()");
+            useRing = false;
+        }
+        if (s < 0) {
+            co_await loop.sleepFor(RECEIVE_WAIT_NS);
+        } else if (!full) {
+            co_await loop.readable(ring.active() ? ring.fd() : s, RECEIVE_WAIT_NS);
+        }
+        shard.heartbeatNs.store(monotonicNs(), std::memory_order_relaxed);
+
+        // Read all pending CAN frames from the socket. Without a socket the
+        // task keeps going on empty batches, so the watermark moves and
+        // uploads, maintenance and health records go on while the bus is away.
+        const int64_t readStartUs = monotonicNs() / 1000;
+        ssize_t read = 0;
+        frames.clear();
+        if (s < 0) {
+            if (monotonicNs() < reconnectAt) {
+                // backing off
+            } else if ((s = openCanSocket(shard, config.get(), shard.ifindex)) >= 0) {
+                shard.socket = s;
+                canReconnects.inc();
+                shard.linkBitrate = canBitrate(shard.ifindex);
+                rxDrops = rxDropsSeen = 0;
+                reconnectBackoffMs = 0;
+                // a controller can recover without a restarted error frame
+                // reaching us; start over from the state the driver reports
+                bus.restarted();
+                canLinkState(shard.ifindex, bus.state);
+                if (bus.state == BusState::BusOff) {
+                    busOffSince = monotonicNs();
+                    if (!busOffRetryMs) busOffRetryMs = config.get().busOffRestartMs;
+                } else {
+                    busOffSince = busOffRetryMs = 0;
+                }
+                std::cerr << "CAN socket on " << interface << " reopened" << std::endl;
+            } else {
+                reconnectBackoffMs = reconnectBackoffMs ? std::min<int64_t>(reconnectBackoffMs * 2, 5000) : 100;
+                reconnectAt = monotonicNs() + reconnectBackoffMs * 1000000;
+            }
+        } else if ((read = ring.active() ? readFramesRing(ring, frames, rxDrops) : readFrames(s, frames, rxDrops)) < 0) {
+            readErrors.inc();
             perror("Read");
-            return 1;
+            shard.socket = -1;
+            ring.close();
+            close(s);
+            s = -1;
+            frames.clear();
+        }
+        full = read >= static_cast<ssize_t>(std::min(frames.capacity(), FRAME_BATCH));
+        // error frames are counted and taken out of the batch here
+        const uint32_t errorFrames = bus.errorFrameCount;
+        if (bus.observe(frames)) {
+            busOffs.inc();
+            busOffSince = monotonicNs();
+            busOffRetryMs = config.get().busOffRestartMs;
+        }
+        canErrorFrames.inc(bus.errorFrameCount - errorFrames);
+        framesRead.inc(frames.size());
+        if (rxDrops != rxDropsSeen) {
+            rxQueueDrops.inc(rxDrops - rxDropsSeen);
+            std::cerr << "CAN receive queue overflow on " << interface << ", " << rxDrops - rxDropsSeen
+                      << " frames dropped by the kernel" << std::endl;
+            rxDropsSeen = rxDrops;
+        }
+
+        // one snapshot per batch, a reload takes effect from the next batch
+        const LoggerConfig& cfg = config.get();
+
+        const int64_t now = monotonicNs();
+        const bool stepped = stampFrames(frames, rxClock);
+
+        decoded.clear();
+        size_t rejected;
+        {
+            TRACE_SPAN("decode", static_cast<int64_t>(frames.size()));
+            rejected = decodeColumns(frames, decoded);
+        }
+        // counted, not printed: a noisy bus would have every batch write to stderr
+        if (rejected) decodeErrors.inc(rejected);
+
+        if (appliedCfg != &cfg) {
+            loadLimits(limits, cfg);
+            backpressure.load(cfg);
+            alarmIds.load(cfg);
+            appliedCfg = &cfg;
+        }
+        // alarms go out before the batch is printed or stored, and are never
+        // subject to backpressure; rules may span shards, so they share one engine
+        if (alarmIds.any(decoded)) {
+            TRACE_SPAN("alarms", static_cast<int64_t>(decoded.count));
+            std::lock_guard<std::mutex> guard(alarmLock);
+            if (alarmsApplied != &cfg) {
+                alarms.load(cfg);
+                alarmsApplied = &cfg;
+            }
+            alarms.evaluate(decoded, publishAlarm);
+        }
+        {
+            TRACE_SPAN("lvc", static_cast<int64_t>(decoded.count));
+            lvc.update(decoded);
+        }
+        const uint64_t outside = outsideLimits(decoded, limits);
+        if (outside) outOfRange.inc(__builtin_popcountll(outside));
+
+        const DegradeMasks keep = backpressure.select(decoded);
+        if (keep.rollup != keep.raw) rowsRollupOnly.inc(__builtin_popcountll(keep.rollup & ~keep.raw));
+        const uint64_t all = decoded.count >= 64 ? ~uint64_t{0} : (uint64_t{1} << decoded.count) - 1;
+        if (keep.rollup != all) rowsShed.inc(__builtin_popcountll(all & ~keep.rollup));
+        insertData(shard, decoded, outside, keep, cfg);
+
+        // Everything stamped before the read started is stored now, unless
+        // the batch was full and more is queued behind its last frame.
+        const int64_t stored = !full ? readStartUs - WATERMARK_SLACK_US
+                                     : frames.empty() ? 0 : frames[frames.size() - 1].timestamp;
+        if (stored > shard.watermarkUs.load(std::memory_order_relaxed)) {
+            shard.watermarkUs.store(stored, std::memory_order_release);
+        }
+
+        if (bus.state != reportedState) {
+            std::cerr << "CAN bus " << interface << " " << busStateName(bus.state) << " (tx errors "
+                      << int(bus.txErrors) << ", rx errors " << int(bus.rxErrors) << ")" << std::endl;
+            reportedState = bus.state;
+        }
+        // A controller that stays bus-off is restarted through netlink; if
+        // that is not possible (no CAP_NET_ADMIN, not a real CAN device) the
+        // socket is reopened instead. Retries back off up to 5 s.
+        if (bus.state == BusState::BusOff && busOffRetryMs > 0 && now - busOffSince >= busOffRetryMs * 1000000) {
+            if (canRestart(shard.ifindex)) {
+                std::cerr << "CAN controller " << interface << " restart requested" << std::endl;
+            } else if (s >= 0) {
+                shard.socket = -1;
+                ring.close();
+                close(s);
+                s = -1;
+            }
+            busOffSince = now;
+            busOffRetryMs = std::min<int64_t>(busOffRetryMs * 2, 5000);
+        }
+        updateBackpressure(shard, backpressure, shard.buffered.load(std::memory_order_relaxed));
+
+        if (primary && stepped) {
+            clockSteps.inc();
+            std::cerr << "Wall clock stepped, recording clock anchor" << std::endl;
+            recordAnchor(shard, lvc);
+            lastAnchorNs = now;
+        }
+        triggerUpload(upload, shards, cfg, false);
+    }
+}
+
+// Bus health record every health_interval_ms, on a shard monitoring its
+// bus; the primary's also goes to the bus gauges.
+Task<> healthTask(Shard& shard, bool primary, ConfigStore& config) {
+    while (true) {
+        const int intervalMs = config.get().healthIntervalMs;
+        co_await shard.loop.sleepFor((intervalMs > 0 ? intervalMs : 1000) * 1000000LL);
+        if (intervalMs <= 0) continue;
+        const uint32_t bitrate = shard.linkBitrate ? shard.linkBitrate : config.get().busBitrate;
+        publishHealth(shard.bus, bitrate, monotonicNs(), shard.cfg.interface, primary);
+    }
+}
+
+Task<> maintenanceTask(Shard& shard, ConfigStore& config, size_t shardCount) {
+    while (true) {
+        co_await shard.loop.sleepFor(1000000000LL);
+        maintainStorage(shard, config.get(), monotonicNs() / 1000, shardCount);
+    }
+}
+
+// Clock anchors every anchor_interval_s, on the primary shard's loop; its
+// receive task records one as well when the wall clock steps.
+Task<> anchorTask(Shard& primary, ConfigStore& config, LastValueCache& lvc, int64_t& lastAnchorNs) {
+    while (true) {
+        const int64_t intervalNs = config.get().anchorIntervalS * 1000000000LL;
+        if (intervalNs <= 0) {
+            co_await primary.loop.sleepFor(1000000000LL);
+            continue;
+        }
+        co_await primary.loop.sleepUntil(lastAnchorNs + intervalNs);
+        if (monotonicNs() - lastAnchorNs >= intervalNs) {
+            recordAnchor(primary, lvc);
+            lastAnchorNs = monotonicNs();
+        }
+    }
+}
+
+// Uploads a backlog too small for min_entries_to_send once
+// flush_interval_ms passed since the previous upload.
+Task<> flushTask(IoLoop& loop, ShardSet& shards, ConfigStore& config, Upload& upload) {
+    while (true) {
+        const int64_t intervalNs = config.get().flushIntervalMs * 1000000LL;
+        const int64_t due = lastUploadNs.load(std::memory_order_relaxed) + intervalNs;
+        if (intervalNs <= 0 || due > monotonicNs()) {
+            co_await loop.sleepUntil(intervalNs > 0 ? due : monotonicNs() + 1000000000LL);
+            continue;
+        }
+        triggerUpload(upload, shards, config.get(), true);
+        co_await loop.sleepFor(RECEIVE_WAIT_NS);
+    }
+}
+
+void updateVfsMetrics() {
+    static uint64_t logical = 0, physical = 0, blocks = 0;
+    const uint64_t nowLogical = loggerVfsStats.logicalBytes.load(std::memory_order_relaxed);
+    const uint64_t nowPhysical = loggerVfsStats.physicalBytes.load(std::memory_order_relaxed);
+    const uint64_t nowBlocks = loggerVfsStats.blocks.load(std::memory_order_relaxed);
+    vfsLogicalBytes.inc(nowLogical - logical);
+    vfsPhysicalBytes.inc(nowPhysical - physical);
+    vfsEraseBlocks.inc(nowBlocks - blocks);
+    if (nowLogical > 0) vfsAmplification.set(static_cast<int64_t>(nowPhysical * 1000 / nowLogical));
+    logical = nowLogical;
+    physical = nowPhysical;
+    blocks = nowBlocks;
+}
+
+// Gauges over all shards, and the supervisor heartbeat stamped with the
+// oldest receive task's, so a stuck shard gets the worker restarted.
+Task<> heartbeatTask(IoLoop& loop, ShardSet& shards, Supervisor& supervisor) {
+    while (true) {
+        co_await loop.sleepFor(HEARTBEAT_NS);
+        int64_t oldest = monotonicNs();
+        int level = 0;
+        for (Shard& shard : shards) {
+            oldest = std::min(oldest, shard.heartbeatNs.load(std::memory_order_relaxed));
+            level = std::max(level, shard.level.load(std::memory_order_relaxed));
         }
-        if (frame.can_dlc >=sizeof(int)) {
-            perror("Too much data per frame, at most int expected from mock");
+        supervisor.beat(oldest);
+        degradeLevel.set(level);
+        updateDepthGauges(shards);
+        updateVfsMetrics();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // SIGHUP is handled by the config reloader thread only, SIGUSR2 by the tracer's
+    ConfigReloader::blockSignal();
+    TraceDumper::blockSignal();
+
+    const std::string configPath = argc > 1 ? argv[1] : DEFAULT_CONFIG;
+    auto initial = std::make_unique<LoggerConfig>();
+    if (!loadConfig(configPath, *initial)) {
+        return 1;
+    }
+    Supervisor supervisor;
+    if (initial->supervise) {
+        supervisor.run(initial->watchdogMs);
+        // worker from here on; a restarted one picks up edits its predecessor reloaded
+        initial = std::make_unique<LoggerConfig>();
+        if (!loadConfig(configPath, *initial)) {
             return 1;
         }
+        if (initial->database == ":memory:") initial->database = SUPERVISED_DATABASE;
+    }
+    const int64_t workerStart = monotonicNs();
+    ConfigStore config(std::move(initial));
+    const LoggerConfig& startup = config.get();
 
-        int value = 0;
-        for (int i = 0; i < frame.can_dlc; i++) {
-            value = (value << 8) | frame.data[i];
+    // One shard per shard key, or one on interface. The first shard on an
+    // interface watches its error frames and reports its health.
+    if (startup.shards.size() > MAX_SHARDS) {
+        std::cerr << "At most " << MAX_SHARDS << " shards" << std::endl;
+        return 1;
+    }
+    ShardSet shards;
+    if (startup.shards.empty()) {
+        shards.lanes[0].cfg = {"", startup.interface, -1, {}};
+        shards.count = 1;
+    }
+    for (const ShardConfig& shardCfg : startup.shards) {
+        Shard& shard = shards.lanes[shards.count++];
+        shard.cfg = shardCfg;
+        for (Shard* other = shards.begin(); other != &shard; other++) {
+            if (other->cfg.interface == shard.cfg.interface) shard.monitor = false;
         }
-        insertData(db, frame.can_id, value);
-        if (++packetCount >= MIN_ENTRIES_TO_SEND && uploadData(db)) {
-            deleteAllEntries(db);
-            packetCount = 0;
+    }
+
+    // before any thread exists, so storage, upload, DDS and metrics threads
+    // all inherit a mask without the receive core
+    if (startup.rtCpu >= 0) avoidCpu(startup.rtCpu);
+
+    // All batches are preallocated here, the loops below never touch the heap
+    FrameBatchPool framePool(shards.count, FRAME_BATCH);
+    CanBatchPool dataPool(Upload::CHUNKS + shards.count, DATA_BATCH);
+
+    //Use in-memory database as buffer, SQLite allocations recycled by the pool
+    SqliteMemPool::install();
+    LoggerVfsOptions vfs;
+    vfs.ring = startup.ioUring;
+    vfs.eraseBlock = static_cast<size_t>(startup.flashEraseBlockKb) * 1024;
+    vfs.compressPages = startup.compressPages;
+    if ((vfs.ring || vfs.eraseBlock || vfs.compressPages) && !LoggerVfs::install(vfs)) {
+        std::cerr << "SQLite VFS " << LoggerVfs::NAME << " not registered" << std::endl;
+    }
+    for (Shard& shard : shards) {
+        const std::string database = shardDatabase(startup.database, shard.cfg.name);
+        if (!shard.storage.open(database.c_str(), startup.packSamples)) {
+            exit(1);
+        }
+        refreshDepth(shard);
+        const CanStorage& storage = shard.storage;
+        if (storage.totalRows() > 0 || storage.anchorBacklog() > 0) {
+            std::cerr << "Buffer " << database << " reattached in " << (monotonicNs() - workerStart) / 1000 << " us: "
+                      << storage.backlog() << " samples, " << storage.totalRows() - storage.backlog()
+                      << " rollup rows, " << storage.anchorBacklog() << " clock anchors to upload" << std::endl;
+        }
+    }
+
+    // CAN socket setup. Sockets are reopened on read failures, the
+    // reloader thread only reads them to update the filter.
+    for (Shard& shard : shards) {
+        const int s = openCanSocket(shard, startup, shard.ifindex);
+        if (s < 0) {
+            return 1;
         }
+        shard.socket = s;
     }
 
+    // Answered from the buffers on the query thread; listener set before the
+    // reader exists, a full queue is answered at once
+    QueryServer queries;
+    for (Shard& shard : shards) queries.add(shard.storage, shard.storageLock, shard.cfg.ids);
+    queries.start(publishQueryReply);
+    queryListener.onSample = [&queries](const CanQueryRequest& sample) {
+        const QueryRequest request = queryRequest(sample);
+        if (!queries.submit(request)) publishQueryReply(request, nullptr, 0, 0, true, QueryStatus::Rejected);
+    };
+
+    if (!initDDS(startup)) {
+        std::cerr << "DDS init error" << std::endl;
+        return 1;
+    }
+    LastValueCache lvc;
+    if (!lvc.open(startup.lvcShm, startup.supervise)) {
+        std::cerr << "Last value cache not shared" << std::endl;
+        lvc.open("");
+    }
+
+    // times the decode kernels now, before the receive loops need one
+    const DecodeKernel& decoder = decodeKernel();
+    std::cout << "Decode: " << decoder.name << " kernel (scalar " << decoder.scalarFramesPerNs << " frames/ns, "
+              << canDecodeIsa() << " " << decoder.simdFramesPerNs << ")" << std::endl;
+
+    MetricsExporter exporter;
+    exporter.start(startup.metricsFile, startup.metricsSocket);
+    TraceDumper tracer;
+    tracer.start(startup.traceFile);
+
+    // Event loops for the upload stages: the reader with SQLite on the
+    // first, the encoder and the DDS writer on the last, all three on one
+    // with io_threads = 1. Started before the receive cores are claimed,
+    // like every other thread.
+    const int ioThreads = startup.ioThreads;
+    std::unique_ptr<IoLoop[]> ioLoops(new IoLoop[ioThreads]);
+    std::vector<std::thread> ioWorkers;
+    for (int i = 0; i < ioThreads; i++) {
+        ioWorkers.emplace_back([&ioLoops, i] { ioLoops[i].run(); });
+    }
+
+    ShardMerge merge;
+    for (Shard& shard : shards) merge.add(shard.storage, shard.storageLock, shard.watermarkUs, dataPool.acquire());
+    Upload upload(dataPool);
+    upload.start(uploadStages(shards, merge, config), ioLoops[0], ioLoops[1 % ioThreads], ioLoops[ioThreads - 1]);
+
+    ConfigReloader reloader;
+    reloader.start(configPath, config, [&shards](const LoggerConfig& previous, const LoggerConfig& next) {
+        if (next.filter == previous.filter) return;
+        for (Shard& shard : shards) {
+            const int fd = shard.socket.load();
+            if (shard.cfg.ids.empty() && fd >= 0) applyFilter(fd, next.filter);
+        }
+    });
+
+    recordAnchor(shards.primary(), lvc);
+    int64_t lastAnchorNs = monotonicNs();
+    lastUploadNs = lastAnchorNs;
+
+    // Each shard's loop runs its receive task and its timers; the primary's
+    // also records clock anchors, flushes small backlogs and stamps the
+    // supervisor heartbeat.
+    Shard& primary = shards.primary();
+    for (Shard& shard : shards) {
+        const bool isPrimary = &shard == &primary;
+        shard.heartbeatNs = lastAnchorNs;
+        shard.loop.spawn(receiveTask(shard, isPrimary, config, lvc, framePool.acquire(), shards, upload, lastAnchorNs));
+        if (shard.monitor) shard.loop.spawn(healthTask(shard, isPrimary, config));
+        shard.loop.spawn(maintenanceTask(shard, config, shards.count));
+    }
+    primary.loop.spawn(anchorTask(primary, config, lvc, lastAnchorNs));
+    primary.loop.spawn(flushTask(primary.loop, shards, config, upload));
+    primary.loop.spawn(heartbeatTask(primary.loop, shards, supervisor));
+
+    // Every other thread has been started: only the receive threads get
+    // their cores, the real-time priority and prefaulted stacks.
+    const bool memoryLocked = startup.lockMemory && lockMemory();
+    // SQLite memory of each receive thread comes from an arena of its own,
+    // the other threads keep arena 0
+    for (Shard* shard = shards.begin() + 1; shard != shards.end(); shard++) {
+        const size_t arena = static_cast<size_t>(shard - shards.begin()) + 1;
+        shard->thread = std::thread([&startup, memoryLocked, shard, arena] {
+            claimReceiveCore(shard->cfg.cpu, startup, memoryLocked);
+            SqliteMemPool::useArena(arena);
+            shard->loop.run();
+        });
+    }
+    claimReceiveCore(primary.cfg.cpu >= 0 ? primary.cfg.cpu : startup.rtCpu, startup, memoryLocked);
+    SqliteMemPool::useArena(1);
+    primary.loop.run();
+
     // never reach here in this version
+    reloader.stop();
+    tracer.stop();
+    for (Shard& shard : shards) {
+        shard.loop.stop();
+        if (shard.thread.joinable()) shard.thread.join();
+    }
+    upload.stop();
+    for (int i = 0; i < ioThreads; i++) {
+        ioLoops[i].stop();
+        ioWorkers[i].join();
+    }
+    queries.stop();
     deleteDDS();
-    sqlite3_close(db);
-    close(s);
+    for (Shard& shard : shards) {
+        shard.storage.close();
+        shard.rx.close();
+        if (shard.socket >= 0) close(shard.socket);
+    }
     return 0;
 }
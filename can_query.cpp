@@ -0,0 +1,174 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Queries a running can_logger's buffer over DDS request/reply and prints
+// the answer as CSV: one line per sample, or per bucket with --bucket.
+// Times are wall clock: epoch seconds, or seconds before now when negative,
+// so "--from -600" is the last ten minutes. Only samples still buffered,
+// not yet uploaded and deleted, can be found.
+//
+// usage: can_query --id can_id [--from s] [--to s] [--bucket ms] [--max n]
+//                  [--domain n] [--timeout s]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#include "DDS/FastDDSPublisher.hpp"
+#include "DDS/FastDDSSubscriber.hpp"
+
+using namespace eprosima::fastdds::dds;
+
+static const char* const STATUS[] = {"ok", "truncated", "rejected"};
+
+static int64_t realtimeUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// epoch seconds, or seconds before now when negative
+static int64_t parseTime(const char* arg, int64_t nowUs) {
+    const double seconds = std::atof(arg);
+    const int64_t us = static_cast<int64_t>(seconds * 1e6);
+    return seconds <= 0 ? nowUs + us : us;
+}
+
+static void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " --id can_id [--from s] [--to s] [--bucket ms] [--max n] [--domain n]"
+              << " [--timeout s]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    const int64_t now = realtimeUs();
+    long canId = -1;
+    int64_t fromUs = now - 3600 * 1000000LL;
+    int64_t toUs = now;
+    int64_t bucketMs = 0;
+    uint32_t maxResults = 0;
+    int domain = 0;
+    int timeout = 10;
+    std::string queryTopicName = "CanLoggerQueryTopic";
+    std::string replyTopicName = "CanLoggerQueryReplyTopic";
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--id") && i + 1 < argc) canId = std::strtol(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--from") && i + 1 < argc) fromUs = parseTime(argv[++i], now);
+        else if (!strcmp(argv[i], "--to") && i + 1 < argc) toUs = parseTime(argv[++i], now);
+        else if (!strcmp(argv[i], "--bucket") && i + 1 < argc) bucketMs = std::atoll(argv[++i]);
+        else if (!strcmp(argv[i], "--max") && i + 1 < argc) maxResults = std::strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--domain") && i + 1 < argc) domain = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--timeout") && i + 1 < argc) timeout = std::atoi(argv[++i]);
+        else { usage(argv[0]); return 1; }
+    }
+    if (canId < 0 || toUs <= fromUs || bucketMs < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    DomainParticipant* participant = DomainParticipantFactory::get_instance()->create_participant(domain, PARTICIPANT_QOS_DEFAULT);
+    if (participant == nullptr) {
+        std::cerr << "Error creating participant." << std::endl;
+        return 1;
+    }
+    TypeSupport requestType(new CanQueryRequestPubSubType());
+    TypeSupport replyType(new CanQueryReplyPubSubType());
+    requestType.register_type(participant);
+    replyType.register_type(participant);
+    Topic* queryTopic = participant->create_topic(queryTopicName, requestType.get_type_name(), TOPIC_QOS_DEFAULT);
+    Topic* replyTopic = participant->create_topic(replyTopicName, replyType.get_type_name(), TOPIC_QOS_DEFAULT);
+    Publisher* publisher = participant->create_publisher(PUBLISHER_QOS_DEFAULT, nullptr, StatusMask::none());
+    Subscriber* subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT, nullptr, StatusMask::none());
+    if (queryTopic == nullptr || replyTopic == nullptr || publisher == nullptr || subscriber == nullptr) {
+        std::cerr << "Error creating topics, publisher or subscriber." << std::endl;
+        return 1;
+    }
+
+    // replies to other clients' requests are on the same topic, told apart by id
+    const uint32_t requestId = static_cast<uint32_t>(getpid()) ^ static_cast<uint32_t>(now);
+    std::mutex lock;
+    std::condition_variable replied;
+    bool done = false;
+    uint32_t expected = 0;
+    SubListener<CanQueryReply> listener;
+    listener.onSample = [&](const CanQueryReply& reply) {
+        if (reply.request_id() != requestId) return;
+        std::lock_guard<std::mutex> guard(lock);
+        if (reply.seq() != expected && reply.count() > 0) {
+            std::cerr << "Reply " << expected << " missing" << std::endl;
+        }
+        if (reply.count() > 0) {
+            std::cout << reply.timestamp() / 1000000 << '.' << std::setw(6) << std::setfill('0')
+                      << reply.timestamp() % 1000000 << std::setfill(' ') << ',' << reply.min() << ',' << reply.max()
+                      << ',' << reply.mean() << ',' << reply.count() << '\n';
+            expected = reply.seq() + 1;
+        }
+        if (reply.last()) {
+            const uint8_t status = reply.status() < 3 ? reply.status() : 2;
+            std::cerr << expected << " results, " << STATUS[status] << std::endl;
+            done = true;
+            replied.notify_one();
+        }
+    };
+
+    DataReaderQos rqos;
+    subscriber->get_default_datareader_qos(rqos);
+    rqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    rqos.history().kind = KEEP_ALL_HISTORY_QOS;
+    DataReader* reader = subscriber->create_datareader(replyTopic, rqos, &listener, StatusMask::all());
+    DataWriterQos wqos;
+    publisher->get_default_datawriter_qos(wqos);
+    wqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    PubListener pubListener;
+    DataWriter* writer = publisher->create_datawriter(queryTopic, wqos, &pubListener, StatusMask::all());
+    if (reader == nullptr || writer == nullptr) {
+        std::cerr << "Error creating reader or writer." << std::endl;
+        return 1;
+    }
+
+    // a request written before can_logger's reader matched would be lost
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout);
+    while (pubListener.matched == 0 || listener.matched == 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            std::cerr << "No can_logger found on domain " << domain << std::endl;
+            participant->delete_contained_entities();
+            DomainParticipantFactory::get_instance()->delete_participant(participant);
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    CanQueryRequest request;
+    request.request_id(requestId);
+    request.can_id(static_cast<uint32_t>(canId));
+    request.wall_clock(true);
+    request.from_us(fromUs);
+    request.to_us(toUs);
+    request.bucket_us(bucketMs * 1000);
+    request.max_results(maxResults);
+    if (writer->write(&request) != RETCODE_OK) {
+        std::cerr << "DDS write failed" << std::endl;
+        return 1;
+    }
+
+    bool answered;
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        answered = replied.wait_until(guard, deadline, [&done] { return done; });
+    }
+    if (!answered) std::cerr << "No reply within " << timeout << " s" << std::endl;
+    participant->delete_contained_entities();
+    DomainParticipantFactory::get_instance()->delete_participant(participant);
+    return answered ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Reference subscriber for CanLoggerTopic. Puts each logger shard's samples
+// back in index order, counts the ones that never arrive, optionally appends
+// them to a columnar store and prints one JSON line per interval: delivered
+// rate, loss, duplicates, reordering and frame-to-receive latency. Latency
+// compares the sample's monotonic timestamp with this host's clock, so it is
+// only meaningful with can_logger on the same host, and includes the time a
+// sample spent buffered. Needs no broker, only a DDS domain; stops on
+// SIGINT/SIGTERM or after --duration seconds.
+//
+// usage: can_receiver [--domain n] [--topic name] [--store dir]
+//                     [--interval s] [--duration s] [--gap-timeout ms]
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include "DDS/FastDDSSubscriber.hpp"
+#include "CanBatch.hpp"
+#include "ColumnStore.hpp"
+#include "SeqReassembler.hpp"
+
+using namespace eprosima::fastdds::dds;
+
+static int64_t nowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+struct Received {
+    uint32_t index;
+    CanData data;
+    int64_t receivedUs;
+};
+
+static void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--domain n] [--topic name] [--store dir] [--interval s] [--duration s]"
+              << " [--gap-timeout ms]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int domain = 0;
+    std::string topicName = "CanLoggerTopic";
+    std::string storeDir;
+    int interval = 1;
+    int duration = 0;
+    int gapTimeoutMs = 1000;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--domain") && i + 1 < argc) domain = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--topic") && i + 1 < argc) topicName = argv[++i];
+        else if (!strcmp(argv[i], "--store") && i + 1 < argc) storeDir = argv[++i];
+        else if (!strcmp(argv[i], "--interval") && i + 1 < argc) interval = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--duration") && i + 1 < argc) duration = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--gap-timeout") && i + 1 < argc) gapTimeoutMs = std::atoi(argv[++i]);
+        else { usage(argv[0]); return 1; }
+    }
+    if (interval <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // taken by sigtimedwait() below; blocked before DDS starts its threads
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    ColumnStore store;
+    if (!storeDir.empty() && !store.open(storeDir)) {
+        return 1;
+    }
+
+    DomainParticipant* participant = DomainParticipantFactory::get_instance()->create_participant(domain, PARTICIPANT_QOS_DEFAULT);
+    if (participant == nullptr) {
+        std::cerr << "Error creating participant." << std::endl;
+        return 1;
+    }
+    TypeSupport myType = TypeSupport(new CanLogEntryPubSubType());
+    myType.register_type(participant);
+    Topic* topic = participant->create_topic(topicName, myType.get_type_name(), TOPIC_QOS_DEFAULT);
+    Subscriber* subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT, nullptr, StatusMask::none());
+    if (topic == nullptr || subscriber == nullptr) {
+        std::cerr << "Error creating topic or subscriber." << std::endl;
+        return 1;
+    }
+
+    std::mutex lock;
+    // one per logger shard, see sampleIndex()
+    using Reassembler = SeqReassembler<Received, INDEX_SEQ_BITS>;
+    std::vector<Reassembler> reassemblers(size_t{1} << INDEX_SHARD_BITS);
+    std::vector<int64_t> latencies;
+    latencies.reserve(1 << 20);
+    uint64_t received = 0;
+    const auto emit = [&store, &storeDir](const Received& sample) {
+        if (!storeDir.empty()) store.append(sample.index, sample.data, sample.receivedUs);
+    };
+
+    SubListener<> listener;
+    listener.onSample = [&](const CanLogEntry& sample) {
+        const int64_t now = nowUs();
+        const Received entry{sample.index(),
+                             {static_cast<int>(sample.can_id()), sample.value(), sample.timestamp()},
+                             now};
+        std::lock_guard<std::mutex> guard(lock);
+        received++;
+        latencies.push_back(now - sample.timestamp());
+        reassemblers[indexShard(entry.index)].push(entry.index, entry, now, emit);
+    };
+
+    // same QoS as can_logger's writer, so every sample it keeps is delivered
+    DataReaderQos rqos;
+    subscriber->get_default_datareader_qos(rqos);
+    rqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    rqos.history().kind = KEEP_ALL_HISTORY_QOS;
+    rqos.resource_limits().max_instances = 0;              // one per can_id, the key
+    rqos.resource_limits().max_samples_per_instance = 0;
+    DataReader* reader = subscriber->create_datareader(topic, rqos, &listener, StatusMask::all());
+    if (reader == nullptr) {
+        std::cerr << "Error creating reader." << std::endl;
+        return 1;
+    }
+
+    const int64_t start = nowUs();
+    int64_t last = start;
+    uint64_t lastReceived = 0;
+    bool stopping = false;
+    while (!stopping) {
+        const struct timespec tick{interval, 0};
+        stopping = sigtimedwait(&stopSignals, nullptr, &tick) > 0
+                   || (duration > 0 && nowUs() - start >= static_cast<int64_t>(duration) * 1000000);
+
+        // no more callbacks once the reader is gone, so the last report is final
+        if (stopping) participant->delete_contained_entities();
+
+        std::vector<int64_t> window;
+        const int64_t now = nowUs();
+        std::lock_guard<std::mutex> guard(lock);
+        Reassembler::Stats stats;
+        size_t pending = 0;
+        for (Reassembler& reassembler : reassemblers) {
+            if (stopping) {
+                reassembler.finish(emit);
+            } else {
+                reassembler.expire(now, static_cast<int64_t>(gapTimeoutMs) * 1000, emit);
+            }
+            const Reassembler::Stats& counts = reassembler.counts();
+            stats.delivered += counts.delivered;
+            stats.lost += counts.lost;
+            stats.duplicates += counts.duplicates;
+            stats.reordered += counts.reordered;
+            stats.restarts += counts.restarts;
+            pending += reassembler.pending();
+        }
+        window.swap(latencies);
+        latencies.reserve(window.capacity());
+        std::sort(window.begin(), window.end());
+
+        const double elapsed = (now - last) / 1e6;
+        const uint64_t expected = stats.delivered + stats.lost;
+        std::cout << "{\"t_s\":" << (now - start) / 1e6
+                  << ",\"received\":" << received - lastReceived
+                  << ",\"rate_per_s\":" << (elapsed > 0 ? (received - lastReceived) / elapsed : 0.0)
+                  << ",\"delivered\":" << stats.delivered
+                  << ",\"lost\":" << stats.lost
+                  << ",\"loss_pct\":" << (expected ? 100.0 * stats.lost / expected : 0.0)
+                  << ",\"duplicates\":" << stats.duplicates
+                  << ",\"reordered\":" << stats.reordered
+                  << ",\"sender_restarts\":" << stats.restarts
+                  << ",\"pending\":" << pending
+                  << ",\"latency_ms\":{\"p50\":" << percentile(window, 0.50) / 1000.0
+                  << ",\"p99\":" << percentile(window, 0.99) / 1000.0
+                  << ",\"max\":" << (window.empty() ? 0 : window.back()) / 1000.0 << "}"
+                  << ",\"stored\":" << store.rowCount()
+                  << (stopping ? ",\"final\":true" : "") << "}" << std::endl;
+        last = now;
+        lastReceived = received;
+    }
+
+    DomainParticipantFactory::get_instance()->delete_participant(participant);
+    store.close();
+    return 0;
+}
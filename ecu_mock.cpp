@@ -16,6 +16,7 @@
 #include <linux/can.h>
 #include <linux/can/raw.h>
 #include <net/if.h>
+#include "Signals.hpp"
 
 int getRandomValue(int current, int min, int max) {
     static bool seeded = false;
@@ -37,7 +38,10 @@ int getRandomValue(int current, int min, int max) {
     return lower_bound + std::rand() % (upper_bound - lower_bound + 1);
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // optional period between signal bursts, microseconds
+    const useconds_t period = argc > 1 ? std::atoi(argv[1]) : 500000;
+
     // CAN socket setup
     int s;
     struct sockaddr_can addr;
@@ -62,97 +66,28 @@ int main() {
     }
 
     struct can_frame frame;
-
-    int engineRPM = 0;
-    int coolantTemp = 0;
-    int oilTemp = 0;
-    int oilPressure = 0;
-    int hydraulicOilTemp = 0;
-    int hydraulicOilPressure = 0;
-
+    // random walk state of each ECU signal, started at the bottom of its range
+    int values[SIGNALS.size()] = {};
 
     while (true) {
-        engineRPM = getRandomValue(engineRPM, 800, 6500);
-        coolantTemp = getRandomValue(coolantTemp, -40, 120); // in Celsius
-        oilTemp = getRandomValue(oilTemp, -30, 150);     // in Celsius
-        oilPressure = getRandomValue(oilPressure, 0, 700);    // in kPa
-        hydraulicOilTemp = getRandomValue(hydraulicOilTemp, -20, 140); // in Celsius
-        hydraulicOilPressure = getRandomValue(hydraulicOilPressure, 0, 600); // in bar
-
-        std::cout << "\rEngine RPM: " << engineRPM 
-                  << ", Coolant Temp: " << coolantTemp << "°C"
-                  << ", Oil Temp: " << oilTemp << "°C"
-                  << ", Oil Pressure: " << oilPressure << " kPa"
-                  << ", Hydraulic Oil Temp: " << hydraulicOilTemp << "°C"
-                  << ", Hydraulic Oil Pressure: " << hydraulicOilPressure << " bar"
-                  << std::flush;
-
-        // Prepare CAN frames for each signal
-
-        // Engine RPM (0x100)
-        frame.can_id = 0x100;
-        frame.can_dlc = 2; // Data length code
-        frame.data[0] = engineRPM >> 8;
-        frame.data[1] = engineRPM & 0xFF;
-
-        if (write(s, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
-            perror("Write");
-            return 1;
-        }
-
-        // Coolant Temp (0x101)
-        frame.can_id = 0x101;
-        frame.can_dlc = 1; // Data length code
-        frame.data[0] = coolantTemp;
-
-        if (write(s, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
-            perror("Write");
-            return 1;
-        }
-
-        // Oil Temp (0x102)
-        frame.can_id = 0x102;
-        frame.can_dlc = 1; // Data length code
-        frame.data[0] = oilTemp;
-
-        if (write(s, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
-            perror("Write");
-            return 1;
-        }
-
-        // Oil Pressure (0x103)
-        frame.can_id = 0x103;
-        frame.can_dlc = 2; // Data length code
-        frame.data[0] = oilPressure >> 8;
-        frame.data[1] = oilPressure & 0xFF;
-
-        if (write(s, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
-            perror("Write");
-            return 1;
-        }
-
-        // Hydraulic Oil Temp (0x104)
-        frame.can_id = 0x104;
-        frame.can_dlc = 1; // Data length code
-        frame.data[0] = hydraulicOilTemp;
-
-        if (write(s, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
-            perror("Write");
-            return 1;
-        }
-
-        // Hydraulic Oil Pressure (0x105)
-        frame.can_id = 0x105;
-        frame.can_dlc = 2; // Data length code
-        frame.data[0] = hydraulicOilPressure >> 8;
-        frame.data[1] = hydraulicOilPressure & 0xFF;
-
-        if (write(s, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
-            perror("Write");
-            return 1;
-        }
-
-        usleep(500000); // 500 ms
+        bool sent = true;
+        std::cout << "\r";
+        forEachSignal([&](auto i) {
+            constexpr SignalDef signal = SIGNALS[i];
+            if constexpr (signal.source == SignalSource::Ecu) {
+                values[i] = getRandomValue(values[i], signal.mockMin, signal.mockMax);
+                std::cout << signal.name << ": " << values[i] << " " << signal.unit << "  ";
+                encodeSignal<i>(frame, values[i]);
+                if (sent && write(s, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
+                    perror("Write");
+                    sent = false;
+                }
+            }
+        });
+        std::cout << std::flush;
+        if (!sent) return 1;
+
+        usleep(period); // 500 ms by default
     }
 
     close(s);
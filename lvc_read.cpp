@@ -0,0 +1,66 @@
+/* Copyright (C) 2024 Maxim Plekh - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the GPLv3 license.
+ *
+ * You should have received a copy of the GPLv3 license with this file.
+ * If not, please visit : http://choosealicense.com/licenses/gpl-3.0/
+ */
+
+// Prints current values from can_logger's last value cache. Example reader
+// for on-board consumers: maps the segment read-only once, after that every
+// snapshot is plain memory loads.
+//
+// usage: lvc_read [--shm /can_logger_lvc] [--watch ms] [can id ...]
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "LastValueCache.hpp"
+#include "Config.hpp"
+
+int main(int argc, char* argv[]) {
+    std::string shmName = "/can_logger_lvc";
+    int watchMs = 0;
+    std::vector<uint32_t> ids;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--shm") && i + 1 < argc) shmName = argv[++i];
+        else if (!strcmp(argv[i], "--watch") && i + 1 < argc) watchMs = std::atoi(argv[++i]);
+        else ids.push_back(std::strtoul(argv[i], nullptr, 0));
+    }
+    if (ids.empty()) {
+        for (const auto& [can_id, signal] : defaultSignals()) ids.push_back(can_id);
+    }
+
+    LastValueReader reader;
+    if (!reader.open(shmName)) {
+        return 1;
+    }
+
+    const std::map<uint32_t, SignalInfo> signals = defaultSignals();
+    std::vector<LvcValue> values(ids.size());
+    do {
+        ClockAnchor anchor;
+        if (!reader.snapshot(ids.data(), ids.size(), values.data(), &anchor)) {
+            std::cerr << "Snapshot kept changing, retrying" << std::endl;
+            continue;
+        }
+        for (const LvcValue& v : values) {
+            auto signal = signals.find(v.can_id);
+            std::cout << "0x" << std::hex << v.can_id << std::dec << ' '
+                      << (signal != signals.end() ? signal->second.name : "unknown") << ": ";
+            if (!v.valid) {
+                std::cout << "-\n";
+                continue;
+            }
+            // wall time from the latest clock anchor, see README "Timestamps"
+            std::cout << v.value << (signal != signals.end() ? signal->second.unit : "")
+                      << " at " << anchor.realtimeUs + (v.timestamp - anchor.monotonicUs) << " us\n";
+        }
+        std::cout << std::endl;
+        if (watchMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(watchMs));
+    } while (watchMs > 0);
+    return 0;
+}
@@ -16,6 +16,7 @@
 #include <linux/can.h>
 #include <linux/can/raw.h>
 #include <net/if.h>
+#include "Signals.hpp"
 
 int getRandomValue(int min, int max) {
     return rand() % (max - min + 1) + min;
@@ -50,19 +51,20 @@ int main() {
     struct can_frame frame;
 
     while (true) {
-        int bucketLoad = getRandomValue(10000, 25000);
-
-        frame.can_id = 0x200;
-        frame.can_dlc = 2;
-        frame.data[0] = bucketLoad >> 8;
-        frame.data[1] = bucketLoad & 0xFF;
-
-        if (write(s, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
-            perror("Write");
-            return 1;
-        }
-
-        std::cout << "Scoop Bucket Load Weight: " << bucketLoad << std::endl;
+        bool sent = true;
+        forEachSignal([&](auto i) {
+            constexpr SignalDef signal = SIGNALS[i];
+            if constexpr (signal.source == SignalSource::Scales) {
+                const int value = getRandomValue(signal.mockMin, signal.mockMax);
+                encodeSignal<i>(frame, value);
+                if (sent && write(s, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
+                    perror("Write");
+                    sent = false;
+                }
+                std::cout << signal.name << ": " << value << " " << signal.unit << std::endl;
+            }
+        });
+        if (!sent) return 1;
 
         int interval = getRandomValue(5, 20); // seconds between unload events
         usleep(interval * 1000000);